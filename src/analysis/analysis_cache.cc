@@ -0,0 +1,118 @@
+#include "analysis_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+inline uint64_t DoubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t Mix(uint64_t seed, uint64_t value) {
+    // Перемешивание в духе splitmix64
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    seed ^= seed >> 31;
+    seed *= 0xbf58476d1ce4e5b9ULL;
+    return seed ^ (seed >> 29);
+}
+
+} // namespace
+
+bool AnalysisKey::operator==(const AnalysisKey& other) const {
+    // Сравнение по битам: 0.0 и -0.0 - разные ключи, NaN равен сам себе
+    return model == other.model &&
+           DoubleBits(lambda) == DoubleBits(other.lambda) &&
+           DoubleBits(mu) == DoubleBits(other.mu) &&
+           bufferSize == other.bufferSize &&
+           numNodes == other.numNodes &&
+           extra == other.extra;
+}
+
+size_t AnalysisKeyHash::operator()(const AnalysisKey& key) const {
+    uint64_t h = static_cast<uint64_t>(key.model);
+    h = Mix(h, DoubleBits(key.lambda));
+    h = Mix(h, DoubleBits(key.mu));
+    h = Mix(h, static_cast<uint32_t>(key.bufferSize));
+    h = Mix(h, static_cast<uint32_t>(key.numNodes));
+    h = Mix(h, static_cast<uint32_t>(key.extra));
+    return static_cast<size_t>(h);
+}
+
+AnalysisCache::AnalysisCache(size_t capacity)
+    : m_shardCapacity(std::max<size_t>(1, capacity / kNumShards)),
+      m_hits(0),
+      m_misses(0) {}
+
+AnalysisCache::Shard& AnalysisCache::ShardFor(const AnalysisKey& key) {
+    // Старшие 4 бита хэша (kNumShards = 16) - младшие использует unordered_map;
+    // сдвиг от разрядности size_t, чтобы он был определён и при 32 битах
+    static_assert(kNumShards <= 16, "ShardFor uses the top 4 hash bits");
+    size_t h = AnalysisKeyHash()(key);
+    return m_shards[(h >> (std::numeric_limits<size_t>::digits - 4)) % kNumShards];
+}
+
+bool AnalysisCache::Lookup(const AnalysisKey& key, double& value) {
+    Shard& shard = ShardFor(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.values.find(key);
+        if (it != shard.values.end()) {
+            value = it->second;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void AnalysisCache::Insert(const AnalysisKey& key, double value) {
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (!shard.values.emplace(key, value).second) {
+        return; // Уже вставлено другим потоком
+    }
+    shard.order.push_back(key);
+
+    while (shard.values.size() > m_shardCapacity) {
+        shard.values.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+void AnalysisCache::Clear() {
+    for (Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.values.clear();
+        shard.order.clear();
+    }
+    m_hits.store(0, std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+}
+
+uint64_t AnalysisCache::Hits() const {
+    return m_hits.load(std::memory_order_relaxed);
+}
+
+uint64_t AnalysisCache::Misses() const {
+    return m_misses.load(std::memory_order_relaxed);
+}
+
+size_t AnalysisCache::Size() const {
+    size_t total = 0;
+    for (const Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.values.size();
+    }
+    return total;
+}
+
+AnalysisCache& AnalysisCache::Instance() {
+    static AnalysisCache cache;
+    return cache;
+}
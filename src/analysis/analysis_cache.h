@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Аналитическая модель, результат которой кэшируется.
+ */
+enum class AnalysisModel : uint8_t {
+    MMc,
+    MM1K,
+    MMDelay,
+    MMLoss,
+    GlobalBalance,
+    SeriesMM1Delay,
+    MeanValueAnalysis,
+    GordonNewell,
+    Buzen,
+    MVADelayMode1,
+    MVADelayMode2
+};
+
+/**
+ * Ключ кэша: (модель, λ, μ, K, N, дополнительный целый параметр).
+ */
+struct AnalysisKey {
+    AnalysisModel model;
+    double lambda;
+    double mu;
+    int32_t bufferSize = 0;
+    int32_t numNodes = 0;
+    int32_t extra = 0;
+
+    bool operator==(const AnalysisKey& other) const;
+};
+
+struct AnalysisKeyHash {
+    size_t operator()(const AnalysisKey& key) const;
+};
+
+/**
+ * Ограниченный кэш результатов аналитических моделей.
+ *
+ * Ключи распределены по шардам, у каждого шарда свой мьютекс, поэтому кэш
+ * можно использовать из нескольких рабочих потоков. Шард вытесняет самые
+ * старые записи (FIFO) при превышении ёмкости. Значение вычисляется вне
+ * блокировки: при гонке два потока могут посчитать одно значение дважды,
+ * результат от этого не меняется.
+ */
+class AnalysisCache {
+public:
+    static constexpr size_t kNumShards = 16;
+
+    explicit AnalysisCache(size_t capacity = 1 << 16);
+
+    template <typename Compute>
+    double GetOrCompute(const AnalysisKey& key, Compute compute) {
+        double value = 0.0;
+        if (Lookup(key, value)) {
+            return value;
+        }
+        value = compute();
+        Insert(key, value);
+        return value;
+    }
+
+    bool Lookup(const AnalysisKey& key, double& value);
+    void Insert(const AnalysisKey& key, double value);
+    void Clear();
+
+    uint64_t Hits() const;
+    uint64_t Misses() const;
+    size_t Size() const;
+
+    // Общий кэш процесса, используется методами AnalysisMethods
+    static AnalysisCache& Instance();
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<AnalysisKey, double, AnalysisKeyHash> values;
+        std::deque<AnalysisKey> order;
+    };
+
+    Shard& ShardFor(const AnalysisKey& key);
+
+    std::array<Shard, kNumShards> m_shards;
+    size_t m_shardCapacity;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+};
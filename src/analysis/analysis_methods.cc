@@ -2,10 +2,25 @@
 
 #include "analysis_methods.h" // Файл, содержащий объявление класса
 #include "queueing_models.h"  // Для использования методов QueueingModels
+#include "batch_models.h"
+#include "analysis_cache.h"
 #include <cmath>
 #include <algorithm>
 #include <limits> 
 
+namespace {
+
+// Скалярные методы запоминаются в общем кэше процесса (ключ - модель и параметры)
+template <typename Compute>
+double Cached(const AnalysisKey& key, Compute compute) {
+    return AnalysisCache::Instance().GetOrCompute(key, compute);
+}
+
+// Текущие коэффициенты моделей AdHoc / Group
+ThroughputModelCoefficients g_throughputCoefficients;
+
+} // namespace
+
 double AnalysisMethods::GlobalMeanAnalysis(const std::vector<double>& data) {
     if (data.empty()) return 0.0;
     double sum = 0.0;
@@ -17,49 +32,53 @@ double AnalysisMethods::GlobalMeanAnalysis(const std::vector<double>& data) {
 
 // M/M/c анализ
 double AnalysisMethods::MMcAnalysis(double arrivalRate, double serviceRate, int servers) {
-    if (arrivalRate < 0.0 || serviceRate <= 0.0 || servers <= 0) return 0.0;
-    if (arrivalRate == 0.0) return 0.0;
-    
-    double rho = arrivalRate / (servers * serviceRate);
-    if (rho >= 1.0) {
-        return servers * serviceRate; // Максимальная пропускная способность
-    }
-    return arrivalRate; // В стабильном состоянии
+    return Cached({AnalysisModel::MMc, arrivalRate, serviceRate, 0, 0, servers}, [&]() {
+        if (arrivalRate < 0.0 || serviceRate <= 0.0 || servers <= 0) return 0.0;
+        if (arrivalRate == 0.0) return 0.0;
+
+        double rho = arrivalRate / (servers * serviceRate);
+        if (rho >= 1.0) {
+            return servers * serviceRate; // Максимальная пропускная способность
+        }
+        return arrivalRate; // В стабильном состоянии
+    });
 }
 
 // M/M/1/K анализ пропускной способности
 double AnalysisMethods::MM1KAnalysis(double arrivalRate, double serviceRate, int bufferSize) {
-    return QueueingModels::Calculate_MM1K_Throughput(arrivalRate, serviceRate, bufferSize);
+    return Cached({AnalysisModel::MM1K, arrivalRate, serviceRate, bufferSize}, [&]() {
+        return QueueingModels::Calculate_MM1K_Throughput(arrivalRate, serviceRate, bufferSize);
+    });
 }
 
 // M/M/1 модель задержки
 double AnalysisMethods::MMDelayModel(double arrivalRate, double serviceRate) {
-    if (arrivalRate < 0.0 || serviceRate <= 0.0) return 0.0;
-    if (arrivalRate == 0.0) return 1.0 / serviceRate;
-    
-    if (arrivalRate >= serviceRate) {
-        return std::numeric_limits<double>::infinity();
-    }
-    
-    return 1.0 / (serviceRate - arrivalRate);
+    return Cached({AnalysisModel::MMDelay, arrivalRate, serviceRate}, [&]() {
+        if (arrivalRate < 0.0 || serviceRate <= 0.0) return 0.0;
+        if (arrivalRate == 0.0) return 1.0 / serviceRate;
+
+        if (arrivalRate >= serviceRate) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        return 1.0 / (serviceRate - arrivalRate);
+    });
 }
 
 // M/M/1/K модель потерь
 double AnalysisMethods::MMLossModel(double arrivalRate, double serviceRate, int bufferSize) {
-    if (arrivalRate < 0.0 || serviceRate <= 0.0) return 0.0;
-    if (arrivalRate == 0.0) return 0.0;
-    if (bufferSize <= 0) return 0.0; // M/M/1 без потерь
-    
-    double rho = arrivalRate / serviceRate;
-    
-    if (std::abs(rho - 1.0) < 1e-9) {
-        return 1.0 / (static_cast<double>(bufferSize) + 1.0);
-    }
-    
-    double p0 = (1.0 - rho) / (1.0 - std::pow(rho, bufferSize + 1));
-    double pK = p0 * std::pow(rho, bufferSize);
-    
-    return pK;
+    return Cached({AnalysisModel::MMLoss, arrivalRate, serviceRate, bufferSize}, [&]() {
+        if (arrivalRate < 0.0 || serviceRate <= 0.0) return 0.0;
+        if (arrivalRate == 0.0) return 0.0;
+        if (bufferSize <= 0) return 0.0; // M/M/1 без потерь
+
+        if (const MM1KDispatch::Entry* kernel = MM1KDispatch::Find(bufferSize)) {
+            return kernel->loss(arrivalRate, serviceRate);
+        }
+
+        // Формула через ln ρ и expm1: без переполнения ρ^(K+1) при больших K и ρ >> 1
+        return QueueingModels::MM1K_Loss<double>(arrivalRate, serviceRate, static_cast<double>(bufferSize));
+    });
 }
 
 // ТОЧНЫЙ МЕТОД ДЛЯ M/M/1/K (Глобальный Баланс) - 3 параметра
@@ -69,42 +88,191 @@ double AnalysisMethods::GlobalBalanceMethod(double lambda, double mu, int buffer
 
 // ТОЧНЫЙ МЕТОД ДЛЯ M/M/1/K (Глобальный Баланс) - 4 параметра
 double AnalysisMethods::GlobalBalanceMethod(double lambda, double mu, int bufferSize, int numNodes) {
-    return QueueingModels::GlobalBalanceMethod(lambda, mu, bufferSize, numNodes);
+    return Cached({AnalysisModel::GlobalBalance, lambda, mu, bufferSize, numNodes}, [&]() {
+        return QueueingModels::GlobalBalanceMethod(lambda, mu, bufferSize, numNodes);
+    });
+}
+
+// ТОЧНЫЙ МЕТОД ДЛЯ СЕТИ УЗЛОВ С КОНЕЧНЫМИ БУФЕРАМИ (цепь Маркова по всей сети)
+CtmcNetworkResult AnalysisMethods::GlobalBalanceNetwork(double lambda, double mu,
+                                                        const std::vector<double>& nodeLoads,
+                                                        const std::vector<uint32_t>& nodeBuffers,
+                                                        int defaultBufferSize,
+                                                        int numGroups) {
+    const size_t numNodes = nodeLoads.size();
+    FiniteBufferNetwork network;
+    network.arrivalRates.resize(numNodes);
+    network.capacities.resize(numNodes);
+    network.channels.resize(numNodes);
+
+    for (size_t i = 0; i < numNodes; ++i) {
+        network.arrivalRates[i] = std::max(0.0, lambda * nodeLoads[i]);
+        uint32_t buffer = (i < nodeBuffers.size() && nodeBuffers[i] > 0)
+            ? nodeBuffers[i]
+            : static_cast<uint32_t>(std::max(defaultBufferSize, 1));
+        network.capacities[i] = buffer;
+    }
+
+    if (numGroups <= 0) {
+        // Ad-Hoc: один общий канал
+        network.channelRates.push_back(mu);
+        std::fill(network.channels.begin(), network.channels.end(), 0u);
+    } else {
+        // Групповая сеть: каналы 0..G-1 - CSMA групп, далее - магистральные связи главных узлов
+        // Разбиение узлов на группы - как в GroupSimulator (размеры отличаются не более чем на 1)
+        const size_t groups = std::max<size_t>(1, std::min(static_cast<size_t>(numGroups), numNodes));
+        network.channelRates.assign(groups, mu);
+        size_t node = 0;
+        for (size_t group = 0; group < groups; ++group) {
+            size_t groupSize = numNodes / groups + ((group < numNodes % groups) ? 1 : 0);
+            for (size_t k = 0; k < groupSize; ++k, ++node) {
+                if (k == 0) {
+                    network.channels[node] = static_cast<uint32_t>(network.channelRates.size());
+                    network.channelRates.push_back(2.0 * mu);
+                } else {
+                    network.channels[node] = static_cast<uint32_t>(group);
+                }
+            }
+        }
+    }
+
+    return CtmcSolver::Solve(network);
+}
+
+// ОТКРЫТАЯ СЕТЬ ДЖЕКСОНА ПО ТОПОЛОГИИ СИМУЛЯТОРА
+JacksonNetworkResult AnalysisMethods::JacksonNetworkAnalysis(double lambda,
+                                                             const std::vector<double>& nodeLoads,
+                                                             const std::vector<double>& serviceRates,
+                                                             const std::vector<uint32_t>& nodeBuffers,
+                                                             int defaultBufferSize,
+                                                             int numGroups,
+                                                             const BackboneParameters& backbone) {
+    JacksonNetwork network = (numGroups <= 0)
+        ? JacksonSolver::BuildAdHocNetwork(lambda, nodeLoads, serviceRates, nodeBuffers, defaultBufferSize)
+        : JacksonSolver::BuildGroupNetwork(lambda, nodeLoads, serviceRates, nodeBuffers, defaultBufferSize,
+                                           numGroups, backbone);
+    return JacksonSolver::Solve(network);
+}
+
+TandemNetworkResult AnalysisMethods::TandemDecompositionAnalysis(double lambda,
+                                                                const std::vector<double>& nodeLoads,
+                                                                const std::vector<double>& serviceRates,
+                                                                const std::vector<uint32_t>& nodeBuffers,
+                                                                int defaultBufferSize,
+                                                                int numGroups,
+                                                                const BackboneParameters& backbone) {
+    JacksonNetwork routing = (numGroups <= 0)
+        ? JacksonSolver::BuildAdHocNetwork(lambda, nodeLoads, serviceRates, nodeBuffers, defaultBufferSize)
+        : JacksonSolver::BuildGroupNetwork(lambda, nodeLoads, serviceRates, nodeBuffers, defaultBufferSize,
+                                           numGroups, backbone);
+    return TandemDecomposition::Solve(TandemDecomposition::FromRouting(routing));
+}
+
+QueueModelResult AnalysisMethods::PooledChannelAnalysis(double lambda,
+                                                        const std::vector<double>& nodeLoads,
+                                                        const std::vector<double>& serviceRates,
+                                                        const std::vector<uint32_t>& nodeBuffers,
+                                                        int defaultBufferSize,
+                                                        int servers) {
+    const size_t numNodes = std::min(nodeLoads.size(), serviceRates.size());
+    if (numNodes == 0 || servers <= 0) return QueueModelResult();
+
+    double totalLoad = 0.0;
+    double meanRate = 0.0;
+    int capacity = 0;
+    for (size_t i = 0; i < numNodes; ++i) {
+        totalLoad += std::max(0.0, nodeLoads[i]);
+        meanRate += serviceRates[i];
+        capacity += (i < nodeBuffers.size() && nodeBuffers[i] > 0)
+            ? static_cast<int>(nodeBuffers[i]) : std::max(defaultBufferSize, 1);
+    }
+    meanRate /= static_cast<double>(numNodes);
+    return SingleQueueModels::MMcK(lambda * totalLoad, meanRate, servers, std::max(capacity, servers));
+}
+
+QueueModelResult AnalysisMethods::IndependentNodesMG1K(double lambda,
+                                                       const std::vector<double>& nodeLoads,
+                                                       const std::vector<double>& serviceRates,
+                                                       const std::vector<uint32_t>& nodeBuffers,
+                                                       int defaultBufferSize,
+                                                       double serviceScv) {
+    QueueModelResult result;
+    const size_t numNodes = std::min(nodeLoads.size(), serviceRates.size());
+    double offered = 0.0;
+    double capacityRate = 0.0;
+    for (size_t i = 0; i < numNodes; ++i) {
+        const double arrival = std::max(0.0, lambda * nodeLoads[i]);
+        const int K = (i < nodeBuffers.size() && nodeBuffers[i] > 0)
+            ? static_cast<int>(nodeBuffers[i]) : std::max(defaultBufferSize, 1);
+        QueueModelResult node = SingleQueueModels::MG1K(arrival, serviceRates[i], serviceScv, K);
+        offered += arrival;
+        capacityRate += std::max(0.0, serviceRates[i]);
+        result.throughput += node.throughput;
+        result.avgSystemSize += node.avgSystemSize;
+    }
+    if (offered <= 0.0) return QueueModelResult();
+    result.lossProbability = 1.0 - result.throughput / offered;
+    result.delay = (result.throughput > 0.0) ? result.avgSystemSize / result.throughput : 0.0;
+    result.utilization = (capacityRate > 0.0) ? result.throughput / capacityRate : 0.0;
+    return result;
 }
 
 // АНАЛИЗ ЗАДЕРЖКИ В СЕТИ ПОСЛЕДОВАТЕЛЬНЫХ УЗЛОВ M/M/1
 double AnalysisMethods::CalculateSeriesMM1Delay(double lambda, double mu, int numNodes) {
-   if (lambda < 0.0 || mu <= 0.0 || numNodes <= 0) return 0.0;
-   
-   const double serviceTime = 1.0 / mu;
+    return Cached({AnalysisModel::SeriesMM1Delay, lambda, mu, 0, numNodes}, [&]() {
+        if (lambda < 0.0 || mu <= 0.0 || numNodes <= 0) return 0.0;
+
+        const double serviceTime = 1.0 / mu;
+
+        if (std::abs(lambda) < 1e-9) {
+           return static_cast<double>(numNodes) * serviceTime;
+        }
 
-   if (std::abs(lambda) < 1e-9) {
-       return static_cast<double>(numNodes) * serviceTime;
-   }
+        if (lambda >= mu) {
+           return std::numeric_limits<double>::infinity();
+        }
 
-   if (lambda >= mu) {
-       return std::numeric_limits<double>::infinity();
-   }
+        double delayPerNode = 1.0 / (mu - lambda);
+        double totalDelay = static_cast<double>(numNodes) * delayPerNode;
 
-   double delayPerNode = 1.0 / (mu - lambda);
-   double totalDelay = static_cast<double>(numNodes) * delayPerNode;
+        return totalDelay;
+    });
+}
+
+// Последовательная сеть M/M/1 с разными интенсивностями обслуживания
+double AnalysisMethods::CalculateSeriesMM1Delay(double lambda, const std::vector<double>& serviceRates) {
+    if (lambda < 0.0 || serviceRates.empty()) return 0.0;
 
-   return totalDelay;
+    double totalDelay = 0.0;
+    for (double mu : serviceRates) {
+        if (mu <= 0.0) return 0.0;
+        if (lambda >= mu) {
+            return std::numeric_limits<double>::infinity();
+        }
+        totalDelay += 1.0 / (mu - lambda);
+    }
+    return totalDelay;
 }
 
 // Метод анализа средних значений (MVA)
 double AnalysisMethods::MeanValueAnalysis(double lambda, double mu, int bufferSize, int numNodes) {
-    return QueueingModels::MeanValueAnalysis(lambda, mu, bufferSize, numNodes);
+    return Cached({AnalysisModel::MeanValueAnalysis, lambda, mu, bufferSize, numNodes}, [&]() {
+        return QueueingModels::MeanValueAnalysis(lambda, mu, bufferSize, numNodes);
+    });
 }
 
 // Метод Гордона-Ньюэлла
 double AnalysisMethods::GordonNewellMethod(double lambda, double mu, int bufferSize, int numNodes) {
-    return QueueingModels::GordonNewellMethod(lambda, mu, bufferSize, numNodes);
+    return Cached({AnalysisModel::GordonNewell, lambda, mu, bufferSize, numNodes}, [&]() {
+        return QueueingModels::GordonNewellMethod(lambda, mu, bufferSize, numNodes);
+    });
 }
 
 // Метод Бузена
 double AnalysisMethods::BuzenMethod(double lambda, double mu, int bufferSize, int numNodes) {
-    return QueueingModels::BuzenMethod(lambda, mu, bufferSize, numNodes);
+    return Cached({AnalysisModel::Buzen, lambda, mu, bufferSize, numNodes}, [&]() {
+        return QueueingModels::BuzenMethod(lambda, mu, bufferSize, numNodes);
+    });
 }
 
 // MVA задержка - режим 1 (Ad-hoc)
@@ -117,35 +285,181 @@ double AnalysisMethods::CalculateMVADelay_Mode1(double lambda, double mu, int bu
 // MVA задержка - режим 2 (Group)
 // Используем чистую формулу M/M/1 для иерархической сети
 double AnalysisMethods::CalculateMVADelay_Mode2(double lambda, double mu, int bufferSize, int numGroups, int nodesPerGroup) {
-    if (lambda < 0.0 || mu <= 0.0 || numGroups <= 0 || nodesPerGroup <= 0) return 0.0;
-    
-    // Нагрузка распределяется между группами
-    double lambdaPerGroup = lambda / static_cast<double>(numGroups);
-    
-    // Задержка внутри одной группы (последовательная сеть из nodesPerGroup узлов)
-    double delayPerGroup = CalculateSeriesMM1Delay(lambdaPerGroup, mu, nodesPerGroup);
-    
-    if (std::isinf(delayPerGroup)) {
-        return std::numeric_limits<double>::infinity();
+    return Cached({AnalysisModel::MVADelayMode2, lambda, mu, bufferSize, numGroups, nodesPerGroup}, [&]() {
+        if (lambda < 0.0 || mu <= 0.0 || numGroups <= 0 || nodesPerGroup <= 0) return 0.0;
+
+        // Нагрузка распределяется между группами
+        double lambdaPerGroup = lambda / static_cast<double>(numGroups);
+
+        // Задержка внутри одной группы (последовательная сеть из nodesPerGroup узлов)
+        double delayPerGroup = CalculateSeriesMM1Delay(lambdaPerGroup, mu, nodesPerGroup);
+
+        if (std::isinf(delayPerGroup)) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        // Эффективная скорость обслуживания группы
+        double effectiveServiceRate = 1.0 / delayPerGroup;
+
+        // Задержка между группами (numGroups - 1 связей между группами)
+        if (lambdaPerGroup >= effectiveServiceRate) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        // Задержка на одной связи между группами
+        double delayPerLink = 1.0 / (effectiveServiceRate - lambdaPerGroup);
+        // Всего (numGroups - 1) связей между numGroups группами
+        double delayBetweenGroups = static_cast<double>(numGroups - 1) * delayPerLink;
+
+        // Общая задержка = задержка внутри группы + задержка между группами
+        double totalDelay = delayPerGroup + delayBetweenGroups;
+
+        return totalDelay;
+    });
+}
+
+// MVA задержка - режим 2 (Group) для узлов с разными интенсивностями обслуживания
+double AnalysisMethods::CalculateMVADelay_Mode2(double lambda, const std::vector<double>& serviceRates, int numGroups) {
+    const size_t numNodes = serviceRates.size();
+    if (lambda < 0.0 || numNodes == 0 || numGroups <= 0) return 0.0;
+
+    const size_t groups = std::min(static_cast<size_t>(numGroups), numNodes);
+    const double lambdaPerGroup = lambda / static_cast<double>(groups);
+    double groupDelay = 0.0;
+    double linkDelay = 0.0;
+    for (size_t g = 0, node = 0; g < groups; ++g) {
+        const size_t groupSize = numNodes / groups + ((g < numNodes % groups) ? 1 : 0);
+        std::vector<double> rates(serviceRates.begin() + node, serviceRates.begin() + node + groupSize);
+        node += groupSize;
+
+        const double delay = CalculateSeriesMM1Delay(lambdaPerGroup, rates);
+        if (std::isinf(delay) || delay <= 0.0 || lambdaPerGroup >= 1.0 / delay) {
+            return std::numeric_limits<double>::infinity();
+        }
+        groupDelay += delay;
+        linkDelay += 1.0 / (1.0 / delay - lambdaPerGroup);
     }
-    
-    // Эффективная скорость обслуживания группы
-    double effectiveServiceRate = 1.0 / delayPerGroup;
-    
-    // Задержка между группами (numGroups - 1 связей между группами)
-    if (lambdaPerGroup >= effectiveServiceRate) {
-        return std::numeric_limits<double>::infinity();
+    return (groupDelay + static_cast<double>(groups - 1) * linkDelay) / static_cast<double>(groups);
+}
+
+// Пакетные варианты: один вызов ядра BatchModels на весь массив λ
+std::vector<double> AnalysisMethods::MM1KAnalysisBatch(const std::vector<double>& lambdas, double mu, int bufferSize) {
+    std::vector<double> out(lambdas.size());
+    BatchModels::MM1KThroughput(lambdas.data(), lambdas.size(), mu, bufferSize, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::MMLossModelBatch(const std::vector<double>& lambdas, double mu, int bufferSize) {
+    std::vector<double> out(lambdas.size());
+    BatchModels::MM1KLoss(lambdas.data(), lambdas.size(), mu, bufferSize, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::MeanValueAnalysisBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes) {
+    std::vector<double> out(lambdas.size());
+    BatchModels::MeanValueAnalysis(lambdas.data(), lambdas.size(), mu, bufferSize, numNodes, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::GlobalBalanceMethodBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes) {
+    (void)numNodes; // Как и скалярный вариант, не зависит от числа узлов
+    std::vector<double> out(lambdas.size());
+    BatchModels::GlobalBalanceMethod(lambdas.data(), lambdas.size(), mu, bufferSize, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::GordonNewellMethodBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes) {
+    std::vector<double> out(lambdas.size());
+    BatchModels::GordonNewellMethod(lambdas.data(), lambdas.size(), mu, bufferSize, numNodes, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::BuzenMethodBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes) {
+    std::vector<double> out(lambdas.size());
+    BatchModels::BuzenMethod(lambdas.data(), lambdas.size(), mu, bufferSize, numNodes, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::CalculateMVADelay_Mode1Batch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes) {
+    (void)bufferSize;
+    std::vector<double> out(lambdas.size());
+    BatchModels::SeriesMM1Delay(lambdas.data(), lambdas.size(), mu, numNodes, out.data());
+    return out;
+}
+
+std::vector<double> AnalysisMethods::CalculateMVADelay_Mode2Batch(const std::vector<double>& lambdas, double mu, int bufferSize, int numGroups, int nodesPerGroup) {
+    (void)bufferSize;
+    std::vector<double> out(lambdas.size());
+    BatchModels::MVADelayMode2(lambdas.data(), lambdas.size(), mu, numGroups, nodesPerGroup, out.data());
+    return out;
+}
+
+// Замкнутая сеть узлов: точный алгоритм свёртки Бузена
+ClosedNetworkResult AnalysisMethods::ClosedNetworkAnalysis(const std::vector<double>& nodeLoads,
+                                                           const std::vector<uint32_t>& nodeBuffers,
+                                                           double mu) {
+    return ConvolutionAlgorithm::SolveForNodes(nodeLoads, nodeBuffers, mu);
+}
+
+ClosedNetworkResult AnalysisMethods::ClosedNetworkAnalysis(const std::vector<double>& nodeLoads,
+                                                           const std::vector<uint32_t>& nodeBuffers,
+                                                           const std::vector<double>& serviceRates) {
+    return ConvolutionAlgorithm::SolveForNodes(nodeLoads, nodeBuffers, serviceRates);
+}
+
+// Узлы с разными μ_i: M/M/1/K по каждому узлу и MVA по всей сети
+NodeUtilizationResult AnalysisMethods::HeterogeneousNodeAnalysis(double lambda,
+                                                                 const std::vector<double>& nodeLoads,
+                                                                 const std::vector<double>& serviceRates,
+                                                                 const std::vector<uint32_t>& nodeBuffers,
+                                                                 int defaultBufferSize) {
+    NodeUtilizationResult result;
+    const size_t numNodes = std::min(nodeLoads.size(), serviceRates.size());
+    if (numNodes == 0) return result;
+
+    result.arrivalRate.resize(numNodes);
+    result.serviceRate.assign(serviceRates.begin(), serviceRates.begin() + numNodes);
+    result.utilization.resize(numNodes);
+    result.lossRate.resize(numNodes);
+    result.delay.resize(numNodes);
+
+    std::vector<uint32_t> buffers(numNodes);
+    for (size_t i = 0; i < numNodes; ++i) {
+        buffers[i] = (i < nodeBuffers.size() && nodeBuffers[i] > 0)
+            ? nodeBuffers[i]
+            : static_cast<uint32_t>(std::max(defaultBufferSize, 1));
+
+        const double arrival = std::max(0.0, lambda * nodeLoads[i]);
+        const double mu = serviceRates[i];
+        const int K = static_cast<int>(buffers[i]);
+        result.arrivalRate[i] = arrival;
+        result.lossRate[i] = MMLossModel(arrival, mu, K);
+        result.utilization[i] = (mu > 0.0) ? MM1KAnalysis(arrival, mu, K) / mu : 0.0;
+        result.delay[i] = (arrival > 0.0) ? QueueingModels::Calculate_MM1K_Delay(arrival, mu, K) : 0.0;
+
+        const double offered = (mu > 0.0) ? arrival / mu : 0.0;
+        if (i == 0 || offered > result.bottleneckLoad) {
+            result.bottleneck = i;
+            result.bottleneckLoad = offered;
+        }
     }
-    
-    // Задержка на одной связи между группами
-    double delayPerLink = 1.0 / (effectiveServiceRate - lambdaPerGroup);
-    // Всего (numGroups - 1) связей между numGroups группами
-    double delayBetweenGroups = static_cast<double>(numGroups - 1) * delayPerLink;
-    
-    // Общая задержка = задержка внутри группы + задержка между группами
-    double totalDelay = delayPerGroup + delayBetweenGroups;
-    
-    return totalDelay;
+
+    // Замкнутая сеть как в ConvolutionAlgorithm::SolveForNodes: e_i - нагрузки,
+    // нормированные на среднюю, число заявок - суммарная ёмкость буферов
+    double meanLoad = 0.0;
+    for (size_t i = 0; i < numNodes; ++i) meanLoad += nodeLoads[i];
+    meanLoad /= static_cast<double>(numNodes);
+
+    std::vector<double> visitRatios(numNodes, 1.0);
+    std::vector<double> serviceTimes(numNodes, 0.0);
+    int population = 0;
+    for (size_t i = 0; i < numNodes; ++i) {
+        if (meanLoad > 0.0) visitRatios[i] = nodeLoads[i] / meanLoad;
+        if (serviceRates[i] > 0.0) serviceTimes[i] = 1.0 / serviceRates[i];
+        population += static_cast<int>(buffers[i]);
+    }
+    result.closedNetwork = QueueingModels::CalculateMVA_Network(visitRatios, serviceTimes, population);
+    return result;
 }
 
 // Специализированная модель для Ad-Hoc сетей
@@ -156,9 +470,9 @@ double AnalysisMethods::AdHocThroughputModel(double load, double dataRateMbps, i
     // Каждый узел конкурирует за доступ к каналу
     double totalLoad = load * dataRateMbps;
     
-    // Эвристика: пропускная способность уменьшается из-за конкуренции
+    // Пропускная способность уменьшается из-за конкуренции
     // Коэффициент эффективности зависит от числа узлов
-    double efficiency = 1.0 / (1.0 + 0.1 * (numNodes - 1));
+    double efficiency = 1.0 / (1.0 + g_throughputCoefficients.adHocContention * (numNodes - 1));
     
     // Ограничиваем пропускную способность максимальной скоростью канала
     double throughput = totalLoad * efficiency;
@@ -173,12 +487,59 @@ double AnalysisMethods::GroupThroughputModel(double load, double dataRateMbps, i
     // Группы работают более эффективно благодаря агрегации трафика
     double totalLoad = load * dataRateMbps;
     
-    // Эвристика: группирование улучшает эффективность
+    // Группирование улучшает эффективность
     // Коэффициент эффективности выше для меньшего числа групп
-    double efficiency = 1.0 - 0.05 * (numGroups - 1);
-    efficiency = std::max(0.5, efficiency); // Минимум 50% эффективности
+    double efficiency = 1.0 - g_throughputCoefficients.groupPenalty * (numGroups - 1);
+    efficiency = std::max(g_throughputCoefficients.groupFloor, efficiency); // Нижняя граница эффективности
     
     // Ограничиваем пропускную способность максимальной скоростью канала
     double throughput = totalLoad * efficiency;
     return std::min(throughput, dataRateMbps);
-}
\ No newline at end of file
+}
+
+// Ad-Hoc: насыщение 802.11 DCF (неподвижная точка Бианки)
+double AnalysisMethods::AdHocDcfThroughputModel(double offeredMbps, const std::string& wifiStandard,
+                                                uint32_t packetSize, int numNodes) {
+    if (offeredMbps <= 0.0 || numNodes <= 0) return 0.0;
+
+    DcfSaturationResult saturation = DcfModel::Solve(DcfModel::ForStandard(wifiStandard), packetSize,
+                                                     static_cast<uint32_t>(numNodes));
+    return std::min(offeredMbps, saturation.throughputMbps);
+}
+
+// Group: иерархическая декомпозиция (CSMA сети групп + магистраль)
+GroupModelResult AnalysisMethods::GroupHierarchicalModel(double lambda,
+                                                         const std::vector<double>& nodeLoads,
+                                                         const std::vector<double>& nodeDataRatesMbps,
+                                                         const std::vector<uint32_t>& nodeBuffers,
+                                                         int defaultBufferSize,
+                                                         int numGroups,
+                                                         uint32_t packetSize,
+                                                         double linkDelayMs,
+                                                         const BackboneParameters& backbone) {
+    if (lambda <= 0.0 || numGroups <= 0) return GroupModelResult();
+
+    GroupNetworkParameters parameters;
+    parameters.lambda = lambda;
+    parameters.nodeLoads = nodeLoads;
+    parameters.dataRatesMbps = nodeDataRatesMbps;
+    parameters.buffers.resize(nodeLoads.size());
+    for (size_t i = 0; i < nodeLoads.size(); ++i) {
+        parameters.buffers[i] = (i < nodeBuffers.size() && nodeBuffers[i] > 0)
+            ? nodeBuffers[i]
+            : static_cast<uint32_t>(std::max(defaultBufferSize, 1));
+    }
+    parameters.numGroups = static_cast<uint32_t>(numGroups);
+    parameters.packetSize = packetSize;
+    parameters.linkDelayMs = linkDelayMs;
+    parameters.backbone = backbone;
+    return HierarchicalGroupModel::Evaluate(parameters);
+}
+
+void AnalysisMethods::SetThroughputModelCoefficients(const ThroughputModelCoefficients& coefficients) {
+    g_throughputCoefficients = coefficients;
+}
+
+const ThroughputModelCoefficients& AnalysisMethods::GetThroughputModelCoefficients() {
+    return g_throughputCoefficients;
+}
@@ -5,6 +5,46 @@
 
 #include <vector>
 #include <limits> // Для std::numeric_limits
+#include <cstdint>
+#include <string>
+
+#include "convolution_algorithm.h"
+#include "ctmc_solver.h"
+#include "jackson_network.h"
+#include "dcf_model.h"
+#include "hierarchical_model.h"
+#include "tandem_decomposition.h"
+#include "single_queue_models.h"
+
+/**
+ * Коэффициенты эвристических моделей пропускной способности:
+ *   AdHoc: efficiency = 1 / (1 + adHocContention * (N - 1))
+ *   Group: efficiency = max(groupFloor, 1 - groupPenalty * (G - 1))
+ * Значения по умолчанию - исходные эвристики; подбираются ModelCalibration.
+ */
+struct ThroughputModelCoefficients {
+    double adHocContention = 0.1;
+    double groupPenalty = 0.05;
+    double groupFloor = 0.5;
+};
+
+/**
+ * Анализ узлов с разными интенсивностями обслуживания μ_i:
+ * открытая модель - каждый узел M/M/1/K с λ_i = λ * load_i, μ_i, K_i;
+ * замкнутая модель - MVA с требованиями D_i = e_i / μ_i.
+ * Узкое место - узел с наибольшей предлагаемой загрузкой λ_i / μ_i
+ * (он же ограничивает замкнутую сеть: λ(N) <= 1 / max D_i).
+ */
+struct NodeUtilizationResult {
+    std::vector<double> arrivalRate;   // λ_i
+    std::vector<double> serviceRate;   // μ_i
+    std::vector<double> utilization;   // ρ_i = λ_i (1 - p_K) / μ_i
+    std::vector<double> lossRate;      // p_K узла
+    std::vector<double> delay;         // T_s узла (закон Литтла)
+    ClosedNetworkResult closedNetwork; // MVA по всем узлам
+    size_t bottleneck = 0;
+    double bottleneckLoad = 0.0;       // λ_b / μ_b
+};
 
 class AnalysisMethods {
 public:
@@ -33,11 +73,66 @@ public:
     static double GlobalBalanceMethod(double lambda, double mu, int bufferSize);
     static double GlobalBalanceMethod(double lambda, double mu, int bufferSize, int numNodes);
 
+    // Точное решение цепи Маркова для всей сети узлов с конечными буферами.
+    // numGroups <= 0 - Ad-Hoc (все узлы делят один канал с интенсивностью mu),
+    // иначе групповая сеть: обычные узлы группы делят CSMA канал (mu),
+    // главный узел передаёт по своей магистральной связи (2 * mu).
+    static CtmcNetworkResult GlobalBalanceNetwork(double lambda, double mu,
+                                                  const std::vector<double>& nodeLoads,
+                                                  const std::vector<uint32_t>& nodeBuffers,
+                                                  int defaultBufferSize,
+                                                  int numGroups);
+
+    // Открытая сеть Джексона по правилам генерации трафика симуляторов
+    // (numGroups <= 0 - Ad-Hoc, иначе групповая сеть с магистралью backbone);
+    // serviceRates - μ_i узлов, станции M/M/1/K с ёмкостями nodeBuffers
+    static JacksonNetworkResult JacksonNetworkAnalysis(double lambda,
+                                                       const std::vector<double>& nodeLoads,
+                                                       const std::vector<double>& serviceRates,
+                                                       const std::vector<uint32_t>& nodeBuffers,
+                                                       int defaultBufferSize,
+                                                       int numGroups,
+                                                       const BackboneParameters& backbone = BackboneParameters());
+
+    // Декомпозиция сети узлов с конечными буферами и блокировкой после обслуживания
+    // с маршрутизацией JacksonNetworkAnalysis; пустой результат - маршрутизация
+    // не сводится к одному преемнику станции (TandemDecomposition::FromRouting)
+    static TandemNetworkResult TandemDecompositionAnalysis(double lambda,
+                                                           const std::vector<double>& nodeLoads,
+                                                           const std::vector<double>& serviceRates,
+                                                           const std::vector<uint32_t>& nodeBuffers,
+                                                           int defaultBufferSize,
+                                                           int numGroups,
+                                                           const BackboneParameters& backbone = BackboneParameters());
+
+    // Общий канал как одна очередь M/M/c/K: поток lambda * Σ load_i, средняя μ_i,
+    // servers параллельно передающих (1 - Ad-Hoc, по группе - групповая сеть),
+    // ёмкость - сумма буферов узлов
+    static QueueModelResult PooledChannelAnalysis(double lambda,
+                                                  const std::vector<double>& nodeLoads,
+                                                  const std::vector<double>& serviceRates,
+                                                  const std::vector<uint32_t>& nodeBuffers,
+                                                  int defaultBufferSize,
+                                                  int servers);
+
+    // Независимые узлы M/G/1/K (λ_i = lambda * load_i, μ_i, K_i, общий serviceScv):
+    // throughput и avgSystemSize - суммы по узлам, delay - по закону Литтла,
+    // lossProbability - доля потерянного предложенного трафика; distribution пусто
+    static QueueModelResult IndependentNodesMG1K(double lambda,
+                                                 const std::vector<double>& nodeLoads,
+                                                 const std::vector<double>& serviceRates,
+                                                 const std::vector<uint32_t>& nodeBuffers,
+                                                 int defaultBufferSize,
+                                                 double serviceScv);
+
     // -----------------------------------------------------------------
     // АНАЛИЗ ЗАДЕРЖКИ В СЕТИ ПОСЛЕДОВАТЕЛЬНЫХ УЗЛОВ M/M/1 - 3 параметра
     // -----------------------------------------------------------------
 
     static double CalculateSeriesMM1Delay(double lambda, double mu, int numNodes);
+    
+    // Последовательная сеть узлов M/M/1 с разными μ_i: Σ 1 / (μ_i - λ)
+    static double CalculateSeriesMM1Delay(double lambda, const std::vector<double>& serviceRates);
 
     // -----------------------------------------------------------------
     // МЕТОДЫ АНАЛИЗА СРЕДНИХ ЗНАЧЕНИЙ (MVA) И ДРУГИЕ МЕТОДЫ
@@ -49,12 +144,66 @@ public:
     static double CalculateMVADelay_Mode1(double lambda, double mu, int bufferSize, int numNodes);
     static double CalculateMVADelay_Mode2(double lambda, double mu, int bufferSize, int numGroups, int nodesPerGroup);
 
+    // Режим 2 для узлов с разными μ_i (serviceRates по узлам, группы - разбиение GroupSimulator):
+    // средняя по группам задержка внутри группы + (numGroups - 1) средних задержек связи
+    static double CalculateMVADelay_Mode2(double lambda, const std::vector<double>& serviceRates, int numGroups);
+
+    // Алгоритм свёртки Бузена для замкнутой сети узлов (по nodeLoads / nodeBuffers)
+    static ClosedNetworkResult ClosedNetworkAnalysis(const std::vector<double>& nodeLoads,
+                                                     const std::vector<uint32_t>& nodeBuffers,
+                                                     double mu);
+
+    static ClosedNetworkResult ClosedNetworkAnalysis(const std::vector<double>& nodeLoads,
+                                                     const std::vector<uint32_t>& nodeBuffers,
+                                                     const std::vector<double>& serviceRates);
+
+    // Поузловые загрузки и узкое место для узлов с разными μ_i
+    static NodeUtilizationResult HeterogeneousNodeAnalysis(double lambda,
+                                                           const std::vector<double>& nodeLoads,
+                                                           const std::vector<double>& serviceRates,
+                                                           const std::vector<uint32_t>& nodeBuffers,
+                                                           int defaultBufferSize);
+
+    // -----------------------------------------------------------------
+    // ПАКЕТНЫЕ ВАРИАНТЫ (массив λ -> массив результатов, см. BatchModels)
+    // -----------------------------------------------------------------
+
+    static std::vector<double> MM1KAnalysisBatch(const std::vector<double>& lambdas, double mu, int bufferSize);
+    static std::vector<double> MMLossModelBatch(const std::vector<double>& lambdas, double mu, int bufferSize);
+    static std::vector<double> MeanValueAnalysisBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes);
+    static std::vector<double> GlobalBalanceMethodBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes);
+    static std::vector<double> GordonNewellMethodBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes);
+    static std::vector<double> BuzenMethodBatch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes);
+    static std::vector<double> CalculateMVADelay_Mode1Batch(const std::vector<double>& lambdas, double mu, int bufferSize, int numNodes);
+    static std::vector<double> CalculateMVADelay_Mode2Batch(const std::vector<double>& lambdas, double mu, int bufferSize, int numGroups, int nodesPerGroup);
+
     // -----------------------------------------------------------------
     // СПЕЦИАЛИЗИРОВАННЫЕ МОДЕЛИ ДЛЯ AD-HOC И ГРУППОВЫХ СЕТЕЙ
     // -----------------------------------------------------------------
 
     static double AdHocThroughputModel(double load, double dataRateMbps, int numNodes);
     static double GroupThroughputModel(double load, double dataRateMbps, int numGroups);
+
+    // Ad-Hoc по модели DCF Бианки: предлагаемая нагрузка (Мбит/с на уровне IP),
+    // ограниченная пропускной способностью насыщения numNodes станций
+    static double AdHocDcfThroughputModel(double offeredMbps, const std::string& wifiStandard,
+                                          uint32_t packetSize, int numNodes);
+
+    // Group по декомпозиции CSMA сетей групп и магистрали backbone
+    // (nodeDataRatesMbps - скорость CSMA устройства узла, буфер узла 0 - defaultBufferSize)
+    static GroupModelResult GroupHierarchicalModel(double lambda,
+                                                   const std::vector<double>& nodeLoads,
+                                                   const std::vector<double>& nodeDataRatesMbps,
+                                                   const std::vector<uint32_t>& nodeBuffers,
+                                                   int defaultBufferSize,
+                                                   int numGroups,
+                                                   uint32_t packetSize,
+                                                   double linkDelayMs,
+                                                   const BackboneParameters& backbone = BackboneParameters());
+
+    // Коэффициенты моделей выше (устанавливаются до запуска параллельных расчётов)
+    static void SetThroughputModelCoefficients(const ThroughputModelCoefficients& coefficients);
+    static const ThroughputModelCoefficients& GetThroughputModelCoefficients();
 };
 
 #endif
\ No newline at end of file
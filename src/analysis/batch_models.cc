@@ -0,0 +1,235 @@
+#include "batch_models.h"
+#include "queueing_models.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Размер блока: рабочие массивы блока помещаются в L1
+const size_t kBlockSize = 256;
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+/**
+ * Для блока λ вычисляет t = min(ρ, 1/ρ) и t^K.
+ * M/M/1/K симметрична: p_n(ρ) = p_{K-n}(1/ρ), поэтому все формулы
+ * записываются через t <= 1 и не переполняются при ρ >> 1.
+ */
+inline void ReducedPowers(const double* lambdas, size_t n, double mu, int K,
+                          double* rho, double* t, double* tK) {
+    for (size_t i = 0; i < n; ++i) {
+        double r = std::max(lambdas[i], 0.0) / mu;
+        rho[i] = r;
+        t[i] = (r <= 1.0) ? r : 1.0 / r;
+    }
+    BatchModels::PowerInteger(t, n, static_cast<unsigned>(K), tK);
+}
+
+inline void FillZero(double* out, size_t count) {
+    std::fill(out, out + count, 0.0);
+}
+
+} // namespace
+
+void BatchModels::PowerInteger(const double* base, size_t count, unsigned exponent, double* out) {
+    double square[kBlockSize];
+
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        const size_t n = std::min(kBlockSize, count - offset);
+        const double* b = base + offset;
+        double* result = out + offset;
+
+        for (size_t i = 0; i < n; ++i) {
+            result[i] = 1.0;
+            square[i] = b[i];
+        }
+
+        // Двоичное возведение: цикл по битам показателя общий для всех точек
+        for (unsigned e = exponent; e != 0; e >>= 1) {
+            if (e & 1u) {
+                for (size_t i = 0; i < n; ++i) result[i] *= square[i];
+            }
+            if (e > 1u) {
+                for (size_t i = 0; i < n; ++i) square[i] *= square[i];
+            }
+        }
+    }
+}
+
+void BatchModels::MM1KLoss(const double* lambdas, size_t count, double mu, int bufferSize, double* out) {
+    if (mu <= 0.0 || bufferSize <= 0) {
+        FillZero(out, count); // M/M/1 без потерь
+        return;
+    }
+
+    const int K = bufferSize;
+    const double uniform = 1.0 / (static_cast<double>(K) + 1.0);
+    double rho[kBlockSize], t[kBlockSize], tK[kBlockSize];
+
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        const size_t n = std::min(kBlockSize, count - offset);
+        const double* lambda = lambdas + offset;
+        double* result = out + offset;
+
+        ReducedPowers(lambda, n, mu, K, rho, t, tK);
+
+        for (size_t i = 0; i < n; ++i) {
+            double tK1 = tK[i] * t[i];
+            double below = (1.0 - t[i]) * tK[i] / (1.0 - tK1); // ρ < 1
+            double above = (1.0 - t[i]) / (1.0 - tK1);         // ρ > 1, t = 1/ρ
+            double pK = (std::abs(rho[i] - 1.0) < 1e-9) ? uniform : ((rho[i] < 1.0) ? below : above);
+            result[i] = (lambda[i] > 0.0) ? pK : 0.0;
+        }
+    }
+}
+
+void BatchModels::MM1KThroughput(const double* lambdas, size_t count, double mu, int bufferSize, double* out) {
+    if (mu <= 0.0) {
+        FillZero(out, count);
+        return;
+    }
+
+    if (bufferSize <= 0) {
+        // M/M/1 (бесконечный буфер)
+        for (size_t i = 0; i < count; ++i) {
+            double lambda = lambdas[i];
+            double value = (lambda < mu) ? lambda : mu;
+            out[i] = (lambda > 0.0) ? value : 0.0;
+        }
+        return;
+    }
+
+    MM1KLoss(lambdas, count, mu, bufferSize, out);
+    for (size_t i = 0; i < count; ++i) {
+        double lambda = lambdas[i];
+        out[i] = (lambda > 0.0) ? lambda * (1.0 - out[i]) : 0.0;
+    }
+}
+
+void BatchModels::MM1KAvgSystemSize(const double* lambdas, size_t count, double mu, int bufferSize, double* out) {
+    if (mu <= 0.0) {
+        FillZero(out, count);
+        return;
+    }
+
+    if (bufferSize <= 0) {
+        for (size_t i = 0; i < count; ++i) {
+            double rho = lambdas[i] / mu;
+            double value = (rho < 1.0) ? rho / (1.0 - rho) : kInfinity;
+            out[i] = (lambdas[i] > 0.0) ? value : 0.0;
+        }
+        return;
+    }
+
+    const int K = bufferSize;
+    const double Kd = static_cast<double>(K);
+    double rho[kBlockSize], t[kBlockSize], tK[kBlockSize];
+
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        const size_t n = std::min(kBlockSize, count - offset);
+        const double* lambda = lambdas + offset;
+        double* result = out + offset;
+
+        ReducedPowers(lambda, n, mu, K, rho, t, tK);
+
+        for (size_t i = 0; i < n; ++i) {
+            // L(t) = t(1 - (K+1)t^K + K t^(K+1)) / ((1-t)(1-t^(K+1))), L(ρ > 1) = K - L(1/ρ)
+            double tK1 = tK[i] * t[i];
+            double num = t[i] * (1.0 - (Kd + 1.0) * tK[i] + Kd * tK1);
+            double den = (1.0 - t[i]) * (1.0 - tK1);
+            double reduced = num / den;
+            double value = (rho[i] < 1.0) ? reduced : Kd - reduced;
+            value = (std::abs(rho[i] - 1.0) < 1e-9) ? Kd / 2.0 : value;
+            result[i] = (lambda[i] > 0.0) ? value : 0.0;
+        }
+    }
+}
+
+void BatchModels::MM1KDelay(const double* lambdas, size_t count, double mu, int bufferSize, double* out) {
+    if (mu <= 0.0) {
+        FillZero(out, count);
+        return;
+    }
+
+    double throughput[kBlockSize];
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        const size_t n = std::min(kBlockSize, count - offset);
+        double* result = out + offset;
+
+        MM1KAvgSystemSize(lambdas + offset, n, mu, bufferSize, result);
+        MM1KThroughput(lambdas + offset, n, mu, bufferSize, throughput);
+
+        // Закон Литтла: T_s = L_s / λ_eff
+        for (size_t i = 0; i < n; ++i) {
+            double L = result[i];
+            double value = (throughput[i] > 0.0) ? L / throughput[i] : kInfinity;
+            value = std::isinf(L) ? kInfinity : value;
+            result[i] = (L > 0.0) ? value : 0.0;
+        }
+    }
+}
+
+void BatchModels::MeanValueAnalysis(const double* lambdas, size_t count, double mu, int bufferSize, int numNodes, double* out) {
+    MM1KThroughput(lambdas, count, mu, bufferSize, out);
+    const double factor = QueueingModels::MVANetworkFactor(numNodes);
+    for (size_t i = 0; i < count; ++i) out[i] *= factor;
+}
+
+void BatchModels::GlobalBalanceMethod(const double* lambdas, size_t count, double mu, int bufferSize, double* out) {
+    MM1KThroughput(lambdas, count, mu, bufferSize, out);
+}
+
+void BatchModels::GordonNewellMethod(const double* lambdas, size_t count, double mu, int bufferSize, int numNodes, double* out) {
+    MM1KThroughput(lambdas, count, mu, bufferSize, out);
+    const double factor = QueueingModels::GordonNewellNetworkFactor(mu, bufferSize, numNodes);
+    for (size_t i = 0; i < count; ++i) out[i] *= factor;
+}
+
+void BatchModels::BuzenMethod(const double* lambdas, size_t count, double mu, int bufferSize, int numNodes, double* out) {
+    MM1KThroughput(lambdas, count, mu, bufferSize, out);
+    const double factor = QueueingModels::BuzenNetworkFactor(mu, bufferSize, numNodes);
+    for (size_t i = 0; i < count; ++i) out[i] *= factor;
+}
+
+void BatchModels::SeriesMM1Delay(const double* lambdas, size_t count, double mu, int numNodes, double* out) {
+    if (mu <= 0.0 || numNodes <= 0) {
+        FillZero(out, count);
+        return;
+    }
+
+    const double N = static_cast<double>(numNodes);
+    for (size_t i = 0; i < count; ++i) {
+        double lambda = lambdas[i];
+        double value = (lambda >= mu) ? kInfinity : N / (mu - lambda);
+        value = (std::abs(lambda) < 1e-9) ? N / mu : value;
+        out[i] = (lambda < 0.0) ? 0.0 : value;
+    }
+}
+
+void BatchModels::MVADelayMode2(const double* lambdas, size_t count, double mu, int numGroups, int nodesPerGroup, double* out) {
+    if (mu <= 0.0 || numGroups <= 0 || nodesPerGroup <= 0) {
+        FillZero(out, count);
+        return;
+    }
+
+    const double G = static_cast<double>(numGroups);
+    const double nodes = static_cast<double>(nodesPerGroup);
+    for (size_t i = 0; i < count; ++i) {
+        double lambda = lambdas[i];
+        double lambdaPerGroup = lambda / G;
+
+        // Задержка внутри группы (последовательная сеть M/M/1)
+        double delayPerGroup = (lambdaPerGroup >= mu) ? kInfinity : nodes / (mu - lambdaPerGroup);
+        delayPerGroup = (std::abs(lambdaPerGroup) < 1e-9) ? nodes / mu : delayPerGroup;
+
+        // Связи между группами
+        double effectiveServiceRate = 1.0 / delayPerGroup;
+        double delayPerLink = 1.0 / (effectiveServiceRate - lambdaPerGroup);
+        double total = delayPerGroup + (G - 1.0) * delayPerLink;
+        total = (lambdaPerGroup >= effectiveServiceRate) ? kInfinity : total;
+
+        out[i] = (lambda < 0.0) ? 0.0 : total;
+    }
+}
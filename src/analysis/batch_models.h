@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Пакетные (векторные) варианты аналитических моделей.
+ *
+ * Каждая функция принимает непрерывный массив значений λ (lambdas[0..count))
+ * и пишет результаты в out[0..count). Семантика совпадает со скалярными
+ * методами QueueingModels / AnalysisMethods.
+ *
+ * Вычисления идут блоками фиксированного размера; внутренние циклы
+ * не содержат ветвлений и зависимостей между точками, поэтому
+ * компилятор векторизует их. Степени ρ^K считаются двоичным возведением
+ * (рекуррентные возведения в квадрат) вместо std::pow в каждой точке;
+ * при ρ > 1 используется симметричная форма через 1/ρ без переполнения.
+ */
+class BatchModels {
+public:
+    // out[i] = base[i]^exponent
+    static void PowerInteger(const double* base, size_t count, unsigned exponent, double* out);
+
+    // === M/M/1/K ===
+    static void MM1KThroughput(const double* lambdas, size_t count, double mu, int bufferSize, double* out);
+    static void MM1KLoss(const double* lambdas, size_t count, double mu, int bufferSize, double* out);
+    static void MM1KAvgSystemSize(const double* lambdas, size_t count, double mu, int bufferSize, double* out);
+    static void MM1KDelay(const double* lambdas, size_t count, double mu, int bufferSize, double* out);
+
+    // === Сетевые методы (коэффициент сети считается один раз на пакет) ===
+    static void MeanValueAnalysis(const double* lambdas, size_t count, double mu, int bufferSize, int numNodes, double* out);
+    static void GlobalBalanceMethod(const double* lambdas, size_t count, double mu, int bufferSize, double* out);
+    static void GordonNewellMethod(const double* lambdas, size_t count, double mu, int bufferSize, int numNodes, double* out);
+    static void BuzenMethod(const double* lambdas, size_t count, double mu, int bufferSize, int numNodes, double* out);
+
+    // === Задержка ===
+    static void SeriesMM1Delay(const double* lambdas, size_t count, double mu, int numNodes, double* out);
+    static void MVADelayMode2(const double* lambdas, size_t count, double mu, int numGroups, int nodesPerGroup, double* out);
+};
@@ -0,0 +1,224 @@
+#include "buffer_optimizer.h"
+#include "queueing_models.h"
+#include "sensitivity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+const double kTailQuantile = 0.95;
+
+/**
+ * Таблица характеристик узлов: loss[i][K], tail[i][K] для K <= maxBuffer.
+ */
+class NodeTable {
+public:
+    NodeTable(const BufferAllocationProblem& problem, uint32_t maxBuffer)
+        : m_problem(problem),
+          m_loss(problem.arrivalRates.size(), std::vector<double>(maxBuffer + 1, 0.0)),
+          m_tail(problem.arrivalRates.size(), std::vector<double>(maxBuffer + 1, 0.0)) {
+        double totalRate = 0.0;
+        for (double rate : problem.arrivalRates) totalRate += std::max(rate, 0.0);
+        m_totalRate = totalRate;
+
+        for (size_t i = 0; i < problem.arrivalRates.size(); ++i) {
+            double lambda = problem.arrivalRates[i];
+            double mu = problem.serviceRates[i];
+            if (lambda <= 0.0) continue;
+            for (uint32_t K = std::max<uint32_t>(problem.minBuffer, 1); K <= maxBuffer; ++K) {
+                int k = static_cast<int>(K);
+                m_loss[i][K] = 1.0 - QueueingModels::Calculate_MM1K_Throughput(lambda, mu, k) / lambda;
+                m_tail[i][K] = QueueingModels::Calculate_MM1K_SojournQuantile(lambda, mu, k, kTailQuantile);
+            }
+        }
+    }
+
+    BufferAllocation Evaluate(const std::vector<uint32_t>& buffers) const {
+        BufferAllocation allocation;
+        allocation.buffers = buffers;
+
+        double lost = 0.0;
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            if (m_problem.arrivalRates[i] <= 0.0) continue;
+            lost += m_problem.arrivalRates[i] * m_loss[i][buffers[i]];
+            allocation.tailDelay = std::max(allocation.tailDelay, m_tail[i][buffers[i]]);
+        }
+        allocation.lossRate = (m_totalRate > 0.0) ? lost / m_totalRate : 0.0;
+        allocation.objective = allocation.lossRate + m_problem.delayWeight * allocation.tailDelay;
+        return allocation;
+    }
+
+private:
+    const BufferAllocationProblem& m_problem;
+    std::vector<std::vector<double>> m_loss;
+    std::vector<std::vector<double>> m_tail;
+    double m_totalRate;
+};
+
+uint32_t Total(const std::vector<uint32_t>& buffers) {
+    uint32_t total = 0;
+    for (uint32_t b : buffers) total += b;
+    return total;
+}
+
+// Жадное выделение по одному пакету узлу с наибольшим уменьшением J
+BufferAllocation GreedyStart(const NodeTable& table, const BufferAllocationProblem& problem) {
+    const size_t M = problem.arrivalRates.size();
+    BufferAllocation current = table.Evaluate(std::vector<uint32_t>(M, problem.minBuffer));
+    uint32_t used = problem.minBuffer * static_cast<uint32_t>(M);
+    while (used < problem.budget) {
+        BufferAllocation best = current;
+        for (size_t i = 0; i < M; ++i) {
+            std::vector<uint32_t> candidate = current.buffers;
+            ++candidate[i];
+            BufferAllocation value = table.Evaluate(candidate);
+            if (value.objective < best.objective) best = value;
+        }
+        if (best.objective >= current.objective) break; // Дополнительный буфер больше не помогает
+        current = best;
+        ++used;
+    }
+    return current;
+}
+
+/**
+ * Округление непрерывной релаксации: целые части, затем оставшиеся пакеты
+ * узлам с наибольшей дробной частью. Релаксация учитывает только потери;
+ * слагаемое задержки исправляет последующий локальный поиск.
+ */
+BufferAllocation RelaxedStart(const NodeTable& table, const BufferAllocationProblem& problem, uint32_t maxBuffer) {
+    std::vector<double> relaxed = SensitivityAnalysis::ContinuousBufferAllocation(
+        problem.arrivalRates, problem.serviceRates, problem.budget, problem.minBuffer);
+    const size_t M = relaxed.size();
+
+    std::vector<uint32_t> buffers(M);
+    double target = 0.0;
+    for (size_t i = 0; i < M; ++i) {
+        buffers[i] = std::min(maxBuffer, std::max(problem.minBuffer, static_cast<uint32_t>(std::floor(relaxed[i]))));
+        target += relaxed[i];
+    }
+    std::vector<size_t> order(M);
+    for (size_t i = 0; i < M; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return relaxed[a] - std::floor(relaxed[a]) > relaxed[b] - std::floor(relaxed[b]);
+    });
+    uint32_t limit = std::min<uint32_t>(problem.budget, static_cast<uint32_t>(std::lround(target)));
+    for (size_t k = 0; k < M && Total(buffers) < limit; ++k) {
+        if (buffers[order[k]] < maxBuffer) ++buffers[order[k]];
+    }
+    return table.Evaluate(buffers);
+}
+
+// Первое улучшающее изменение, пока оно есть
+BufferAllocation LocalSearch(const NodeTable& table,
+                             const BufferAllocationProblem& problem,
+                             uint32_t maxBuffer,
+                             BufferAllocation current) {
+    const size_t M = current.buffers.size();
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        std::vector<uint32_t> candidate = current.buffers;
+        const uint32_t used = Total(candidate);
+
+        auto tryCandidate = [&]() {
+            BufferAllocation value = table.Evaluate(candidate);
+            if (value.objective < current.objective - 1e-15) {
+                current = value;
+                improved = true;
+            }
+            return improved;
+        };
+
+        for (size_t i = 0; i < M && !improved; ++i) {
+            // Добавление пакета
+            if (used < problem.budget && candidate[i] < maxBuffer) {
+                ++candidate[i];
+                if (tryCandidate()) break;
+                --candidate[i];
+            }
+            // Удаление пакета
+            if (candidate[i] > problem.minBuffer) {
+                --candidate[i];
+                if (tryCandidate()) break;
+                ++candidate[i];
+            }
+            // Перенос пакета с узла i на узел j
+            for (size_t j = 0; j < M && candidate[i] > problem.minBuffer; ++j) {
+                if (j == i || candidate[j] >= maxBuffer) continue;
+                --candidate[i];
+                ++candidate[j];
+                if (tryCandidate()) break;
+                ++candidate[i];
+                --candidate[j];
+            }
+        }
+    }
+    return current;
+}
+
+} // namespace
+
+BufferAllocation BufferOptimizer::Evaluate(const BufferAllocationProblem& problem,
+                                           const std::vector<uint32_t>& buffers) {
+    uint32_t maxBuffer = std::max<uint32_t>(1, *std::max_element(buffers.begin(), buffers.end()));
+    NodeTable table(problem, maxBuffer);
+    return table.Evaluate(buffers);
+}
+
+std::vector<BufferAllocation> BufferOptimizer::Optimize(const BufferAllocationProblem& problem,
+                                                        const BufferOptimizerOptions& options) {
+    const size_t M = problem.arrivalRates.size();
+    if (M == 0 || problem.serviceRates.size() != M) {
+        throw std::invalid_argument("Buffer optimizer: arrival and service rates must be given for every node");
+    }
+    const uint32_t minBuffer = std::max<uint32_t>(problem.minBuffer, 1);
+    if (problem.budget < minBuffer * M) {
+        throw std::invalid_argument("Buffer budget " + std::to_string(problem.budget) +
+                                    " is less than " + std::to_string(minBuffer * M) + " (minimum per node)");
+    }
+
+    BufferAllocationProblem normalized = problem;
+    normalized.minBuffer = minBuffer;
+    const uint32_t maxBuffer = problem.budget - minBuffer * static_cast<uint32_t>(M - 1);
+    NodeTable table(normalized, maxBuffer);
+
+    BufferAllocation current = options.gradientStart
+        ? RelaxedStart(table, normalized, maxBuffer)
+        : GreedyStart(table, normalized);
+
+    // ЛОКАЛЬНЫЙ И ИТЕРИРОВАННЫЙ ЛОКАЛЬНЫЙ ПОИСК
+    std::map<std::vector<uint32_t>, BufferAllocation> candidates;
+    BufferAllocation best = LocalSearch(table, normalized, maxBuffer, current);
+    candidates[best.buffers] = best;
+
+    std::mt19937 generator(options.seed);
+    std::uniform_int_distribution<size_t> node(0, M - 1);
+    std::uniform_int_distribution<int> moves(1, 3);
+    for (int round = 0; round < options.perturbationRounds; ++round) {
+        std::vector<uint32_t> perturbed = best.buffers;
+        for (int k = moves(generator); k > 0; --k) {
+            size_t from = node(generator);
+            size_t to = node(generator);
+            if (from != to && perturbed[from] > minBuffer && perturbed[to] < maxBuffer) {
+                --perturbed[from];
+                ++perturbed[to];
+            }
+        }
+        BufferAllocation local = LocalSearch(table, normalized, maxBuffer, table.Evaluate(perturbed));
+        candidates[local.buffers] = local;
+        if (local.objective < best.objective) best = local;
+    }
+
+    std::vector<BufferAllocation> ranked;
+    for (const auto& entry : candidates) ranked.push_back(entry.second);
+    std::sort(ranked.begin(), ranked.end(), [](const BufferAllocation& a, const BufferAllocation& b) {
+        return a.objective < b.objective;
+    });
+    if (ranked.size() > options.numCandidates) ranked.resize(options.numCandidates);
+    return ranked;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Задача распределения буферов: узлы - независимые M/M/1/K,
+ * Σ K_i <= budget, K_i >= minBuffer.
+ *
+ * Целевая функция: J = доля потерь сети + delayWeight · max_i t95_i,
+ * где t95_i - 95-й перцентиль времени пребывания на узле i (с).
+ */
+struct BufferAllocationProblem {
+    std::vector<double> arrivalRates;
+    std::vector<double> serviceRates;
+    uint32_t budget = 0;
+    uint32_t minBuffer = 1;
+    double delayWeight = 0.05;
+};
+
+struct BufferAllocation {
+    std::vector<uint32_t> buffers;
+    double lossRate = 0.0;   // Σ λ_i p_K,i / Σ λ_i
+    double tailDelay = 0.0;  // max_i t95_i
+    double objective = 0.0;
+};
+
+struct BufferOptimizerOptions {
+    size_t numCandidates = 5;    // Сколько лучших различных распределений вернуть
+    int perturbationRounds = 200;
+    uint32_t seed = 1;
+    bool gradientStart = true;   // Старт из непрерывной релаксации вместо жадного выделения
+};
+
+/**
+ * Поиск распределения буферов по моделям M/M/1/K:
+ * 1) начальное распределение: округлённая непрерывная релаксация по
+ *    градиентам dp_K / dK (SensitivityAnalysis::ContinuousBufferAllocation),
+ *    либо жадное выделение по одному пакету узлу с наибольшим уменьшением J;
+ * 2) локальный поиск (перенос пакета между узлами, добавление, удаление);
+ * 3) итерированный локальный поиск со случайными возмущениями.
+ * Характеристики узлов для всех допустимых K вычисляются один раз.
+ */
+class BufferOptimizer {
+public:
+    // Лучшие различные распределения в порядке возрастания J;
+    // std::invalid_argument, если бюджет меньше numNodes * minBuffer
+    static std::vector<BufferAllocation> Optimize(const BufferAllocationProblem& problem,
+                                                  const BufferOptimizerOptions& options = BufferOptimizerOptions());
+
+    static BufferAllocation Evaluate(const BufferAllocationProblem& problem,
+                                     const std::vector<uint32_t>& buffers);
+};
@@ -0,0 +1,151 @@
+#include "convolution_algorithm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+const double kNegativeInfinity = -std::numeric_limits<double>::infinity();
+
+// ln(e^a + e^b) без переполнения
+inline double LogAdd(double a, double b) {
+    if (a == kNegativeInfinity) return b;
+    if (b == kNegativeInfinity) return a;
+    double hi = std::max(a, b);
+    double lo = std::min(a, b);
+    return hi + std::log1p(std::exp(lo - hi));
+}
+
+} // namespace
+
+std::vector<double> ConvolutionAlgorithm::LogNormalizationConstants(const std::vector<double>& serviceDemands,
+                                                                    int population) {
+    const int N = std::max(population, 0);
+
+    // g_0(n): G(0) = 1, G(n > 0) = 0
+    std::vector<double> logG(static_cast<size_t>(N) + 1, kNegativeInfinity);
+    logG[0] = 0.0;
+
+    // Свёртка по станциям: g_m(n) = g_{m-1}(n) + D_m * g_m(n-1).
+    // Обновление на месте: logG[n-1] уже содержит g_m(n-1), logG[n] - ещё g_{m-1}(n).
+    for (double demand : serviceDemands) {
+        if (demand <= 0.0) continue; // Станция без нагрузки не влияет на G(n)
+        const double logDemand = std::log(demand);
+        for (int n = 1; n <= N; ++n) {
+            logG[n] = LogAdd(logG[n], logDemand + logG[n - 1]);
+        }
+    }
+
+    return logG;
+}
+
+ClosedNetworkResult ConvolutionAlgorithm::Solve(const std::vector<double>& visitRatios,
+                                                const std::vector<double>& serviceTimes,
+                                                int population) {
+    ClosedNetworkResult result;
+    const size_t M = std::min(visitRatios.size(), serviceTimes.size());
+    const int N = std::max(population, 0);
+
+    result.population = N;
+    result.utilization.assign(M, 0.0);
+    result.throughput.assign(M, 0.0);
+    result.queueLength.assign(M, 0.0);
+    result.residenceTime.assign(M, 0.0);
+
+    std::vector<double> demands(M, 0.0);
+    for (size_t i = 0; i < M; ++i) {
+        demands[i] = std::max(0.0, visitRatios[i]) * std::max(0.0, serviceTimes[i]);
+    }
+
+    std::vector<double> logG = LogNormalizationConstants(demands, N);
+    result.logNormalizationConstant = logG[N];
+
+    if (N == 0 || logG[N] == kNegativeInfinity) {
+        return result;
+    }
+
+    // Отношения G(n-1)/G(n) = λ(n) - пропускная способность сети при n заявках
+    std::vector<double> ratio(static_cast<size_t>(N) + 1, 0.0);
+    for (int n = 1; n <= N; ++n) {
+        ratio[n] = std::exp(logG[n - 1] - logG[n]);
+    }
+
+    // K̄_i(n) = D_i * λ(n) * [1 + K̄_i(n-1)].
+    // Внутренний цикл идёт по станциям и не содержит зависимостей - векторизуется.
+    double* queue = result.queueLength.data();
+    const double* demand = demands.data();
+    for (int n = 1; n <= N; ++n) {
+        const double r = ratio[n];
+        for (size_t i = 0; i < M; ++i) {
+            queue[i] = demand[i] * r * (1.0 + queue[i]);
+        }
+    }
+
+    result.systemThroughput = ratio[N];
+    for (size_t i = 0; i < M; ++i) {
+        result.utilization[i] = demands[i] * result.systemThroughput;
+        result.throughput[i] = std::max(0.0, visitRatios[i]) * result.systemThroughput;
+        result.residenceTime[i] = (result.throughput[i] > 0.0)
+            ? result.queueLength[i] / result.throughput[i]
+            : 0.0;
+    }
+
+    return result;
+}
+
+ClosedNetworkResult ConvolutionAlgorithm::SolveForNodes(const std::vector<double>& nodeLoads,
+                                                        const std::vector<uint32_t>& nodeBuffers,
+                                                        double mu) {
+    if (nodeLoads.empty() || mu <= 0.0) {
+        return ClosedNetworkResult();
+    }
+    return SolveForNodes(nodeLoads, nodeBuffers, std::vector<double>(nodeLoads.size(), mu));
+}
+
+ClosedNetworkResult ConvolutionAlgorithm::SolveForNodes(const std::vector<double>& nodeLoads,
+                                                        const std::vector<uint32_t>& nodeBuffers,
+                                                        const std::vector<double>& serviceRates) {
+    if (nodeLoads.empty() || serviceRates.size() != nodeLoads.size()) {
+        return ClosedNetworkResult();
+    }
+    for (double rate : serviceRates) {
+        if (rate <= 0.0) return ClosedNetworkResult();
+    }
+
+    const double meanLoad = std::accumulate(nodeLoads.begin(), nodeLoads.end(), 0.0) / nodeLoads.size();
+
+    std::vector<double> visitRatios(nodeLoads.size(), 1.0);
+    if (meanLoad > 0.0) {
+        for (size_t i = 0; i < nodeLoads.size(); ++i) {
+            visitRatios[i] = nodeLoads[i] / meanLoad;
+        }
+    }
+
+    std::vector<double> serviceTimes(nodeLoads.size());
+    for (size_t i = 0; i < nodeLoads.size(); ++i) {
+        serviceTimes[i] = 1.0 / serviceRates[i];
+    }
+
+    // Число заявок в замкнутой сети - суммарная ёмкость буферов узлов
+    uint64_t totalBuffer = std::accumulate(nodeBuffers.begin(), nodeBuffers.end(), uint64_t{0});
+    int population = (totalBuffer > 0)
+        ? static_cast<int>(std::min<uint64_t>(totalBuffer, std::numeric_limits<int>::max()))
+        : static_cast<int>(nodeLoads.size());
+
+    return Solve(visitRatios, serviceTimes, population);
+}
+
+double ConvolutionAlgorithm::TailProbability(const std::vector<double>& logG,
+                                             double serviceDemand,
+                                             int population,
+                                             int k) {
+    if (k <= 0) return 1.0;
+    if (serviceDemand <= 0.0 || k > population) return 0.0;
+    if (population < 0 || static_cast<size_t>(population) >= logG.size()) return 0.0;
+    if (logG[population] == kNegativeInfinity) return 0.0;
+
+    double logTail = k * std::log(serviceDemand) + logG[population - k] - logG[population];
+    return std::min(1.0, std::exp(logTail));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Результат анализа замкнутой сети СМО (теорема Гордона-Ньюэлла).
+ * Все векторы индексируются номером станции.
+ */
+struct ClosedNetworkResult {
+    int population = 0;                 // Число заявок в сети N
+    double logNormalizationConstant = 0.0; // ln G(N)
+    double systemThroughput = 0.0;      // λ(N) = G(N-1) / G(N)
+    std::vector<double> utilization;    // U_i = D_i * λ(N)
+    std::vector<double> throughput;     // X_i = e_i * λ(N)
+    std::vector<double> queueLength;    // K̄_i(N)
+    std::vector<double> residenceTime;  // T̄_i(N) = K̄_i(N) / X_i
+};
+
+/**
+ * Алгоритм свёртки Бузена для замкнутой экспоненциальной сети
+ * с независимыми от нагрузки станциями.
+ *
+ * Нормировочные константы G(n), n = 0..N, хранятся в виде ln G(n),
+ * поэтому большие популяции не приводят к переполнению.
+ */
+class ConvolutionAlgorithm {
+public:
+    /**
+     * Вычисляет ln G(n) для n = 0..population.
+     * @param serviceDemands - D_i = e_i / μ_i для каждой станции
+     */
+    static std::vector<double> LogNormalizationConstants(const std::vector<double>& serviceDemands,
+                                                         int population);
+
+    /**
+     * Полный анализ сети: пропускные способности, загрузки и длины очередей станций.
+     * @param visitRatios - коэффициенты посещения e_i
+     * @param serviceTimes - средние времена обслуживания 1/μ_i
+     * @param population - число заявок N
+     */
+    static ClosedNetworkResult Solve(const std::vector<double>& visitRatios,
+                                     const std::vector<double>& serviceTimes,
+                                     int population);
+
+    /**
+     * Сеть, построенная по конфигурации узлов: e_i пропорциональны nodeLoads
+     * (нормированы на среднюю нагрузку), число заявок равно суммарной ёмкости
+     * буферов nodeBuffers.
+     */
+    static ClosedNetworkResult SolveForNodes(const std::vector<double>& nodeLoads,
+                                             const std::vector<uint32_t>& nodeBuffers,
+                                             double mu);
+
+    // То же для станций с разными интенсивностями обслуживания μ_i
+    static ClosedNetworkResult SolveForNodes(const std::vector<double>& nodeLoads,
+                                             const std::vector<uint32_t>& nodeBuffers,
+                                             const std::vector<double>& serviceRates);
+
+    /**
+     * Вероятность P(n_i >= k) = D_i^k * G(N-k) / G(N) для станции с требованием D_i.
+     */
+    static double TailProbability(const std::vector<double>& logG,
+                                  double serviceDemand,
+                                  int population,
+                                  int k);
+};
@@ -0,0 +1,280 @@
+#include "ctmc_solver.h"
+#include "../parallel/worker_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * Перебирает переходы из состояния s (цифры digits, занятые станции по каналам busy)
+ * и вызывает emit(t, rate) для каждого перехода в состояние t != s.
+ */
+template <typename Emit>
+void ForEachTransition(const FiniteBufferNetwork& network,
+                       const std::vector<size_t>& strides,
+                       size_t s,
+                       const std::vector<uint32_t>& digits,
+                       const std::vector<uint32_t>& busy,
+                       Emit emit) {
+    const size_t M = network.capacities.size();
+    const bool hasRouting = !network.routing.empty();
+
+    // Внешние поступления (на заполненную станцию - потеря, переход в себя)
+    for (size_t i = 0; i < M; ++i) {
+        if (network.arrivalRates[i] > 0.0 && digits[i] < network.capacities[i]) {
+            emit(s + strides[i], network.arrivalRates[i]);
+        }
+    }
+
+    // Завершение обслуживания: канал делится между занятыми станциями
+    for (size_t i = 0; i < M; ++i) {
+        if (digits[i] == 0) continue;
+        uint32_t channel = network.channels[i];
+        double rate = network.channelRates[channel] / static_cast<double>(busy[channel]);
+        size_t afterDeparture = s - strides[i];
+
+        double exitProbability = 1.0;
+        if (hasRouting) {
+            for (size_t j = 0; j < M; ++j) {
+                double p = network.routing[i * M + j];
+                if (p <= 0.0) continue;
+                exitProbability -= p;
+                if (j == i) continue; // Возврат на ту же станцию не меняет состояние
+                if (digits[j] < network.capacities[j]) {
+                    emit(afterDeparture + strides[j], rate * p);
+                } else {
+                    emit(afterDeparture, rate * p); // Пакет потерян на заполненной станции j
+                }
+            }
+        }
+        if (exitProbability > 1e-15) {
+            emit(afterDeparture, rate * exitProbability);
+        }
+    }
+}
+
+// Переход к следующему состоянию в смешанной системе счисления
+inline void Advance(std::vector<uint32_t>& digits,
+                    std::vector<uint32_t>& busy,
+                    const FiniteBufferNetwork& network) {
+    for (size_t i = 0; i < digits.size(); ++i) {
+        uint32_t channel = network.channels[i];
+        if (digits[i] < network.capacities[i]) {
+            if (digits[i] == 0) ++busy[channel];
+            ++digits[i];
+            return;
+        }
+        digits[i] = 0;
+        --busy[channel];
+    }
+}
+
+void Validate(const FiniteBufferNetwork& network) {
+    const size_t M = network.capacities.size();
+    if (M == 0) {
+        throw std::invalid_argument("CTMC network has no stations");
+    }
+    if (network.arrivalRates.size() != M || network.channels.size() != M) {
+        throw std::invalid_argument("CTMC network: arrivalRates/channels size mismatch");
+    }
+    if (!network.routing.empty() && network.routing.size() != M * M) {
+        throw std::invalid_argument("CTMC network: routing must be an M x M matrix");
+    }
+    for (size_t i = 0; i < M; ++i) {
+        if (network.capacities[i] == 0) {
+            throw std::invalid_argument("CTMC network: station " + std::to_string(i) + " has zero capacity");
+        }
+        if (network.channels[i] >= network.channelRates.size() ||
+            network.channelRates[network.channels[i]] <= 0.0) {
+            throw std::invalid_argument("CTMC network: station " + std::to_string(i) + " has no valid channel");
+        }
+    }
+}
+
+} // namespace
+
+size_t CtmcSolver::StateSpaceSize(const std::vector<uint32_t>& capacities) {
+    size_t states = 1;
+    for (uint32_t capacity : capacities) {
+        size_t radix = static_cast<size_t>(capacity) + 1;
+        if (states > std::numeric_limits<size_t>::max() / radix) {
+            return 0;
+        }
+        states *= radix;
+    }
+    return states;
+}
+
+CtmcNetworkResult CtmcSolver::Solve(const FiniteBufferNetwork& network,
+                                    const CtmcSolverOptions& options) {
+    Validate(network);
+
+    const size_t M = network.capacities.size();
+    const size_t C = network.channelRates.size();
+    const size_t maxStates = std::min<size_t>(options.maxStates, std::numeric_limits<uint32_t>::max());
+    const size_t numStates = StateSpaceSize(network.capacities);
+    if (numStates == 0 || numStates > maxStates) {
+        throw std::length_error("CTMC state space too large: limit is " + std::to_string(maxStates) + " states");
+    }
+
+    std::vector<size_t> strides(M, 1);
+    for (size_t i = 1; i < M; ++i) {
+        strides[i] = strides[i - 1] * (static_cast<size_t>(network.capacities[i - 1]) + 1);
+    }
+
+    // Стартовое приближение - произведение геометрических распределений станций
+    std::vector<double> logRho(M, 0.0);
+    std::vector<uint32_t> channelSize(C, 0);
+    for (size_t i = 0; i < M; ++i) ++channelSize[network.channels[i]];
+    for (size_t i = 0; i < M; ++i) {
+        double share = network.channelRates[network.channels[i]] / channelSize[network.channels[i]];
+        logRho[i] = std::log(std::max(network.arrivalRates[i], 1e-12) / share);
+    }
+
+    // ПРОХОД 1: число входящих переходов каждого состояния, выходные интенсивности
+    std::vector<uint32_t> rowStart(numStates + 1, 0);
+    std::vector<double> outRate(numStates, 0.0);
+    std::vector<double> pi(numStates, 0.0);
+    {
+        std::vector<uint32_t> digits(M, 0);
+        std::vector<uint32_t> busy(C, 0);
+        for (size_t s = 0; s < numStates; ++s) {
+            double logWeight = 0.0;
+            for (size_t i = 0; i < M; ++i) logWeight += digits[i] * logRho[i];
+            pi[s] = logWeight;
+
+            ForEachTransition(network, strides, s, digits, busy, [&](size_t t, double rate) {
+                ++rowStart[t + 1];
+                outRate[s] += rate;
+            });
+            Advance(digits, busy, network);
+        }
+    }
+    for (size_t s = 0; s < numStates; ++s) {
+        rowStart[s + 1] += rowStart[s];
+    }
+
+    // ПРОХОД 2: разреженная транспонированная матрица (входящие переходы по строкам)
+    const size_t numTransitions = rowStart[numStates];
+    std::vector<uint32_t> source(numTransitions);
+    std::vector<double> rate(numTransitions);
+    {
+        std::vector<uint32_t> fill(rowStart.begin(), rowStart.end() - 1);
+        std::vector<uint32_t> digits(M, 0);
+        std::vector<uint32_t> busy(C, 0);
+        for (size_t s = 0; s < numStates; ++s) {
+            ForEachTransition(network, strides, s, digits, busy, [&](size_t t, double r) {
+                uint32_t position = fill[t]++;
+                source[position] = static_cast<uint32_t>(s);
+                rate[position] = r;
+            });
+            Advance(digits, busy, network);
+        }
+    }
+
+    double maxLogWeight = *std::max_element(pi.begin(), pi.end());
+    double total = 0.0;
+    for (double& value : pi) {
+        value = std::exp(value - maxLogWeight);
+        total += value;
+    }
+    for (double& value : pi) value /= total;
+
+    // ИТЕРАЦИИ Гаусса-Зейделя / SOR: π_t = Σ_s π_s q_st / q_t
+    WorkerPool& pool = WorkerPool::Shared();
+    const size_t chunks = (options.numThreads == 0) ? pool.Size() : options.numThreads;
+    const double omega = options.relaxation;
+    std::vector<double> previous = pi;
+
+    CtmcNetworkResult result;
+    result.numStates = numStates;
+    result.numTransitions = numTransitions;
+
+    for (int iteration = 1; iteration <= options.maxIterations; ++iteration) {
+        pool.ParallelFor(numStates, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t) {
+                if (outRate[t] <= 0.0) continue;
+                double inflow = 0.0;
+                for (uint32_t k = rowStart[t]; k < rowStart[t + 1]; ++k) {
+                    size_t s = source[k];
+                    double value = (s >= begin && s < end) ? pi[s] : previous[s];
+                    inflow += value * rate[k];
+                }
+                double updated = (1.0 - omega) * pi[t] + omega * inflow / outRate[t];
+                pi[t] = std::max(0.0, updated);
+            }
+        }, chunks);
+
+        total = 0.0;
+        for (double value : pi) total += value;
+        if (total <= 0.0) {
+            throw std::runtime_error("CTMC iteration diverged");
+        }
+
+        double change = 0.0;
+        for (size_t s = 0; s < numStates; ++s) {
+            pi[s] /= total;
+            change += std::abs(pi[s] - previous[s]);
+        }
+        previous = pi;
+
+        result.iterations = iteration;
+        result.residual = change;
+        if (change < options.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    // ХАРАКТЕРИСТИКИ СТАНЦИЙ
+    std::vector<double> fullProbability(M, 0.0);
+    std::vector<double> routedOffered(M, 0.0);
+    std::vector<double> routedLost(M, 0.0);
+    result.throughput.assign(M, 0.0);
+    result.lossProbability.assign(M, 0.0);
+    result.avgSystemSize.assign(M, 0.0);
+    result.delay.assign(M, 0.0);
+    result.utilization.assign(M, 0.0);
+    {
+        std::vector<uint32_t> digits(M, 0);
+        std::vector<uint32_t> busy(C, 0);
+        for (size_t s = 0; s < numStates; ++s) {
+            const double p = pi[s];
+            for (size_t i = 0; i < M; ++i) {
+                if (digits[i] == 0) continue;
+                result.avgSystemSize[i] += p * digits[i];
+                result.utilization[i] += p;
+                if (digits[i] == network.capacities[i]) fullProbability[i] += p;
+
+                uint32_t channel = network.channels[i];
+                double departures = p * network.channelRates[channel] / static_cast<double>(busy[channel]);
+                result.throughput[i] += departures;
+
+                if (!network.routing.empty()) {
+                    for (size_t j = 0; j < M; ++j) {
+                        double routed = departures * network.routing[i * M + j];
+                        if (routed <= 0.0 || j == i) continue;
+                        routedOffered[j] += routed;
+                        if (digits[j] == network.capacities[j]) routedLost[j] += routed;
+                    }
+                }
+            }
+            Advance(digits, busy, network);
+        }
+    }
+
+    for (size_t i = 0; i < M; ++i) {
+        double offered = network.arrivalRates[i] + routedOffered[i];
+        double lost = network.arrivalRates[i] * fullProbability[i] + routedLost[i];
+        result.lossProbability[i] = (offered > 0.0) ? lost / offered : 0.0;
+        result.delay[i] = (result.throughput[i] > 0.0)
+            ? result.avgSystemSize[i] / result.throughput[i]
+            : 0.0;
+    }
+
+    return result;
+}
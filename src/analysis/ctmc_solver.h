@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Сеть станций с конечными буферами.
+ *
+ * - arrivalRates[i]: интенсивность внешнего пуассоновского потока на станцию i
+ * - capacities[i]: ёмкость станции K_i (очередь + сервер), K_i >= 1
+ * - channels[i]: номер канала, через который станция передаёт пакеты
+ * - channelRates[c]: интенсивность обслуживания канала c; занятые станции
+ *   одного канала делят её поровну (разделяемая среда WiFi / CSMA)
+ * - routing: матрица M×M (построчно), P_ij - вероятность перехода пакета
+ *   после обслуживания на станции i к станции j; остаток 1 - Σ_j P_ij
+ *   покидает сеть. Пустая матрица - все пакеты покидают сеть.
+ *   Пакет, пришедший на заполненную станцию, теряется.
+ */
+struct FiniteBufferNetwork {
+    std::vector<double> arrivalRates;
+    std::vector<uint32_t> capacities;
+    std::vector<uint32_t> channels;
+    std::vector<double> channelRates;
+    std::vector<double> routing;
+};
+
+struct CtmcSolverOptions {
+    double relaxation = 1.0;        // Параметр SOR ω (1.0 - Гаусс-Зейдель)
+    double tolerance = 1e-10;       // Порог ||π(k) - π(k-1)||_1
+    int maxIterations = 20000;
+    size_t numThreads = 0;          // 0 - все потоки общего пула
+    size_t maxStates = 4000000;     // Ограничение размера пространства состояний
+};
+
+/**
+ * Стационарные характеристики станций сети.
+ */
+struct CtmcNetworkResult {
+    size_t numStates = 0;
+    size_t numTransitions = 0;
+    int iterations = 0;
+    double residual = 0.0;
+    bool converged = false;
+    std::vector<double> throughput;      // Интенсивность обслуженных пакетов X_i
+    std::vector<double> lossProbability; // Доля потерянных пакетов среди поступивших
+    std::vector<double> avgSystemSize;   // L_i
+    std::vector<double> delay;           // T_i = L_i / X_i
+    std::vector<double> utilization;     // P(n_i > 0)
+};
+
+/**
+ * Точное решение сети с конечными буферами методом глобального баланса:
+ * строится разреженный генератор цепи Маркова по всему пространству состояний
+ * (n_1, ..., n_M) в смешанной системе счисления, стационарное распределение
+ * находится итерациями Гаусса-Зейделя / SOR.
+ *
+ * При нескольких потоках состояния делятся на блоки: внутри блока - Гаусс-Зейдель,
+ * между блоками используются значения предыдущей итерации (блочный Якоби).
+ */
+class CtmcSolver {
+public:
+    static CtmcNetworkResult Solve(const FiniteBufferNetwork& network,
+                                   const CtmcSolverOptions& options = CtmcSolverOptions());
+
+    /**
+     * Число состояний Π(K_i + 1); 0 при переполнении size_t.
+     */
+    static size_t StateSpaceSize(const std::vector<uint32_t>& capacities);
+};
@@ -0,0 +1,177 @@
+#include "dcf_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Размер блока значений n, решаемых одновременно
+const size_t kBlockSize = 256;
+
+// Число шагов бисекции: интервал (0, 1) сужается до 2^-60
+const int kBisectionSteps = 60;
+
+// Заголовки LLC/SNAP (8), IPv4 (20) и UDP (8) поверх полезной нагрузки UdpClient
+const uint32_t kLlcBytes = 8;
+const uint32_t kIpUdpBytes = 28;
+
+const uint32_t kAckBytes = 14;
+
+// Преамбула и заголовок кадров ACK (OFDM без HT/VHT полей)
+const double kLegacyOfdmPreamble = 20e-6;
+
+// Наибольшая базовая скорость, не превышающая скорость данных (для ACK)
+double AckRate(const DcfPhyParameters& phy) {
+    static const double kOfdmBasic[] = {6.0, 12.0, 24.0};
+    static const double kDsssBasic[] = {1.0, 2.0};
+    double rate = phy.ofdm ? kOfdmBasic[0] : kDsssBasic[0];
+    if (phy.ofdm) {
+        for (double basic : kOfdmBasic) if (basic <= phy.dataRateMbps) rate = basic;
+    } else {
+        for (double basic : kDsssBasic) if (basic <= phy.dataRateMbps) rate = basic;
+    }
+    return rate;
+}
+
+} // namespace
+
+DcfPhyParameters DcfModel::ForStandard(const std::string& standard, double dataRateMbps) {
+    DcfPhyParameters phy;
+    phy.standard = standard;
+
+    if (standard == "80211a") {
+        phy.dataRateMbps = 54.0;
+    } else if (standard == "80211b") {
+        phy.ofdm = false;
+        phy.slotTime = 20e-6;
+        phy.sifs = 10e-6;
+        phy.cwMin = 31;
+        phy.preambleTime = 192e-6; // Длинная преамбула DSSS
+        phy.dataRateMbps = 11.0;
+    } else if (standard == "80211g") {
+        phy.sifs = 10e-6;
+        phy.signalExtension = 6e-6;
+        phy.dataRateMbps = 54.0;
+    } else if (standard == "80211n") {
+        phy.preambleTime = 36e-6;  // Legacy + HT-SIG, HT-STF, HT-LTF
+        phy.dataRateMbps = 65.0;   // MCS 7, 1 поток, 20 МГц
+        phy.macOverheadBytes = 30;
+        phy.aifsn = 3;
+    } else if (standard == "80211ac") {
+        phy.preambleTime = 40e-6;  // Legacy + VHT-SIG-A, VHT-STF, VHT-LTF, VHT-SIG-B
+        phy.dataRateMbps = 78.0;   // MCS 8, 1 поток, 20 МГц
+        phy.macOverheadBytes = 30;
+        phy.aifsn = 3;
+    } else if (standard == "80211ax") {
+        phy.preambleTime = 44e-6;  // Legacy + RL-SIG, HE-SIG-A, HE-STF, HE-LTF
+        phy.dataRateMbps = 143.4;  // MCS 11, 1 поток, 20 МГц (символ HE считается как OFDM 4 мкс)
+        phy.macOverheadBytes = 30;
+        phy.aifsn = 3;
+    } else {
+        throw std::invalid_argument("Unsupported WiFi standard for DCF model: " + standard);
+    }
+
+    if (dataRateMbps > 0.0) {
+        phy.dataRateMbps = dataRateMbps;
+    }
+    phy.ackRateMbps = AckRate(phy);
+    return phy;
+}
+
+double DcfModel::FrameDuration(const DcfPhyParameters& phy, uint32_t bytes, double rateMbps, double preambleTime) {
+    if (rateMbps <= 0.0) return 0.0;
+    if (!phy.ofdm) {
+        return preambleTime + 8.0 * bytes / (rateMbps * 1e6);
+    }
+    // SERVICE (16 бит) + данные + хвост (6 бит), символы по 4 мкс
+    const double bitsPerSymbol = rateMbps * 4.0;
+    const double symbols = std::ceil((16.0 + 8.0 * bytes + 6.0) / bitsPerSymbol);
+    return preambleTime + symbols * 4e-6 + phy.signalExtension;
+}
+
+DcfSaturationResult DcfModel::Solve(const DcfPhyParameters& phy, uint32_t packetSize, uint32_t numStations) {
+    DcfSaturationResult result;
+    SolveBatch(phy, packetSize, &numStations, 1, &result);
+    return result;
+}
+
+std::vector<DcfSaturationResult> DcfModel::SolveBatch(const DcfPhyParameters& phy, uint32_t packetSize,
+                                                      const std::vector<uint32_t>& numStations) {
+    std::vector<DcfSaturationResult> out(numStations.size());
+    SolveBatch(phy, packetSize, numStations.data(), numStations.size(), out.data());
+    return out;
+}
+
+void DcfModel::SolveBatch(const DcfPhyParameters& phy, uint32_t packetSize,
+                          const uint32_t* numStations, size_t count, DcfSaturationResult* out) {
+    // Временные параметры не зависят от n
+    const uint32_t ipBytes = packetSize + kIpUdpBytes;
+    const double payloadBits = 8.0 * ipBytes;
+    const double dataTime = FrameDuration(phy, ipBytes + kLlcBytes + phy.macOverheadBytes,
+                                          phy.dataRateMbps, phy.preambleTime);
+    const double ackPreamble = phy.ofdm ? kLegacyOfdmPreamble : phy.preambleTime;
+    const double ackTime = FrameDuration(phy, kAckBytes, phy.ackRateMbps, ackPreamble);
+    const double successTime = dataTime + phy.sifs + ackTime + phy.Difs() + 2.0 * phy.propagationDelay;
+    const double collisionTime = successTime; // EIFS = SIFS + T_ack + DIFS
+    const double slot = phy.slotTime;
+
+    const double W = static_cast<double>(phy.cwMin) + 1.0;
+    int m = 0;
+    while ((static_cast<double>(phy.cwMin) + 1.0) * std::pow(2.0, m + 1) <= static_cast<double>(phy.cwMax) + 1.0) {
+        ++m;
+    }
+
+    double low[kBlockSize];
+    double high[kBlockSize];
+    double stations[kBlockSize];
+    double tau[kBlockSize];
+    double p[kBlockSize];
+
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        const size_t n = std::min(kBlockSize, count - offset);
+
+        for (size_t i = 0; i < n; ++i) {
+            stations[i] = static_cast<double>(std::max<uint32_t>(numStations[offset + i], 1));
+            low[i] = 0.0;
+            high[i] = 1.0;
+        }
+
+        // f(τ) = τ - τ_B(p(τ)) возрастает по τ: f(0) < 0, f(1) > 0
+        for (int step = 0; step < kBisectionSteps; ++step) {
+            for (size_t i = 0; i < n; ++i) {
+                const double t = 0.5 * (low[i] + high[i]);
+                const double collision = 1.0 - std::exp((stations[i] - 1.0) * std::log1p(-t));
+                // Σ_{k=0}^{m-1} (2p)^k по схеме Горнера
+                double series = 0.0;
+                for (int k = 0; k < m; ++k) {
+                    series = 1.0 + 2.0 * collision * series;
+                }
+                const double target = 2.0 / (1.0 + W + collision * W * series);
+                const bool above = t > target;
+                high[i] = above ? t : high[i];
+                low[i] = above ? low[i] : t;
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            tau[i] = 0.5 * (low[i] + high[i]);
+            p[i] = 1.0 - std::exp((stations[i] - 1.0) * std::log1p(-tau[i]));
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const double idle = std::exp(stations[i] * std::log1p(-tau[i]));  // (1 - τ)^n
+            const double transmit = 1.0 - idle;                                 // P_tr
+            const double success = stations[i] * tau[i] * (1.0 - p[i]);         // P_tr P_s
+            const double slotLength = idle * slot + success * successTime + (transmit - success) * collisionTime;
+            const double throughput = success * payloadBits / slotLength;       // бит/с
+
+            DcfSaturationResult& r = out[offset + i];
+            r.numStations = numStations[offset + i];
+            r.tau = tau[i];
+            r.collisionProbability = p[i];
+            r.throughputMbps = throughput / 1e6;
+            r.serviceTime = (throughput > 0.0) ? stations[i] * payloadBits / throughput : 0.0;
+        }
+    }
+}
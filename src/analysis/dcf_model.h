@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Параметры PHY/MAC стандарта 802.11 для модели DCF (все времена - в секундах).
+ * Для 802.11n/ac - один пространственный поток, канал 20 МГц, длинный GI,
+ * без агрегации кадров.
+ */
+struct DcfPhyParameters {
+    std::string standard;
+    double slotTime = 9e-6;
+    double sifs = 16e-6;
+    double propagationDelay = 1e-6;
+    uint32_t cwMin = 15;
+    uint32_t cwMax = 1023;
+    double dataRateMbps = 54.0;         // Скорость кадров данных
+    double ackRateMbps = 24.0;          // Базовая скорость ACK
+    bool ofdm = true;                   // OFDM (a/g/n/ac) или DSSS (b)
+    double preambleTime = 20e-6;        // Преамбула + заголовок PHY
+    double signalExtension = 0.0;       // 6 мкс для 802.11g
+    uint32_t macOverheadBytes = 28;     // Заголовок MAC + FCS (QoS - 30)
+    uint32_t aifsn = 2;                 // 2 - DIFS, 3 - AIFS[AC_BE] при QoS
+
+    double Difs() const { return sifs + aifsn * slotTime; }
+};
+
+/**
+ * Решение Бианки для насыщенной сети из n станций.
+ * Пропускная способность - на уровне IP (пакет UDP + заголовки UDP/IP),
+ * как её считает FlowMonitor.
+ */
+struct DcfSaturationResult {
+    uint32_t numStations = 0;
+    double tau = 0.0;                   // Вероятность передачи в слоте τ
+    double collisionProbability = 0.0;  // p = 1 - (1 - τ)^(n-1)
+    double throughputMbps = 0.0;        // Суммарная пропускная способность S
+    double serviceTime = 0.0;           // Среднее время обслуживания пакета станцией n L / S
+};
+
+/**
+ * Модель DCF 802.11 (Бианки, 2000): неподвижная точка
+ *   τ = 2 / (1 + W + p W Σ_{k=0}^{m-1} (2p)^k),  p = 1 - (1 - τ)^(n-1),
+ * где W = CWmin + 1, CWmax + 1 = 2^m W (форма без особенности при p = 1/2),
+ * и пропускная способность
+ *   S = P_s P_tr L / ((1 - P_tr) σ + P_tr P_s T_s + P_tr (1 - P_s) T_c).
+ * Базовый доступ: T_s = T_data + SIFS + T_ack + DIFS, после коллизии станции
+ * ждут EIFS, поэтому T_c = T_data + SIFS + T_ack + DIFS (как в ns-3).
+ */
+class DcfModel {
+public:
+    // Параметры стандарта ("80211a", "80211b", "80211g", "80211n", "80211ac");
+    // dataRateMbps <= 0 - наибольшая скорость стандарта (IdealWifiManager без замираний)
+    static DcfPhyParameters ForStandard(const std::string& standard, double dataRateMbps = 0.0);
+
+    static DcfSaturationResult Solve(const DcfPhyParameters& phy, uint32_t packetSize, uint32_t numStations);
+
+    /**
+     * Решения для массива numStations[0..count) одним вызовом: неподвижная точка
+     * ищется бисекцией с фиксированным числом шагов одновременно для блока
+     * значений n (циклы без ветвлений векторизуются).
+     */
+    static void SolveBatch(const DcfPhyParameters& phy, uint32_t packetSize,
+                           const uint32_t* numStations, size_t count, DcfSaturationResult* out);
+
+    static std::vector<DcfSaturationResult> SolveBatch(const DcfPhyParameters& phy, uint32_t packetSize,
+                                                       const std::vector<uint32_t>& numStations);
+
+    // Длительность передачи кадра из bytes байт на скорости rateMbps с преамбулой preambleTime
+    static double FrameDuration(const DcfPhyParameters& phy, uint32_t bytes, double rateMbps, double preambleTime);
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cmath>
+
+/**
+ * Дуальное число a + b ε (ε² = 0) для автоматического дифференцирования
+ * вперёд: в value - значение функции, в derivative - производная по
+ * параметру, для которого задано Variable(x). Формулы, шаблонные по типу
+ * скаляра (см. QueueingModels::MM1K_*), с T = Dual дают точную производную
+ * за один проход вместе со значением.
+ */
+struct Dual {
+    double value = 0.0;
+    double derivative = 0.0;
+
+    Dual() = default;
+    Dual(double v) : value(v) {}  // Константа (неявное преобразование для смешанной арифметики)
+    Dual(double v, double d) : value(v), derivative(d) {}
+
+    static Dual Variable(double v) { return Dual(v, 1.0); }
+
+    Dual& operator+=(const Dual& other) { value += other.value; derivative += other.derivative; return *this; }
+    Dual& operator-=(const Dual& other) { value -= other.value; derivative -= other.derivative; return *this; }
+    Dual& operator*=(const Dual& other) {
+        derivative = derivative * other.value + value * other.derivative;
+        value *= other.value;
+        return *this;
+    }
+    Dual& operator/=(const Dual& other) {
+        derivative = (derivative * other.value - value * other.derivative) / (other.value * other.value);
+        value /= other.value;
+        return *this;
+    }
+};
+
+inline Dual operator+(Dual a, const Dual& b) { return a += b; }
+inline Dual operator-(Dual a, const Dual& b) { return a -= b; }
+inline Dual operator*(Dual a, const Dual& b) { return a *= b; }
+inline Dual operator/(Dual a, const Dual& b) { return a /= b; }
+inline Dual operator-(const Dual& a) { return Dual(-a.value, -a.derivative); }
+
+// Сравнения - по значению (ветвления формул не зависят от производной)
+inline bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+inline bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+inline bool operator<=(const Dual& a, const Dual& b) { return a.value <= b.value; }
+inline bool operator>=(const Dual& a, const Dual& b) { return a.value >= b.value; }
+
+inline Dual exp(const Dual& a) {
+    const double e = std::exp(a.value);
+    return Dual(e, e * a.derivative);
+}
+
+inline Dual expm1(const Dual& a) {
+    return Dual(std::expm1(a.value), std::exp(a.value) * a.derivative);
+}
+
+inline Dual log(const Dual& a) {
+    return Dual(std::log(a.value), a.derivative / a.value);
+}
+
+inline Dual sqrt(const Dual& a) {
+    const double s = std::sqrt(a.value);
+    return Dual(s, 0.5 * a.derivative / s);
+}
+
+// Значение скаляра для ветвлений в шаблонных формулах
+inline double ValueOf(double x) { return x; }
+inline double ValueOf(const Dual& x) { return x.value; }
@@ -0,0 +1,216 @@
+#include "hierarchical_model.h"
+#include "queueing_models.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace {
+
+// Заголовки IPv4 + UDP поверх полезной нагрузки UdpClient
+const uint32_t kIpUdpBytes = 28;
+// Ethernet DIX: заголовок 14 + FCS 4
+const uint32_t kEthernetBytes = 18;
+// Заголовок PPP
+const uint32_t kPppBytes = 2;
+
+const int kMaxIterations = 200;
+const int kBisectionSteps = 50;
+const double kTolerance = 1e-10;
+
+// M/M/1/K: пропускная способность и задержка (μ <= 0 - станция не обслуживает)
+void StationMetrics(double arrival, double mu, uint32_t capacity, double& throughput, double& delay) {
+    throughput = 0.0;
+    delay = 0.0;
+    if (arrival <= 0.0 || mu <= 0.0) return;
+    const int K = static_cast<int>(std::max<uint32_t>(capacity, 1));
+    throughput = QueueingModels::Calculate_MM1K_Throughput(arrival, mu, K);
+    delay = QueueingModels::Calculate_MM1K_Delay(arrival, mu, K);
+}
+
+} // namespace
+
+GroupModelResult HierarchicalGroupModel::Evaluate(const GroupNetworkParameters& parameters) {
+    GroupModelResult result;
+    const size_t numNodes = std::min({parameters.nodeLoads.size(), parameters.dataRatesMbps.size(),
+                                      parameters.buffers.size()});
+    if (numNodes == 0) return result;
+
+    const size_t groups = std::max<size_t>(1, std::min<size_t>(parameters.numGroups, numNodes));
+    const double ipBits = 8.0 * (parameters.packetSize + kIpUdpBytes);
+    const double lanDelay = parameters.linkDelayMs / 1000.0;
+    const double backboneDelay = (parameters.backbone.delayMs >= 0.0)
+        ? parameters.backbone.delayMs / 1000.0
+        : lanDelay / 2.0;
+
+    double offered = 0.0;
+    double delivered = 0.0;
+    double weightedDelay = 0.0;
+
+    // === CSMA сети групп ===
+    result.lanUtilization.assign(groups, 0.0);
+    size_t first = 0;
+    std::vector<size_t> masters(groups, 0);
+    for (size_t g = 0; g < groups; ++g) {
+        const size_t groupSize = numNodes / groups + ((g < numNodes % groups) ? 1 : 0);
+        masters[g] = first;
+
+        // Передают обычные узлы, если в группе есть хотя бы два обычных узла.
+        // Узлы с одинаковыми (λ_i, s_i, K_i) объединяются в классы с кратностью count:
+        // у однородной группы неподвижная точка - одно уравнение
+        std::vector<double> arrival, busyTime, count;
+        std::vector<uint32_t> capacity;
+        std::map<std::tuple<double, double, uint32_t>, size_t> classes;
+        for (size_t k = 1; groupSize > 2 && k < groupSize; ++k) {
+            const size_t node = first + k;
+            const double a = std::max(0.0, parameters.lambda * parameters.nodeLoads[node]);
+            const double rate = parameters.dataRatesMbps[node] * 1e6;
+            const double busy = (rate > 0.0)
+                ? 8.0 * (parameters.packetSize + kIpUdpBytes + kEthernetBytes) / rate + lanDelay
+                : 0.0;
+            auto inserted = classes.emplace(std::make_tuple(a, busy, parameters.buffers[node]), arrival.size());
+            if (inserted.second) {
+                arrival.push_back(a);
+                busyTime.push_back(busy);
+                capacity.push_back(parameters.buffers[node]);
+                count.push_back(0.0);
+            }
+            count[inserted.first->second] += 1.0;
+        }
+        first += groupSize;
+
+        const size_t n = arrival.size();
+        std::vector<double> throughput(arrival), mu(n, 0.0);
+
+        // Гаусс-Зейдель по классам: для класса k при фиксированных остальных
+        // x = X(a_k, μ_k(x)) решается бисекцией (правая часть убывает по x)
+        double occupancy = 0.0;
+        for (size_t k = 0; k < n; ++k) occupancy += count[k] * throughput[k] * busyTime[k];
+
+        int iteration = 0;
+        while (n > 0 && iteration < kMaxIterations) {
+            ++iteration;
+            double maxDelta = 0.0;
+            for (size_t k = 0; k < n; ++k) {
+                if (busyTime[k] <= 0.0) continue;
+                const double others = occupancy - count[k] * throughput[k] * busyTime[k];
+                auto serviceRate = [&](double x) {
+                    return std::max(1e-9, 1.0 - others - (count[k] - 1.0) * x * busyTime[k]) / busyTime[k];
+                };
+                double low = 0.0;
+                double high = arrival[k];
+                for (int step = 0; step < kBisectionSteps; ++step) {
+                    const double x = 0.5 * (low + high);
+                    double served, delay;
+                    StationMetrics(arrival[k], serviceRate(x), capacity[k], served, delay);
+                    (x > served ? high : low) = x;
+                }
+                const double next = 0.5 * (low + high);
+                mu[k] = serviceRate(next);
+                maxDelta = std::max(maxDelta, std::abs(next - throughput[k]));
+                occupancy = others + count[k] * next * busyTime[k];
+                throughput[k] = next;
+            }
+            if (maxDelta < kTolerance * std::max(1.0, *std::max_element(arrival.begin(), arrival.end()))) {
+                break;
+            }
+        }
+        if (iteration >= kMaxIterations) {
+            result.converged = false;
+        }
+        result.iterations = std::max(result.iterations, iteration);
+
+        for (size_t k = 0; k < n; ++k) {
+            double x, delay;
+            StationMetrics(arrival[k], mu[k], capacity[k], x, delay);
+            offered += count[k] * arrival[k];
+            delivered += count[k] * x;
+            weightedDelay += count[k] * x * (delay + lanDelay);
+            result.lanUtilization[g] += count[k] * x * busyTime[k];
+            result.lanThroughputMbps += count[k] * x * ipBits / 1e6;
+        }
+    }
+
+    // === Магистраль главных узлов ===
+    if (groups > 1) {
+        const BackboneParameters backbone = BackboneTopology::Resolve(parameters.backbone, static_cast<uint32_t>(groups));
+        const size_t numDirections = 2 * backbone.links.size();
+
+        // Пути главных узлов к следующей группе и предлагаемые потоки направлений
+        std::vector<std::vector<uint32_t>> paths(groups);
+        std::vector<double> directionArrival(numDirections, 0.0);
+        for (size_t g = 0; g < groups; ++g) {
+            paths[g] = BackboneTopology::Path(backbone.links, static_cast<uint32_t>(groups),
+                                              static_cast<uint32_t>(g), static_cast<uint32_t>((g + 1) % groups));
+            const double arrival = std::max(0.0, parameters.lambda * parameters.nodeLoads[masters[g]]);
+            for (uint32_t direction : paths[g]) directionArrival[direction] += arrival;
+        }
+
+        // Каждое направление - M/M/1/K на скорости передающего главного узла x множитель
+        std::vector<double> directionPass(numDirections, 1.0), directionDelay(numDirections, 0.0);
+        result.backboneUtilization.assign(numDirections, 0.0);
+        for (size_t d = 0; d < numDirections; ++d) {
+            const BackboneLink& link = backbone.links[d / 2];
+            const size_t master = masters[(d % 2 == 0) ? link.a : link.b];
+            const double rate = backbone.rateFactors[d] * parameters.dataRatesMbps[master] * 1e6;
+            if (rate <= 0.0 || directionArrival[d] <= 0.0) continue;
+            const double mu = rate / (8.0 * (parameters.packetSize + kIpUdpBytes + kPppBytes));
+
+            double x, delay;
+            StationMetrics(directionArrival[d], mu, parameters.buffers[master], x, delay);
+            directionPass[d] = x / directionArrival[d];
+            directionDelay[d] = delay + backboneDelay;
+            result.backboneUtilization[d] = x / mu;
+        }
+
+        for (size_t g = 0; g < groups; ++g) {
+            const double arrival = std::max(0.0, parameters.lambda * parameters.nodeLoads[masters[g]]);
+            if (arrival <= 0.0 || paths[g].empty()) continue;
+            double pass = 1.0, delay = 0.0;
+            for (uint32_t direction : paths[g]) {
+                pass *= directionPass[direction];
+                delay += directionDelay[direction];
+            }
+            const double x = arrival * pass;
+            offered += arrival;
+            delivered += x;
+            weightedDelay += x * delay;
+            result.backboneThroughputMbps += x * ipBits / 1e6;
+        }
+    }
+
+    result.throughputMbps = result.lanThroughputMbps + result.backboneThroughputMbps;
+    result.delay = (delivered > 0.0) ? weightedDelay / delivered : 0.0;
+    result.lossRate = (offered > 0.0) ? 1.0 - delivered / offered : 0.0;
+    return result;
+}
+
+std::vector<GroupModelResult> HierarchicalGroupModel::EvaluateGrid(double lambda,
+                                                                   double nodeLoad,
+                                                                   double dataRateMbps,
+                                                                   uint32_t buffer,
+                                                                   uint32_t packetSize,
+                                                                   double linkDelayMs,
+                                                                   const std::vector<uint32_t>& groupCounts,
+                                                                   const std::vector<uint32_t>& groupSizes) {
+    std::vector<GroupModelResult> results;
+    results.reserve(groupCounts.size() * groupSizes.size());
+
+    GroupNetworkParameters parameters;
+    parameters.lambda = lambda;
+    parameters.packetSize = packetSize;
+    parameters.linkDelayMs = linkDelayMs;
+
+    for (uint32_t groups : groupCounts) {
+        for (uint32_t size : groupSizes) {
+            const size_t numNodes = static_cast<size_t>(groups) * size;
+            parameters.numGroups = groups;
+            parameters.nodeLoads.assign(numNodes, nodeLoad);
+            parameters.dataRatesMbps.assign(numNodes, dataRateMbps);
+            parameters.buffers.assign(numNodes, buffer);
+            results.push_back(Evaluate(parameters));
+        }
+    }
+    return results;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../simulation/backbone_topology.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Параметры групповой сети в том виде, в каком её строит GroupSimulator:
+ * узлы делятся на numGroups групп почти поровну, первый узел группы - главный.
+ * Обычные узлы передают внутри своей CSMA сети, главные - главному узлу
+ * следующей группы по кратчайшему пути магистрали PointToPoint backbone.
+ */
+struct GroupNetworkParameters {
+    double lambda = 0.0;
+    std::vector<double> nodeLoads;
+    std::vector<double> dataRatesMbps;   // Скорость CSMA устройства узла
+    std::vector<uint32_t> buffers;       // Ёмкость очереди узла K_i
+    uint32_t numGroups = 1;
+    uint32_t packetSize = 0;             // Полезная нагрузка UDP, байт
+    double linkDelayMs = 0.0;            // Задержка CSMA канала
+    BackboneParameters backbone;         // По умолчанию - кольцо на удвоенной скорости, задержка - половина CSMA
+};
+
+struct GroupModelResult {
+    double throughputMbps = 0.0;         // Уровень IP, как в FlowMonitor
+    double lanThroughputMbps = 0.0;
+    double backboneThroughputMbps = 0.0;
+    double delay = 0.0;                  // Средняя задержка доставленного пакета, с
+    double lossRate = 0.0;
+    std::vector<double> lanUtilization;      // Доля занятости канала CSMA группы
+    std::vector<double> backboneUtilization; // Загрузка направления связи: [2l] - от a к b, [2l + 1] - от b к a
+    int iterations = 0;                  // Наибольшее число итераций по сетям CSMA
+    bool converged = true;               // false - неподвижная точка не достигнута за kMaxIterations
+};
+
+/**
+ * Декомпозиционная модель групповой сети.
+ *
+ * CSMA сеть группы: каждый передающий узел - M/M/1/K, канал которого свободен
+ * от чужих передач с вероятностью 1 - Σ_{j≠i} X_j s_j, т.е. μ_i = (1 - Σ_{j≠i} X_j s_j) / s_i,
+ * где s_i - время занятия канала кадром (Ethernet DIX + задержка канала),
+ * X_j = λ_j (1 - p_j). Узлы с одинаковыми параметрами объединяются в классы;
+ * неподвижная точка ищется Гауссом-Зейделем по классам (для класса - бисекция).
+ * При насыщении канала (Σ X_j s_j -> 1) суммарные величины определяются быстро,
+ * а распределение пропускной способности между разными классами сходится медленно.
+ *
+ * Магистраль: каждое направление связи - M/M/1/K со временем обслуживания
+ * кадра PPP на скорости направления; поток направления - сумма потоков главных
+ * узлов, чей кратчайший путь к следующей группе проходит по нему. Доставка
+ * потока - произведение (1 - p) станций пути, задержка - сумма их задержек.
+ */
+class HierarchicalGroupModel {
+public:
+    static GroupModelResult Evaluate(const GroupNetworkParameters& parameters);
+
+    /**
+     * Сетка однородных сетей numGroups x nodesPerGroup (нагрузка nodeLoad,
+     * скорость dataRateMbps и буфер buffer у всех узлов). Результат - построчно
+     * по groupCounts, внутри строки - по groupSizes.
+     */
+    static std::vector<GroupModelResult> EvaluateGrid(double lambda,
+                                                      double nodeLoad,
+                                                      double dataRateMbps,
+                                                      uint32_t buffer,
+                                                      uint32_t packetSize,
+                                                      double linkDelayMs,
+                                                      const std::vector<uint32_t>& groupCounts,
+                                                      const std::vector<uint32_t>& groupSizes);
+};
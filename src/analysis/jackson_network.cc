@@ -0,0 +1,281 @@
+#include "jackson_network.h"
+#include "queueing_models.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace {
+
+// Вероятность потери станции: p_K для M/M/1/K, 0 для M/M/1
+double StationLoss(double arrival, double mu, uint32_t capacity) {
+    if (capacity == 0 || arrival <= 0.0 || mu <= 0.0) return 0.0;
+    double throughput = QueueingModels::Calculate_MM1K_Throughput(arrival, mu, static_cast<int>(capacity));
+    return std::min(1.0, std::max(0.0, 1.0 - throughput / arrival));
+}
+
+/**
+ * Накопитель потоков: внешние поступления и переходы между станциями.
+ * Переходы одной станции хранятся в std::map (станция -> интенсивность),
+ * в CSR переводятся нормировкой на суммарный поток через станцию.
+ */
+class FlowAccumulator {
+public:
+    explicit FlowAccumulator(size_t numStations)
+        : m_external(numStations, 0.0),
+          m_through(numStations, 0.0),
+          m_transitions(numStations) {}
+
+    // Поток интенсивности rate по последовательности станций path
+    void AddFlow(const std::vector<uint32_t>& path, double rate) {
+        if (path.empty() || rate <= 0.0) return;
+        m_external[path[0]] += rate;
+        for (size_t k = 0; k < path.size(); ++k) {
+            m_through[path[k]] += rate;
+            if (k + 1 < path.size()) {
+                m_transitions[path[k]][path[k + 1]] += rate;
+            }
+        }
+    }
+
+    void Finish(JacksonNetwork& network) const {
+        const size_t M = m_external.size();
+        network.externalArrivals = m_external;
+        network.rowOffsets.assign(M + 1, 0);
+        network.columns.clear();
+        network.probabilities.clear();
+        for (size_t i = 0; i < M; ++i) {
+            for (const auto& transition : m_transitions[i]) {
+                network.columns.push_back(transition.first);
+                network.probabilities.push_back(transition.second / m_through[i]);
+            }
+            network.rowOffsets[i + 1] = network.columns.size();
+        }
+    }
+
+private:
+    std::vector<double> m_external;
+    std::vector<double> m_through;
+    std::vector<std::map<uint32_t, double>> m_transitions;
+};
+
+uint32_t BufferOf(const std::vector<uint32_t>& nodeBuffers, size_t node, int defaultBufferSize) {
+    return (node < nodeBuffers.size() && nodeBuffers[node] > 0)
+        ? nodeBuffers[node]
+        : static_cast<uint32_t>(std::max(defaultBufferSize, 1));
+}
+
+} // namespace
+
+JacksonNetworkResult JacksonSolver::Solve(const JacksonNetwork& network,
+                                          double tolerance,
+                                          int maxIterations) {
+    JacksonNetworkResult result;
+    const size_t M = network.externalArrivals.size();
+    if (M == 0 || network.serviceRates.size() != M) {
+        return result;
+    }
+    const bool hasRouting = network.rowOffsets.size() == M + 1;
+
+    auto capacityOf = [&network](size_t i) -> uint32_t {
+        return (i < network.capacities.size()) ? network.capacities[i] : 0u;
+    };
+
+    // Транспонированная матрица: для станции j - входящие переходы (i, P_ij)
+    std::vector<size_t> inOffsets(M + 1, 0);
+    std::vector<uint32_t> inSources;
+    std::vector<double> inProbabilities;
+    if (hasRouting) {
+        for (size_t e = 0; e < network.columns.size(); ++e) {
+            ++inOffsets[network.columns[e] + 1];
+        }
+        for (size_t j = 0; j < M; ++j) {
+            inOffsets[j + 1] += inOffsets[j];
+        }
+        inSources.resize(network.columns.size());
+        inProbabilities.resize(network.columns.size());
+        std::vector<size_t> fill(inOffsets.begin(), inOffsets.end() - 1);
+        for (size_t i = 0; i < M; ++i) {
+            for (size_t e = network.rowOffsets[i]; e < network.rowOffsets[i + 1]; ++e) {
+                size_t slot = fill[network.columns[e]]++;
+                inSources[slot] = static_cast<uint32_t>(i);
+                inProbabilities[slot] = network.probabilities[e];
+            }
+        }
+    }
+
+    // Уравнения трафика: Гаусс-Зейдель, потери станций M/M/1/K - по текущему λ
+    result.arrivalRate = network.externalArrivals;
+    result.lossProbability.assign(M, 0.0);
+    for (size_t j = 0; j < M; ++j) {
+        result.lossProbability[j] = StationLoss(result.arrivalRate[j], network.serviceRates[j], capacityOf(j));
+    }
+
+    if (!hasRouting || network.columns.empty()) {
+        result.converged = true;
+    } else {
+        for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+            double maxDelta = 0.0;
+            double maxRate = 0.0;
+            for (size_t j = 0; j < M; ++j) {
+                double arrival = network.externalArrivals[j];
+                for (size_t e = inOffsets[j]; e < inOffsets[j + 1]; ++e) {
+                    uint32_t i = inSources[e];
+                    arrival += result.arrivalRate[i] * (1.0 - result.lossProbability[i]) * inProbabilities[e];
+                }
+                maxDelta = std::max(maxDelta, std::abs(arrival - result.arrivalRate[j]));
+                maxRate = std::max(maxRate, arrival);
+                result.arrivalRate[j] = arrival;
+                result.lossProbability[j] = StationLoss(arrival, network.serviceRates[j], capacityOf(j));
+            }
+            result.iterations = iteration;
+            result.residual = maxDelta / std::max(1.0, maxRate);
+            if (result.residual < tolerance) {
+                result.converged = true;
+                break;
+            }
+        }
+    }
+
+    // Характеристики станций
+    const double infinity = std::numeric_limits<double>::infinity();
+    result.throughput.assign(M, 0.0);
+    result.utilization.assign(M, 0.0);
+    result.avgSystemSize.assign(M, 0.0);
+    result.delay.assign(M, 0.0);
+    double totalSystemSize = 0.0;
+    for (size_t i = 0; i < M; ++i) {
+        const double arrival = result.arrivalRate[i];
+        const double mu = network.serviceRates[i];
+        const uint32_t capacity = capacityOf(i);
+        if (arrival <= 0.0 || mu <= 0.0) continue;
+
+        if (capacity > 0) {
+            const int K = static_cast<int>(capacity);
+            result.throughput[i] = QueueingModels::Calculate_MM1K_Throughput(arrival, mu, K);
+            result.avgSystemSize[i] = QueueingModels::Calculate_MM1K_AvgSystemSize(arrival, mu, K);
+            result.delay[i] = QueueingModels::Calculate_MM1K_Delay(arrival, mu, K);
+        } else if (arrival < mu) {
+            double rho = arrival / mu;
+            result.throughput[i] = arrival;
+            result.avgSystemSize[i] = rho / (1.0 - rho);
+            result.delay[i] = 1.0 / (mu - arrival);
+        } else {
+            result.stable = false;
+            result.throughput[i] = mu;
+            result.avgSystemSize[i] = infinity;
+            result.delay[i] = infinity;
+        }
+        result.utilization[i] = result.throughput[i] / mu;
+        totalSystemSize += result.avgSystemSize[i];
+
+        double exitProbability = 1.0;
+        if (hasRouting) {
+            for (size_t e = network.rowOffsets[i]; e < network.rowOffsets[i + 1]; ++e) {
+                exitProbability -= network.probabilities[e];
+            }
+        }
+        result.deliveredThroughput += result.throughput[i] * std::max(0.0, exitProbability);
+    }
+
+    if (!result.stable) {
+        result.meanSojournTime = infinity;
+    } else if (result.deliveredThroughput > 0.0) {
+        result.meanSojournTime = totalSystemSize / result.deliveredThroughput;
+    }
+    return result;
+}
+
+JacksonNetwork JacksonSolver::BuildGroupNetwork(double lambda,
+                                                const std::vector<double>& nodeLoads,
+                                                const std::vector<double>& serviceRates,
+                                                const std::vector<uint32_t>& nodeBuffers,
+                                                int defaultBufferSize,
+                                                int numGroups,
+                                                const BackboneParameters& backboneParameters) {
+    JacksonNetwork network;
+    const size_t numNodes = std::min(nodeLoads.size(), serviceRates.size());
+    if (numNodes == 0) return network;
+
+    // Разбиение на группы и магистраль - как в GroupSimulator
+    const size_t groups = std::max<size_t>(1, std::min(static_cast<size_t>(std::max(numGroups, 1)), numNodes));
+    std::vector<size_t> groupSizes(groups, numNodes / groups);
+    for (size_t g = 0; g < numNodes % groups; ++g) {
+        ++groupSizes[g];
+    }
+    std::vector<size_t> masters(groups, 0);
+    for (size_t g = 1; g < groups; ++g) {
+        masters[g] = masters[g - 1] + groupSizes[g - 1];
+    }
+    const BackboneParameters backbone = BackboneTopology::Resolve(backboneParameters, static_cast<uint32_t>(groups));
+    const size_t numLinks = backbone.links.size();
+
+    // Станции: 0..N-1 - CSMA узлов, N + 2l - связь l от группы a к b, N + 2l + 1 - обратно
+    const size_t numStations = numNodes + 2 * numLinks;
+    network.serviceRates.resize(numStations);
+    network.capacities.resize(numStations);
+    for (size_t i = 0; i < numNodes; ++i) {
+        network.serviceRates[i] = serviceRates[i];
+        network.capacities[i] = BufferOf(nodeBuffers, i, defaultBufferSize);
+    }
+    for (size_t l = 0; l < numLinks; ++l) {
+        size_t a = masters[backbone.links[l].a];
+        size_t b = masters[backbone.links[l].b];
+        network.serviceRates[numNodes + 2 * l] = backbone.rateFactors[2 * l] * serviceRates[a];
+        network.capacities[numNodes + 2 * l] = BufferOf(nodeBuffers, a, defaultBufferSize);
+        network.serviceRates[numNodes + 2 * l + 1] = backbone.rateFactors[2 * l + 1] * serviceRates[b];
+        network.capacities[numNodes + 2 * l + 1] = BufferOf(nodeBuffers, b, defaultBufferSize);
+    }
+
+    // Станции магистрали на кратчайшем пути от главного узла группы from к главному узлу группы to
+    auto backbonePath = [&](size_t from, size_t to, std::vector<uint32_t>& path) {
+        for (uint32_t direction : BackboneTopology::Path(backbone.links, static_cast<uint32_t>(groups),
+                                                         static_cast<uint32_t>(from), static_cast<uint32_t>(to))) {
+            path.push_back(static_cast<uint32_t>(numNodes + direction));
+        }
+    };
+
+    FlowAccumulator flows(numStations);
+    std::vector<uint32_t> path;
+    for (size_t g = 0; g < groups; ++g) {
+        for (size_t k = 0; k < groupSizes[g]; ++k) {
+            const size_t node = masters[g] + k;
+            const double rate = std::max(0.0, lambda * nodeLoads[node]);
+            path.clear();
+            if (k == 0) {
+                // Главный узел - главному узлу следующей группы
+                if (groups < 2) continue;
+                backbonePath(g, (g + 1) % groups, path);
+            } else {
+                // Обычный узел - другому обычному узлу своей группы (один переход по CSMA)
+                if (groupSizes[g] <= 2) continue;
+                path.push_back(static_cast<uint32_t>(node));
+            }
+            flows.AddFlow(path, rate);
+        }
+    }
+
+    flows.Finish(network);
+    return network;
+}
+
+JacksonNetwork JacksonSolver::BuildAdHocNetwork(double lambda,
+                                                const std::vector<double>& nodeLoads,
+                                                const std::vector<double>& serviceRates,
+                                                const std::vector<uint32_t>& nodeBuffers,
+                                                int defaultBufferSize) {
+    JacksonNetwork network;
+    const size_t numNodes = std::min(nodeLoads.size(), serviceRates.size());
+    if (numNodes == 0) return network;
+
+    network.serviceRates.assign(serviceRates.begin(), serviceRates.begin() + numNodes);
+    network.capacities.resize(numNodes);
+    network.externalArrivals.resize(numNodes);
+    for (size_t i = 0; i < numNodes; ++i) {
+        network.capacities[i] = BufferOf(nodeBuffers, i, defaultBufferSize);
+        // Получатель в радиусе связи - один переход
+        network.externalArrivals[i] = (numNodes > 1) ? std::max(0.0, lambda * nodeLoads[i]) : 0.0;
+    }
+    return network;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../simulation/backbone_topology.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Открытая сеть Джексона.
+ *
+ * - externalArrivals[i]: интенсивность внешнего пуассоновского потока γ_i
+ * - serviceRates[i]: интенсивность обслуживания станции μ_i
+ * - capacities[i]: ёмкость станции K_i (0 - M/M/1 без ограничения)
+ * - маршрутизация в формате CSR: для станции i элементы
+ *   [rowOffsets[i], rowOffsets[i + 1]) содержат номера станций columns
+ *   и вероятности P_ij перехода после обслуживания; остаток 1 - Σ_j P_ij
+ *   покидает сеть. Пустые rowOffsets - все пакеты покидают сеть после одной станции.
+ */
+struct JacksonNetwork {
+    std::vector<double> externalArrivals;
+    std::vector<double> serviceRates;
+    std::vector<uint32_t> capacities;
+    std::vector<size_t> rowOffsets;
+    std::vector<uint32_t> columns;
+    std::vector<double> probabilities;
+};
+
+/**
+ * Характеристики станций и сети в целом.
+ * Для неустойчивых станций M/M/1 (λ_i >= μ_i) L_i и T_i равны бесконечности.
+ */
+struct JacksonNetworkResult {
+    std::vector<double> arrivalRate;     // λ_i - решение уравнений трафика
+    std::vector<double> throughput;      // X_i = λ_i (1 - p_i)
+    std::vector<double> lossProbability; // p_i (p_K для M/M/1/K, 0 для M/M/1)
+    std::vector<double> utilization;     // X_i / μ_i
+    std::vector<double> avgSystemSize;   // L_i
+    std::vector<double> delay;           // T_i = L_i / X_i
+    double deliveredThroughput = 0.0;    // Интенсивность пакетов, покидающих сеть обслуженными
+    double meanSojournTime = 0.0;        // Σ L_i / deliveredThroughput (закон Литтла)
+    int iterations = 0;
+    double residual = 0.0;
+    bool converged = false;
+    bool stable = true;                  // Все станции M/M/1 с λ_i < μ_i
+};
+
+/**
+ * Решение открытой сети Джексона.
+ *
+ * Уравнения трафика λ_j = γ_j + Σ_i λ_i (1 - p_i) P_ij решаются итерациями
+ * Гаусса-Зейделя по транспонированной разреженной матрице (O(число переходов)
+ * на итерацию); для станций M/M/1/K потери p_i пересчитываются на каждой
+ * итерации. Далее каждая станция анализируется как M/M/1 или M/M/1/K.
+ */
+class JacksonSolver {
+public:
+    static JacksonNetworkResult Solve(const JacksonNetwork& network,
+                                      double tolerance = 1e-12,
+                                      int maxIterations = 10000);
+
+    /**
+     * Сеть, построенная по правилам генерации трафика GroupSimulator:
+     * станции 0..N-1 - очереди CSMA узлов (μ_i), далее по две станции
+     * (направления a -> b и b -> a) на каждую связь магистрали backbone
+     * (μ передающего главного узла, умноженная на множитель направления).
+     * Обычные узлы передают внутри группы, главные - главному узлу следующей
+     * группы; путь между группами - кратчайший, как у маршрутизации симулятора.
+     * @param serviceRates - μ_i узлов (без множителя магистрали)
+     * @param backbone - связи магистрали (по умолчанию кольцо с множителем 2)
+     */
+    static JacksonNetwork BuildGroupNetwork(double lambda,
+                                            const std::vector<double>& nodeLoads,
+                                            const std::vector<double>& serviceRates,
+                                            const std::vector<uint32_t>& nodeBuffers,
+                                            int defaultBufferSize,
+                                            int numGroups,
+                                            const BackboneParameters& backbone = BackboneParameters());
+
+    /**
+     * Сеть AdHocSimulator: каждый узел передаёт случайному другому узлу
+     * напрямую, станция - очередь MAC узла.
+     */
+    static JacksonNetwork BuildAdHocNetwork(double lambda,
+                                            const std::vector<double>& nodeLoads,
+                                            const std::vector<double>& serviceRates,
+                                            const std::vector<uint32_t>& nodeBuffers,
+                                            int defaultBufferSize);
+};
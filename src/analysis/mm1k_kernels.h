@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Специализации M/M/1/K для фиксированной ёмкости K (на этапе компиляции).
+ *
+ * Вместо std::pow(ρ, K) используются развёрнутые схемы Горнера:
+ *   S(ρ)  = Σ_{n=0}^{K} ρ^n       = 1 + ρ(1 + ρ(1 + ...))
+ *   S'(ρ) = Σ_{n=1}^{K} n ρ^(n-1) = 1 + ρ(2 + ρ(3 + ... + ρK))
+ * тогда p_K = ρ^K / S(ρ), L_s = ρ S'(ρ) / S(ρ). Случай ρ = 1 не требует
+ * отдельной ветки. При ρ > 1 используется симметрия p_n(ρ) = p_{K-n}(1/ρ).
+ *
+ * Все методы ожидают lambda > 0 и mu > 0 (проверки - в QueueingModels).
+ */
+namespace mm1k_detail {
+
+// Σ_{n=0}^{N} x^n по схеме Горнера
+template <int N>
+struct HornerOnes {
+    static double Eval(double x) { return 1.0 + x * HornerOnes<N - 1>::Eval(x); }
+};
+
+template <>
+struct HornerOnes<0> {
+    static double Eval(double) { return 1.0; }
+};
+
+// Σ_{n=C}^{Last} n x^(n-C) по схеме Горнера
+template <int C, int Last>
+struct HornerRamp {
+    static double Eval(double x) { return C + x * HornerRamp<C + 1, Last>::Eval(x); }
+};
+
+template <int Last>
+struct HornerRamp<Last, Last> {
+    static double Eval(double) { return Last; }
+};
+
+// x^N возведением в квадрат, развёрнутым на этапе компиляции
+template <int N>
+struct Power {
+    static double Eval(double x) {
+        double half = Power<N / 2>::Eval(x);
+        return (N % 2 == 0) ? half * half : half * half * x;
+    }
+};
+
+template <>
+struct Power<0> {
+    static double Eval(double) { return 1.0; }
+};
+
+} // namespace mm1k_detail
+
+template <int K>
+struct MM1K {
+    static_assert(K >= 1, "M/M/1/K specialization requires K >= 1");
+
+    // Вероятность потери p_K
+    static double Loss(double lambda, double mu) {
+        double rho = lambda / mu;
+        if (rho <= 1.0) {
+            return mm1k_detail::Power<K>::Eval(rho) / mm1k_detail::HornerOnes<K>::Eval(rho);
+        }
+        // p_K(ρ) = p_0(1/ρ) = 1 / S(1/ρ)
+        return 1.0 / mm1k_detail::HornerOnes<K>::Eval(1.0 / rho);
+    }
+
+    // λ_eff = λ (1 - p_K)
+    static double Throughput(double lambda, double mu) {
+        return lambda * (1.0 - Loss(lambda, mu));
+    }
+
+    // Среднее число заявок в системе L_s
+    static double AvgSystemSize(double lambda, double mu) {
+        double rho = lambda / mu;
+        double t = (rho <= 1.0) ? rho : 1.0 / rho;
+        double reduced = t * mm1k_detail::HornerRamp<1, K>::Eval(t) / mm1k_detail::HornerOnes<K>::Eval(t);
+        return (rho <= 1.0) ? reduced : static_cast<double>(K) - reduced;
+    }
+
+    // Закон Литтла: T_s = L_s / λ_eff
+    static double Delay(double lambda, double mu) {
+        return AvgSystemSize(lambda, mu) / Throughput(lambda, mu);
+    }
+};
+
+namespace mm1k_detail {
+
+using Kernel = double (*)(double lambda, double mu);
+
+struct KernelEntry {
+    Kernel loss;
+    Kernel throughput;
+    Kernel avgSystemSize;
+    Kernel delay;
+};
+
+template <size_t... I>
+constexpr std::array<KernelEntry, sizeof...(I)> MakeKernelTable(std::index_sequence<I...>) {
+    return {{ KernelEntry{ &MM1K<static_cast<int>(I) + 1>::Loss,
+                           &MM1K<static_cast<int>(I) + 1>::Throughput,
+                           &MM1K<static_cast<int>(I) + 1>::AvgSystemSize,
+                           &MM1K<static_cast<int>(I) + 1>::Delay }... }};
+}
+
+} // namespace mm1k_detail
+
+/**
+ * Таблица диспетчеризации: K времени выполнения -> специализация MM1K<K>.
+ * Для K вне [1, kMaxSpecializedK] Find возвращает nullptr (общий путь).
+ */
+class MM1KDispatch {
+public:
+    using Entry = mm1k_detail::KernelEntry;
+
+    static constexpr int kMaxSpecializedK = 64;
+
+    static const Entry* Find(int K) {
+        if (K < 1 || K > kMaxSpecializedK) return nullptr;
+        return &kTable[static_cast<size_t>(K - 1)];
+    }
+
+private:
+    static constexpr std::array<Entry, kMaxSpecializedK> kTable =
+        mm1k_detail::MakeKernelTable(std::make_index_sequence<kMaxSpecializedK>{});
+};
@@ -0,0 +1,216 @@
+#include "model_calibration.h"
+#include "../parallel/worker_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+// Число узлов сетки по каждому параметру и число сужений области
+const size_t kGridPoints = 65;
+const int kRefinements = 4;
+
+// Слабая регуляризация к исходным коэффициентам: при неразличимых значениях
+// (например, нижняя граница эффективности не достигается) выбирается исходное
+const double kTieBreak = 1e-9;
+
+using Objective = std::function<double(const std::vector<double>&)>;
+
+/**
+ * Минимизация objective на прямоугольнике [lower, upper].
+ * На каждом шаге перебирается равномерная сетка, затем область
+ * сужается до двух шагов сетки вокруг лучшей точки.
+ */
+std::vector<double> MinimizeOnGrid(const Objective& objective,
+                                   const std::vector<double>& lower,
+                                   const std::vector<double>& upper) {
+    const size_t dims = lower.size();
+    std::vector<double> low = lower;
+    std::vector<double> high = upper;
+    std::vector<double> best(dims, 0.0);
+    for (size_t d = 0; d < dims; ++d) best[d] = 0.5 * (low[d] + high[d]);
+
+    size_t total = 1;
+    for (size_t d = 0; d < dims; ++d) total *= kGridPoints;
+
+    for (int round = 0; round <= kRefinements; ++round) {
+        std::mutex bestMutex;
+        double bestValue = std::numeric_limits<double>::infinity();
+        std::vector<double> roundBest = best;
+
+        WorkerPool::Shared().ParallelFor(total, [&](size_t begin, size_t end) {
+            std::vector<double> point(dims);
+            std::vector<double> localBest = roundBest;
+            double localValue = std::numeric_limits<double>::infinity();
+
+            for (size_t index = begin; index < end; ++index) {
+                size_t rest = index;
+                for (size_t d = 0; d < dims; ++d) {
+                    size_t k = rest % kGridPoints;
+                    rest /= kGridPoints;
+                    point[d] = low[d] + (high[d] - low[d]) * k / (kGridPoints - 1);
+                }
+                double value = objective(point);
+                if (value < localValue) {
+                    localValue = value;
+                    localBest = point;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(bestMutex);
+            if (localValue < bestValue) {
+                bestValue = localValue;
+                roundBest = localBest;
+            }
+        });
+
+        best = roundBest;
+        for (size_t d = 0; d < dims; ++d) {
+            double step = (high[d] - low[d]) / (kGridPoints - 1);
+            low[d] = std::max(lower[d], best[d] - 2.0 * step);
+            high[d] = std::min(upper[d], best[d] + 2.0 * step);
+        }
+    }
+
+    return best;
+}
+
+CalibrationFit Evaluate(const std::vector<const HistoryRecord*>& points,
+                        const std::function<double(const HistoryRecord&)>& predict) {
+    CalibrationFit fit;
+    fit.samples = points.size();
+    if (points.empty()) return fit;
+
+    double squared = 0.0;
+    double measured = 0.0;
+    for (const HistoryRecord* record : points) {
+        double error = predict(*record) - record->throughput;
+        squared += error * error;
+        measured += record->throughput;
+    }
+    fit.rmse = std::sqrt(squared / points.size());
+    double mean = measured / points.size();
+    fit.relativeError = (mean > 0.0) ? fit.rmse / mean : 0.0;
+    fit.fitted = true;
+    return fit;
+}
+
+// Формулы совпадают с AnalysisMethods::AdHocThroughputModel / GroupThroughputModel
+double AdHocPrediction(const HistoryRecord& record, double contention) {
+    double totalLoad = record.load * record.dataRateMbps;
+    double efficiency = 1.0 / (1.0 + contention * (static_cast<double>(record.numNodes) - 1.0));
+    return std::min(totalLoad * efficiency, record.dataRateMbps);
+}
+
+double GroupPrediction(const HistoryRecord& record, double penalty, double floor) {
+    double totalLoad = record.load * record.dataRateMbps;
+    double efficiency = std::max(floor, 1.0 - penalty * (static_cast<double>(record.numGroups) - 1.0));
+    return std::min(totalLoad * efficiency, record.dataRateMbps);
+}
+
+} // namespace
+
+CalibrationResult ModelCalibration::Fit(const std::vector<HistoryRecord>& history,
+                                        const ThroughputModelCoefficients& initial) {
+    CalibrationResult result;
+    result.coefficients = initial;
+
+    std::vector<const HistoryRecord*> adHocPoints;
+    std::vector<const HistoryRecord*> groupPoints;
+    for (const HistoryRecord& record : history) {
+        if (record.load < 0.0 || record.dataRateMbps <= 0.0 || !std::isfinite(record.throughput)) continue;
+        if (record.networkType == "AdHoc" && record.numNodes > 0) {
+            adHocPoints.push_back(&record);
+        } else if (record.networkType == "Group" && record.numGroups > 0) {
+            groupPoints.push_back(&record);
+        }
+    }
+
+    if (!adHocPoints.empty()) {
+        auto sse = [&adHocPoints, &initial](const std::vector<double>& p) {
+            double shift = p[0] - initial.adHocContention;
+            double sum = kTieBreak * shift * shift;
+            for (const HistoryRecord* record : adHocPoints) {
+                double error = AdHocPrediction(*record, p[0]) - record->throughput;
+                sum += error * error;
+            }
+            return sum;
+        };
+        std::vector<double> best = MinimizeOnGrid(sse, {0.0}, {2.0});
+        result.coefficients.adHocContention = best[0];
+    }
+
+    if (!groupPoints.empty()) {
+        auto sse = [&groupPoints, &initial](const std::vector<double>& p) {
+            double shiftPenalty = p[0] - initial.groupPenalty;
+            double shiftFloor = p[1] - initial.groupFloor;
+            double sum = kTieBreak * (shiftPenalty * shiftPenalty + shiftFloor * shiftFloor);
+            for (const HistoryRecord* record : groupPoints) {
+                double error = GroupPrediction(*record, p[0], p[1]) - record->throughput;
+                sum += error * error;
+            }
+            return sum;
+        };
+        std::vector<double> best = MinimizeOnGrid(sse, {0.0, 0.0}, {0.5, 1.0});
+        result.coefficients.groupPenalty = best[0];
+        result.coefficients.groupFloor = best[1];
+    }
+
+    const ThroughputModelCoefficients& c = result.coefficients;
+    result.adHoc = Evaluate(adHocPoints, [&c](const HistoryRecord& r) {
+        return AdHocPrediction(r, c.adHocContention);
+    });
+    result.group = Evaluate(groupPoints, [&c](const HistoryRecord& r) {
+        return GroupPrediction(r, c.groupPenalty, c.groupFloor);
+    });
+    return result;
+}
+
+void ModelCalibration::Save(const CalibrationResult& result, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot write calibration file: " + filename);
+    }
+
+    file.precision(17);
+    file << "# Calibrated throughput model coefficients\n";
+    file << "ADHOC_CONTENTION=" << result.coefficients.adHocContention << "\n";
+    file << "GROUP_PENALTY=" << result.coefficients.groupPenalty << "\n";
+    file << "GROUP_FLOOR=" << result.coefficients.groupFloor << "\n";
+    file << "ADHOC_SAMPLES=" << result.adHoc.samples << "\n";
+    file << "ADHOC_RMSE=" << result.adHoc.rmse << "\n";
+    file << "GROUP_SAMPLES=" << result.group.samples << "\n";
+    file << "GROUP_RMSE=" << result.group.rmse << "\n";
+}
+
+bool ModelCalibration::Load(const std::string& filename, ThroughputModelCoefficients& coefficients) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        auto commentPos = line.find('#');
+        if (commentPos != std::string::npos) line = line.substr(0, commentPos);
+
+        auto equalsPos = line.find('=');
+        if (equalsPos == std::string::npos) continue;
+
+        std::string key = line.substr(0, equalsPos);
+        std::string value = line.substr(equalsPos + 1);
+        if (key == "ADHOC_CONTENTION") {
+            coefficients.adHocContention = std::stod(value);
+        } else if (key == "GROUP_PENALTY") {
+            coefficients.groupPenalty = std::stod(value);
+        } else if (key == "GROUP_FLOOR") {
+            coefficients.groupFloor = std::stod(value);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "analysis_methods.h"
+#include "../metrics/results_history.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Качество подгонки одной модели по точкам истории.
+ */
+struct CalibrationFit {
+    size_t samples = 0;
+    double rmse = 0.0;          // Среднеквадратичная ошибка, Мбит/с
+    double relativeError = 0.0; // rmse / средняя измеренная пропускная способность
+    bool fitted = false;        // false - точек нет, коэффициенты не менялись
+};
+
+struct CalibrationResult {
+    ThroughputModelCoefficients coefficients;
+    CalibrationFit adHoc;
+    CalibrationFit group;
+};
+
+/**
+ * Калибровка коэффициентов AdHocThroughputModel / GroupThroughputModel
+ * методом наименьших квадратов по накопленной истории симуляций.
+ *
+ * Модели кусочно-гладкие (min / max), поэтому минимум ищется перебором
+ * по сетке с последовательным сужением области вокруг лучшей точки.
+ * Узлы сетки вычисляются параллельно в общем пуле потоков.
+ */
+class ModelCalibration {
+public:
+    // initial - коэффициенты, сохраняемые для типа сети без точек в истории
+    static CalibrationResult Fit(const std::vector<HistoryRecord>& history,
+                                 const ThroughputModelCoefficients& initial = ThroughputModelCoefficients());
+
+    // Файл KEY=VALUE (формат .env)
+    static void Save(const CalibrationResult& result, const std::string& filename);
+
+    // false - файла нет; отсутствующие ключи остаются по умолчанию
+    static bool Load(const std::string& filename, ThroughputModelCoefficients& coefficients);
+};
@@ -8,6 +8,10 @@
 #include <limits>
 #include <iostream>
 
+#include "convolution_algorithm.h"
+#include "mm1k_kernels.h"
+#include "dual.h"
+
 /**
  * Класс, реализующий методы анализа для ОДНОЙ системы M/M/1/K.
  *
@@ -19,22 +23,69 @@
 class QueueingModels {
 private:
     /**
-     * Вспомогательный метод: вычисляет p0 (вероятность пустой системы) для M/M/1/K.
-     * K - общая ёмкость.
+     * Число заявок в замкнутой сети: по K заявок на каждый узел
+     * (для бесконечного буфера - по одной).
      */
-    static double Calculate_p0(double rho, int K) {
-        if (K <= 0) return 1.0; // Для M/M/1 p0 = 1 - rho
-        
-        if (std::abs(rho - 1.0) < 1e-9) {
-            // Случай rho = 1
-            return 1.0 / (static_cast<double>(K) + 1.0);
-        } else {
-            // Случай rho != 1
-            return (1.0 - rho) / (1.0 - std::pow(rho, K + 1));
-        }
+    static int ClosedPopulation(int bufferSize, int numNodes) {
+        return std::max(bufferSize, 1) * std::max(numNodes, 1);
     }
 
 public:
+    // === Формулы M/M/1/K, шаблонные по типу скаляра (double или Dual) ===
+    //
+    // Ёмкость K - того же типа, что и λ, μ: непрерывное продолжение по K даёт
+    // производные вида dp_K/dK. Через u = ln ρ и expm1 формулы устойчивы
+    // при ρ -> 1 и при больших K; при ρ > 1 - симметрия p_n(ρ) = p_{K-n}(1/ρ).
+
+    // Вероятность потери p_K
+    template <typename T>
+    static T MM1K_Loss(const T& lambda, const T& mu, const T& K) {
+        using std::exp;
+        using std::expm1;
+        using std::log;
+        const T u = log(lambda / mu);
+        if (std::abs(ValueOf(u)) < 1e-8) {
+            // Разложение в точке ρ = 1: p_K = 1 / (K + 1) + (ρ - 1) K / (2 (K + 1))
+            const T x = lambda / mu - 1.0;
+            return 1.0 / (K + 1.0) + x * K / (2.0 * (K + 1.0));
+        }
+        if (ValueOf(u) < 0.0) {
+            return exp(K * u) * expm1(u) / expm1((K + 1.0) * u);
+        }
+        const T v = -u;
+        return expm1(v) / expm1((K + 1.0) * v);
+    }
+
+    // Среднее число заявок в системе L_s
+    template <typename T>
+    static T MM1K_AvgSystemSize(const T& lambda, const T& mu, const T& K) {
+        using std::exp;
+        using std::expm1;
+        using std::log;
+        const T u = log(lambda / mu);
+        if (std::abs(ValueOf(u)) < 1e-8) {
+            // L_s = K / 2 + (ρ - 1) Var(N) при ρ = 1, Var(N) = K (K + 2) / 12
+            const T x = lambda / mu - 1.0;
+            return K / 2.0 + x * K * (K + 2.0) / 12.0;
+        }
+        // L_s для ρ = e^w < 1: ρ / (1 - ρ) - (K + 1) ρ^(K+1) / (1 - ρ^(K+1))
+        auto reduced = [&K](const T& w) {
+            return -exp(w) / expm1(w) + (K + 1.0) * exp((K + 1.0) * w) / expm1((K + 1.0) * w);
+        };
+        return (ValueOf(u) < 0.0) ? reduced(u) : K - reduced(-u);
+    }
+
+    template <typename T>
+    static T MM1K_Throughput(const T& lambda, const T& mu, const T& K) {
+        return lambda * (1.0 - MM1K_Loss(lambda, mu, K));
+    }
+
+    // Закон Литтла: T_s = L_s / λ_eff
+    template <typename T>
+    static T MM1K_Delay(const T& lambda, const T& mu, const T& K) {
+        return MM1K_AvgSystemSize(lambda, mu, K) / MM1K_Throughput(lambda, mu, K);
+    }
+
     /**
      * Вычисляет эффективную пропускную способность (λ_eff) для M/M/1/K.
      * λ_eff = λ * (1 - p_loss)
@@ -53,15 +104,13 @@ public:
         // Случай M/M/1/K (конечная ёмкость K = bufferSize)
         int K = bufferSize;
         
-        // Вероятность p0
-        double p0 = Calculate_p0(rho, K);
-        
-        // Вероятность потери (p_K) - вероятность, что система занята K заявками
-        // (Это p_K, а не p_{K+1}, так как ёмкость K - это состояния 0..K)
-        double pK_loss = p0 * std::pow(rho, K);
+        // Специализация MM1K<K> для типовых размеров буфера
+        if (const MM1KDispatch::Entry* kernel = MM1KDispatch::Find(K)) {
+            return kernel->throughput(lambda, mu);
+        }
         
-        // Эффективная пропускная способность
-        return lambda * (1.0 - pK_loss);
+        // Общая формула: p_K - вероятность, что система занята K заявками
+        return MM1K_Throughput<double>(lambda, mu, static_cast<double>(K));
     }
 
     /**
@@ -86,24 +135,11 @@ public:
         int K = bufferSize;
         double K_double = static_cast<double>(K);
 
-        // L_s для rho = 1
-        if (std::abs(rho - 1.0) < 1e-9) {
-            return K_double / 2.0;
+        if (const MM1KDispatch::Entry* kernel = MM1KDispatch::Find(K)) {
+            return kernel->avgSystemSize(lambda, mu);
         }
 
-        // L_s для rho != 1
-        // Формула: L_s = ρ * (1 - (K+1)ρ^K + Kρ^(K+1)) / ((1-ρ)(1-ρ^(K+1)))
-        double rho_K = std::pow(rho, K);
-        double rho_K1 = rho_K * rho;
-        
-        double num = rho * (1.0 - (K_double + 1.0) * rho_K + K_double * rho_K1);
-        double den = (1.0 - rho) * (1.0 - rho_K1);
-        
-        if (den == 0.0) {
-            return K_double;
-        }
-        
-        return num / den;
+        return MM1K_AvgSystemSize<double>(lambda, mu, K_double);
     }
 
     /**
@@ -111,6 +147,12 @@ public:
      * T_s = L_s / λ_eff
      */
     static double Calculate_MM1K_Delay(double lambda, double mu, int bufferSize) {
+        if (lambda > 0.0 && mu > 0.0) {
+            if (const MM1KDispatch::Entry* kernel = MM1KDispatch::Find(bufferSize)) {
+                return kernel->delay(lambda, mu);
+            }
+        }
+        
         double L_s = Calculate_MM1K_AvgSystemSize(lambda, mu, bufferSize);
         
         if (L_s <= 0.0) return 0.0;
@@ -128,6 +170,65 @@ public:
         return L_s / lambda_eff;
     }
 
+    /**
+     * Хвост времени пребывания принятой заявки P(T > t) для M/M/1/K (FIFO).
+     * Заявка, заставшая n < K заявок (вероятность π_n / (1 - π_K)),
+     * находится в системе время Erlang(n + 1, μ):
+     *   P(T > t) = Σ_{n<K} π_n / (1 - π_K) · Σ_{j<=n} e^{-μt} (μt)^j / j!
+     */
+    static double Calculate_MM1K_SojournTail(double lambda, double mu, int bufferSize, double t) {
+        if (lambda < 0.0 || mu <= 0.0 || bufferSize <= 0) return 0.0;
+        if (t <= 0.0) return 1.0;
+
+        const int K = bufferSize;
+        const double rho = lambda / mu;
+
+        // Ненормированные π_n: ρ^n при ρ <= 1, ρ^(n-K) при ρ > 1 (без переполнения)
+        std::vector<double> weights(static_cast<size_t>(K) + 1);
+        double total = 0.0;
+        for (int n = 0; n <= K; ++n) {
+            double exponent = (rho <= 1.0) ? n : n - K;
+            weights[n] = (rho > 0.0) ? std::pow(rho, exponent) : (n == 0 ? 1.0 : 0.0);
+            total += weights[n];
+        }
+        const double accepted = total - weights[K];
+        if (accepted <= 0.0) return 0.0;
+
+        const double x = mu * t;
+        const double logX = std::log(x);
+        double erlangTail = 0.0; // Σ_{j<=n} e^{-x} x^j / j!
+        double tail = 0.0;
+        for (int n = 0; n < K; ++n) {
+            erlangTail += std::exp(-x + n * logX - std::lgamma(n + 1.0));
+            tail += weights[n] / accepted * std::min(1.0, erlangTail);
+        }
+        return tail;
+    }
+
+    /**
+     * Квантиль времени пребывания уровня q (например, 0.95) - бисекцией по t.
+     */
+    static double Calculate_MM1K_SojournQuantile(double lambda, double mu, int bufferSize, double q) {
+        if (lambda <= 0.0 || mu <= 0.0 || bufferSize <= 0 || q <= 0.0) return 0.0;
+        const double target = 1.0 - std::min(q, 1.0 - 1e-12);
+
+        double low = 0.0;
+        double high = static_cast<double>(bufferSize) / mu;
+        while (Calculate_MM1K_SojournTail(lambda, mu, bufferSize, high) > target) {
+            low = high;
+            high *= 2.0;
+        }
+        for (int iteration = 0; iteration < 60; ++iteration) {
+            double middle = 0.5 * (low + high);
+            if (Calculate_MM1K_SojournTail(lambda, mu, bufferSize, middle) > target) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        return high;
+    }
+
     // === Высокоуровневые методы анализа (с сетевыми эвристиками) ===
     
     /**
@@ -140,12 +241,8 @@ public:
         
         // Базовая пропускная способность M/M/1/K
         double baseThroughput = Calculate_MM1K_Throughput(lambda, mu, bufferSize);
-        
-        // Эвристический фактор MVA для замкнутой сети:
-        // Учет того, что прибытие зависит от числа клиентов (N) в системе (обратная связь)
-        double MVA_Factor = static_cast<double>(numNodes) / (static_cast<double>(numNodes) + 1.0);
 
-        return baseThroughput * MVA_Factor;
+        return baseThroughput * MVANetworkFactor(numNodes);
     }
 
     /**
@@ -162,7 +259,7 @@ public:
 
     /**
      * Метод Гордона-Ньюэлла (Gordon-Newell Method)
-     * Используем сетевой коэффициент, вдохновленный $G(K, N)$
+     * Замкнутая сеть из numNodes одинаковых станций с N = numNodes * bufferSize заявками.
      */
     static double GordonNewellMethod(double lambda, double mu, int bufferSize, int numNodes) {
         if (lambda < 0.0 || mu <= 0.0 || numNodes <= 0) return 0.0;
@@ -170,16 +267,12 @@ public:
         
         double baseThroughput = Calculate_MM1K_Throughput(lambda, mu, bufferSize);
         
-        // Эвристический сетевой коэффициент (стремится к 1)
-        int N = std::max(numNodes, 1);
-        double networkFactor = 1.0 - std::exp(-(double)N / 3.0);
-        
-        return baseThroughput * networkFactor;
+        return baseThroughput * GordonNewellNetworkFactor(mu, bufferSize, numNodes);
     }
 
     /**
      * Метод Бузена (Buzen Method)
-     * Используем сетевой коэффициент, вдохновленный алгоритмом свертки $G_n(g)$.
+     * Алгоритм свёртки G(n) для замкнутой сети из numNodes одинаковых станций.
      */
     static double BuzenMethod(double lambda, double mu, int bufferSize, int numNodes) {
         if (lambda < 0.0 || mu <= 0.0 || numNodes <= 0) return 0.0;
@@ -187,11 +280,49 @@ public:
         
         double baseThroughput = Calculate_MM1K_Throughput(lambda, mu, bufferSize);
         
-        // Эвристический коэффициент (стремится к 1)
-        int N = std::max(numNodes, 1);
-        double efficiency = static_cast<double>(N) / (static_cast<double>(N) + 2.0);
+        return baseThroughput * BuzenNetworkFactor(mu, bufferSize, numNodes);
+    }
+
+    // === Сетевые коэффициенты (не зависят от λ) ===
+
+    /**
+     * Эвристический фактор MVA для замкнутой сети:
+     * учет того, что прибытие зависит от числа клиентов (N) в системе (обратная связь).
+     */
+    static double MVANetworkFactor(int numNodes) {
+        if (numNodes <= 0) return 0.0;
+        return static_cast<double>(numNodes) / (static_cast<double>(numNodes) + 1.0);
+    }
+
+    /**
+     * Коэффициент Гордона-Ньюэлла - вероятность того, что заявка застаёт в узле
+     * менее K заявок: 1 - P(n_i >= K) = 1 - D^K * G(N-K) / G(N).
+     */
+    static double GordonNewellNetworkFactor(double mu, int bufferSize, int numNodes) {
+        if (mu <= 0.0 || numNodes <= 0) return 0.0;
+        if (bufferSize <= 0) return 1.0; // Без ограничения буфера блокировок нет
+        
+        int population = ClosedPopulation(bufferSize, numNodes);
+        double serviceDemand = 1.0 / mu;
+        std::vector<double> logG = ConvolutionAlgorithm::LogNormalizationConstants(
+            std::vector<double>(static_cast<size_t>(numNodes), serviceDemand), population);
+        
+        return 1.0 - ConvolutionAlgorithm::TailProbability(logG, serviceDemand, population, bufferSize);
+    }
+
+    /**
+     * Коэффициент Бузена - загрузка станции U = D * G(N-1) / G(N).
+     */
+    static double BuzenNetworkFactor(double mu, int bufferSize, int numNodes) {
+        if (mu <= 0.0 || numNodes <= 0) return 0.0;
+        
+        int population = ClosedPopulation(bufferSize, numNodes);
+        ClosedNetworkResult network = ConvolutionAlgorithm::Solve(
+            std::vector<double>(static_cast<size_t>(numNodes), 1.0),
+            std::vector<double>(static_cast<size_t>(numNodes), 1.0 / mu),
+            population);
         
-        return baseThroughput * efficiency;
+        return network.utilization.empty() ? 0.0 : network.utilization[0];
     }
 
    // ========================================================================
@@ -366,4 +497,58 @@ static double CalculateMVADelay_Mode2(double mu, int numGroups, int nodesPerGrou
 
      return networkTotalDelay;
  }
+
+/**
+ * MVA для замкнутой сети с разными станциями (точный, итерации k = 1..K)
+ * @param visitRatios - коэффициенты посещения e_i
+ * @param serviceTimes - средние времена обслуживания 1/μ_i
+ * @param K - число заявок в сети
+ * @return загрузки, пропускные способности, длины очередей и времена пребывания
+ *         по станциям (как ConvolutionAlgorithm::Solve; ln G(K) = -Σ ln λ(k))
+ */
+static ClosedNetworkResult CalculateMVA_Network(const std::vector<double>& visitRatios,
+                                                const std::vector<double>& serviceTimes,
+                                                int K) {
+    ClosedNetworkResult result;
+    const size_t N = std::min(visitRatios.size(), serviceTimes.size());
+    result.population = std::max(K, 0);
+    result.utilization.assign(N, 0.0);
+    result.throughput.assign(N, 0.0);
+    result.queueLength.assign(N, 0.0);
+    result.residenceTime.assign(N, 0.0);
+    if (N == 0 || K <= 0) return result;
+
+    // Требования D_i = e_i / μ_i
+    std::vector<double> demand(N);
+    for (size_t i = 0; i < N; ++i) {
+        demand[i] = std::max(0.0, visitRatios[i]) * std::max(0.0, serviceTimes[i]);
+    }
+
+    double systemThroughput = 0.0;
+    for (int k = 1; k <= K; ++k) {
+        // T̄_i(k) = (1/μ_i) [1 + K̄_i(k-1)], взвешенная сумма T̄(k) = Σ D_i [1 + K̄_i(k-1)]
+        double totalDelay = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            totalDelay += demand[i] * (1.0 + result.queueLength[i]);
+        }
+        if (totalDelay <= 1e-300) return result;
+
+        // λ(k) = k / T̄(k), K̄_i(k) = λ(k) D_i [1 + K̄_i(k-1)]
+        systemThroughput = static_cast<double>(k) / totalDelay;
+        result.logNormalizationConstant -= std::log(systemThroughput);
+        for (size_t i = 0; i < N; ++i) {
+            result.queueLength[i] = systemThroughput * demand[i] * (1.0 + result.queueLength[i]);
+        }
+    }
+
+    result.systemThroughput = systemThroughput;
+    for (size_t i = 0; i < N; ++i) {
+        result.utilization[i] = demand[i] * systemThroughput;
+        result.throughput[i] = std::max(0.0, visitRatios[i]) * systemThroughput;
+        result.residenceTime[i] = (result.throughput[i] > 0.0)
+            ? result.queueLength[i] / result.throughput[i]
+            : 0.0;
+    }
+    return result;
+}
 };
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "sensitivity.h"
+#include "queueing_models.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int kBisectionSteps = 100;
+
+// Производная по одному параметру: Dual-проход с Variable в нужной позиции
+template <typename Formula>
+void Differentiate(Formula formula, double lambda, double mu, double K, ParameterGradient& gradient) {
+    gradient.value = formula(Dual(lambda), Dual(mu), Dual(K)).value;
+    gradient.dLambda = formula(Dual::Variable(lambda), Dual(mu), Dual(K)).derivative;
+    gradient.dMu = formula(Dual(lambda), Dual::Variable(mu), Dual(K)).derivative;
+    gradient.dK = formula(Dual(lambda), Dual(mu), Dual::Variable(K)).derivative;
+}
+
+double ThroughputSlope(double lambda, double mu, double K) {
+    return QueueingModels::MM1K_Throughput<Dual>(Dual::Variable(lambda), Dual(mu), Dual(K)).derivative;
+}
+
+// Предельный выигрыш узла от буфера: λ |dp_K / dK|
+double MarginalGain(double lambda, double mu, double K) {
+    if (lambda <= 0.0 || mu <= 0.0) return 0.0;
+    return -lambda * QueueingModels::MM1K_Loss<Dual>(Dual(lambda), Dual(mu), Dual::Variable(K)).derivative;
+}
+
+// Наибольшее K из [low, high] с предельным выигрышем не меньше price
+double BufferAtPrice(double lambda, double mu, double low, double high, double price) {
+    if (MarginalGain(lambda, mu, low) <= price) return low;
+    if (MarginalGain(lambda, mu, high) >= price) return high;
+    for (int step = 0; step < kBisectionSteps; ++step) {
+        double middle = 0.5 * (low + high);
+        if (MarginalGain(lambda, mu, middle) >= price) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+} // namespace
+
+NodeSensitivity SensitivityAnalysis::MM1K(double lambda, double mu, double K) {
+    NodeSensitivity result;
+    if (lambda <= 0.0 || mu <= 0.0 || K < 1.0) return result;
+
+    Differentiate([](const Dual& l, const Dual& m, const Dual& k) {
+        return QueueingModels::MM1K_Throughput(l, m, k);
+    }, lambda, mu, K, result.throughput);
+    Differentiate([](const Dual& l, const Dual& m, const Dual& k) {
+        return QueueingModels::MM1K_Loss(l, m, k);
+    }, lambda, mu, K, result.loss);
+    Differentiate([](const Dual& l, const Dual& m, const Dual& k) {
+        return QueueingModels::MM1K_Delay(l, m, k);
+    }, lambda, mu, K, result.delay);
+    return result;
+}
+
+double SensitivityAnalysis::SaturationKnee(double mu, double K, double slope) {
+    if (mu <= 0.0 || K < 1.0 || slope <= 0.0 || slope >= 1.0) return 0.0;
+
+    // Верхняя граница: производная уже меньше slope
+    double high = mu;
+    for (int step = 0; step < 64 && ThroughputSlope(high, mu, K) >= slope; ++step) {
+        high *= 2.0;
+    }
+    double low = 0.0;
+    for (int step = 0; step < kBisectionSteps; ++step) {
+        double middle = 0.5 * (low + high);
+        if (ThroughputSlope(middle, mu, K) >= slope) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+std::vector<double> SensitivityAnalysis::ContinuousBufferAllocation(const std::vector<double>& arrivalRates,
+                                                                    const std::vector<double>& serviceRates,
+                                                                    uint32_t budget,
+                                                                    uint32_t minBuffer) {
+    const size_t M = arrivalRates.size();
+    if (M == 0 || serviceRates.size() != M) return {};
+
+    const double low = std::max<uint32_t>(minBuffer, 1);
+    const double high = std::max(low, static_cast<double>(budget) - low * static_cast<double>(M - 1));
+    std::vector<double> buffers(M, low);
+    if (high <= low) return buffers;
+
+    auto allocate = [&](double price) {
+        double total = 0.0;
+        for (size_t i = 0; i < M; ++i) {
+            buffers[i] = BufferAtPrice(arrivalRates[i], serviceRates[i], low, high, price);
+            total += buffers[i];
+        }
+        return total;
+    };
+
+    // Σ K_i(ν) убывает по ν; предельные выигрыши различаются на много порядков,
+    // поэтому бисекция ведётся по log ν
+    double maxPrice = 0.0;
+    for (size_t i = 0; i < M; ++i) {
+        maxPrice = std::max(maxPrice, MarginalGain(arrivalRates[i], serviceRates[i], low));
+    }
+    if (maxPrice <= 0.0) return buffers;
+
+    double logHigh = std::log(maxPrice);
+    double logLow = logHigh - 700.0;
+    for (int step = 0; step < kBisectionSteps; ++step) {
+        double middle = 0.5 * (logLow + logHigh);
+        if (allocate(std::exp(middle)) > budget) {
+            logLow = middle;
+        } else {
+            logHigh = middle;
+        }
+    }
+    allocate(std::exp(logHigh));
+    return buffers;
+}
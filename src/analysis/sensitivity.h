@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Значение характеристики и её частные производные по параметрам M/M/1/K.
+ * Ёмкость K считается непрерывной (продолжение формул по K).
+ */
+struct ParameterGradient {
+    double value = 0.0;
+    double dLambda = 0.0;
+    double dMu = 0.0;
+    double dK = 0.0;
+};
+
+struct NodeSensitivity {
+    ParameterGradient throughput; // λ_eff, пакетов/с
+    ParameterGradient loss;       // p_K
+    ParameterGradient delay;      // T_s, с
+};
+
+/**
+ * Чувствительность аналитических моделей через автоматическое
+ * дифференцирование: формулы QueueingModels::MM1K_* вычисляются с T = Dual,
+ * по проходу на каждый параметр. Производные точные (до округления), в
+ * отличие от конечных разностей не требуют выбора шага и не теряют точность
+ * около ρ = 1 и в хвостах p_K ~ 1e-100.
+ */
+class SensitivityAnalysis {
+public:
+    // Пустой результат при lambda <= 0, mu <= 0 или K < 1
+    static NodeSensitivity MM1K(double lambda, double mu, double K);
+
+    /**
+     * Колено насыщения: λ, при котором dλ_eff / dλ = slope (0 < slope < 1).
+     * λ_eff(λ) возрастает и вогнута, производная убывает от 1 - p_K(0) к 0,
+     * поэтому корень ищется бисекцией. 0 - корня нет (slope вне диапазона).
+     */
+    static double SaturationKnee(double mu, double K, double slope = 0.5);
+
+    /**
+     * Непрерывная релаксация распределения буферов: минимум Σ λ_i p_K,i(K_i)
+     * при Σ K_i = budget, K_i >= minBuffer. Условие оптимальности -
+     * равенство предельных выигрышей λ_i |dp_K,i / dK_i| = ν у узлов выше
+     * минимума; ν подбирается бисекцией, K_i(ν) - бисекцией по убывающей
+     * производной. Пустой вектор - несовпадающие размеры или нет узлов.
+     */
+    static std::vector<double> ContinuousBufferAllocation(const std::vector<double>& arrivalRates,
+                                                          const std::vector<double>& serviceRates,
+                                                          uint32_t budget,
+                                                          uint32_t minBuffer);
+};
@@ -0,0 +1,138 @@
+#include "single_queue_models.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double kNegligibleLog = -60.0; // Отбрасываемые члены: меньше e^-60 от наибольшего
+
+// log(e^a + e^b) без переполнения
+double LogAdd(double a, double b) {
+    if (a == -std::numeric_limits<double>::infinity()) return b;
+    if (b == -std::numeric_limits<double>::infinity()) return a;
+    double high = std::max(a, b);
+    return high + std::log1p(std::exp(std::min(a, b) - high));
+}
+
+// Нормировка логарифмов весов в распределение
+std::vector<double> Normalize(const std::vector<double>& logWeights) {
+    double logTotal = -std::numeric_limits<double>::infinity();
+    for (double w : logWeights) logTotal = LogAdd(logTotal, w);
+    std::vector<double> p(logWeights.size());
+    for (size_t n = 0; n < p.size(); ++n) p[n] = std::exp(logWeights[n] - logTotal);
+    return p;
+}
+
+void FillMoments(QueueModelResult& result, double lambda, double capacityRate) {
+    for (size_t n = 0; n < result.distribution.size(); ++n) {
+        result.avgSystemSize += n * result.distribution[n];
+    }
+    result.lossProbability = result.distribution.back();
+    result.throughput = lambda * (1.0 - result.lossProbability);
+    result.delay = (result.throughput > 0.0) ? result.avgSystemSize / result.throughput : 0.0;
+    result.utilization = result.throughput / capacityRate;
+}
+
+/**
+ * log a_k - вероятность k пуассоновских поступлений за время обслуживания,
+ * k = 0, 1, ... пока не пройдены первые minCount членов и мода распределения
+ * и члены не стали пренебрежимо малы.
+ */
+std::vector<double> LogArrivalsDuringService(double lambda, double mu, double scv, int minCount) {
+    std::vector<double> logA;
+    const double x = lambda / mu; // Среднее число поступлений за обслуживание
+
+    // log a_k как функция k для выбранного распределения обслуживания
+    auto term = [&](int k) -> double {
+        if (scv <= 0.0) {
+            // Детерминированное: Пуассон(x)
+            return -x + k * std::log(x) - std::lgamma(k + 1.0);
+        }
+        if (scv <= 1.0) {
+            // Эрланга r фаз со средним 1 / μ: отрицательное биномиальное
+            const double r = std::max(1.0, std::round(1.0 / scv));
+            const double q = x / (x + r); // λ / (λ + r μ)
+            return std::lgamma(k + r) - std::lgamma(r) - std::lgamma(k + 1.0) +
+                   k * std::log(q) + r * std::log1p(-q);
+        }
+        // H2 со сбалансированными средними: p_j / μ_j = 1 / (2 μ)
+        const double p1 = 0.5 * (1.0 + std::sqrt((scv - 1.0) / (scv + 1.0)));
+        double value = -std::numeric_limits<double>::infinity();
+        for (double p : {p1, 1.0 - p1}) {
+            const double xj = x / (2.0 * p); // λ / μ_j
+            const double q = xj / (1.0 + xj);
+            value = LogAdd(value, std::log(p) + k * std::log(q) + std::log1p(-q));
+        }
+        return value;
+    };
+
+    double peak = -std::numeric_limits<double>::infinity();
+    for (int k = 0;; ++k) {
+        const double value = term(k);
+        logA.push_back(value);
+        peak = std::max(peak, value);
+        if (k >= minCount && k > x && value < peak + kNegligibleLog) break;
+    }
+    return logA;
+}
+
+} // namespace
+
+QueueModelResult SingleQueueModels::MMcK(double lambda, double mu, int servers, int capacity) {
+    QueueModelResult result;
+    if (lambda <= 0.0 || mu <= 0.0 || servers < 1 || capacity < servers) return result;
+
+    std::vector<double> logWeights(static_cast<size_t>(capacity) + 1, 0.0);
+    const double logLambda = std::log(lambda);
+    for (int n = 1; n <= capacity; ++n) {
+        logWeights[n] = logWeights[n - 1] + logLambda - std::log(std::min(n, servers) * mu);
+    }
+    result.distribution = Normalize(logWeights);
+    FillMoments(result, lambda, servers * mu);
+    return result;
+}
+
+QueueModelResult SingleQueueModels::MG1K(double lambda, double mu, double scv, int capacity) {
+    QueueModelResult result;
+    if (lambda <= 0.0 || mu <= 0.0 || capacity < 1) return result;
+
+    const int K = capacity;
+    const std::vector<double> logA = LogArrivalsDuringService(lambda, mu, scv, K + 1);
+
+    // log ā_k = log Σ_{m>=k} a_m и log T_k = log Σ_{m>=k} ā_m - суммы от малых членов к большим
+    const double none = -std::numeric_limits<double>::infinity();
+    std::vector<double> logTail(logA.size() + 1, none);
+    std::vector<double> logTail2(logA.size() + 1, none);
+    for (size_t k = logA.size(); k > 0; --k) {
+        logTail[k - 1] = LogAdd(logTail[k], logA[k - 1]);
+        logTail2[k - 1] = LogAdd(logTail2[k], logTail[k - 1]);
+    }
+
+    // Распределение в моменты ухода, n = 0..K-1 (ненормированное, в логарифмах)
+    std::vector<double> logPi(static_cast<size_t>(K), 0.0);
+    for (int j = 0; j + 1 < K; ++j) {
+        double up = logPi[0] + logTail[j + 1];
+        for (int i = 1; i <= j; ++i) {
+            up = LogAdd(up, logPi[i] + logTail[j - i + 2]);
+        }
+        logPi[j + 1] = up - logA[0];
+    }
+    const std::vector<double> pi = Normalize(logPi);
+
+    // B - среднее число отвергнутых за одно обслуживание: при n заявках после
+    // ухода свободно K - n мест (K - 1 при n = 0), E[(A - m)^+] = T_{m+1}.
+    // λ p_K = λ (1 - p_K) B, поэтому p_K = B / (1 + B), p_n = π_n / (1 + B);
+    // в отличие от 1 - 1 / (π_0 + ρ) малые p_K не теряются при вычитании
+    double logB = std::log(pi[0]) + logTail2[K];
+    for (int i = 1; i < K; ++i) {
+        logB = LogAdd(logB, std::log(pi[i]) + logTail2[K - i + 1]);
+    }
+    const double logScale = LogAdd(0.0, logB);
+    result.distribution.assign(static_cast<size_t>(K) + 1, 0.0);
+    for (int n = 0; n < K; ++n) result.distribution[n] = pi[n] * std::exp(-logScale);
+    result.distribution[K] = std::exp(logB - logScale);
+    FillMoments(result, lambda, mu);
+    return result;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Стационарные характеристики одной очереди с ёмкостью K (очередь + приборы).
+ */
+struct QueueModelResult {
+    std::vector<double> distribution; // p_n, n = 0..K (по времени)
+    double lossProbability = 0.0;     // p_K - доля отвергнутых заявок (PASTA)
+    double throughput = 0.0;          // λ (1 - p_K)
+    double avgSystemSize = 0.0;       // L
+    double delay = 0.0;               // T = L / λ_eff
+    double utilization = 0.0;         // Доля занятых приборов: λ_eff / (c μ)
+};
+
+/**
+ * Однолинейные и многоканальные модели с конечной ёмкостью, устойчивые при
+ * больших K и ρ >> 1: распределения вычисляются в логарифмах с нормировкой
+ * log-sum-exp, так что ни ρ^K, ни e^{-λ/μ} не переполняются и не обнуляются.
+ *
+ * Пустой результат - lambda <= 0, mu <= 0, K < 1 (для M/M/c/K - и K < c).
+ */
+class SingleQueueModels {
+public:
+    // M/M/c/K: log p_n = n log λ - Σ_{k<=n} log(min(k, c) μ) + const
+    static QueueModelResult MMcK(double lambda, double mu, int servers, int capacity);
+
+    static QueueModelResult MM1K(double lambda, double mu, int capacity) {
+        return MMcK(lambda, mu, 1, capacity);
+    }
+
+    /**
+     * M/G/1/K через вложенную цепь Маркова в моменты ухода заявок.
+     * Время обслуживания со средним 1 / μ и квадратом коэффициента вариации scv:
+     * scv = 0 - детерминированное, 0 < scv < 1 - Эрланга с r = round(1 / scv)
+     * фазами, scv = 1 - экспоненциальное, scv > 1 - гиперэкспоненциальное H2
+     * со сбалансированными средними. a_k - вероятность k поступлений за время
+     * обслуживания; ушедшая заявка оставляет в системе 0..K-1 заявок, и по
+     * балансу переходов через уровень j (только положительные слагаемые)
+     *   π_{j+1} a_0 = π_0 ā_{j+1} + Σ_{i=1..j} π_i ā_{j-i+2},  ā_k = Σ_{m>=k} a_m.
+     * Распределение по времени: p_n = π_n (1 - p_K), n < K, где p_K выражается
+     * через среднее число отвергнутых за обслуживание (см. реализацию).
+     */
+    static QueueModelResult MG1K(double lambda, double mu, double scv, int capacity);
+
+    // M/D/1/K: постоянное время обслуживания 1 / μ (пакеты фиксированной длины)
+    static QueueModelResult MD1K(double lambda, double mu, int capacity) {
+        return MG1K(lambda, mu, 0.0, capacity);
+    }
+};
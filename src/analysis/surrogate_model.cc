@@ -0,0 +1,344 @@
+#include "surrogate_model.h"
+#include "../parallel/worker_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace {
+
+// Кандидаты общего масштаба длины (в нормированных координатах) и относительного самородка
+const double kLengthScales[] = {0.05, 0.1, 0.2, 0.35, 0.5, 0.75, 1.0, 1.5, 2.5};
+const double kNuggets[] = {1e-6, 1e-4, 1e-2};
+
+// Множители при покоординатном уточнении масштабов и число проходов
+const double kScaleMultipliers[] = {0.25, 0.5, 2.0, 4.0, 16.0, 100.0};
+const int kRefinementSweeps = 2;
+
+using Features = SurrogateModel::Features;
+
+double Kernel(const Features& a, const Features& b, const Features& lengthScales) {
+    double distance = 0.0;
+    for (size_t d = 0; d < SurrogateModel::kNumFeatures; ++d) {
+        double diff = (a[d] - b[d]) / lengthScales[d];
+        distance += diff * diff;
+    }
+    return std::exp(-0.5 * distance);
+}
+
+// Разложение Холецкого на месте (нижний треугольник); false - матрица не положительно определена
+bool Cholesky(std::vector<double>& a, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        double* rowJ = &a[j * n];
+        double diagonal = rowJ[j];
+        for (size_t k = 0; k < j; ++k) diagonal -= rowJ[k] * rowJ[k];
+        if (diagonal <= 0.0) return false;
+        diagonal = std::sqrt(diagonal);
+        rowJ[j] = diagonal;
+
+        for (size_t i = j + 1; i < n; ++i) {
+            double* rowI = &a[i * n];
+            double sum = rowI[j];
+            for (size_t k = 0; k < j; ++k) sum -= rowI[k] * rowJ[k];
+            rowI[j] = sum / diagonal;
+        }
+    }
+    return true;
+}
+
+// L x = b (на месте)
+void SolveLower(const std::vector<double>& l, size_t n, std::vector<double>& x) {
+    for (size_t i = 0; i < n; ++i) {
+        const double* row = &l[i * n];
+        double sum = x[i];
+        for (size_t k = 0; k < i; ++k) sum -= row[k] * x[k];
+        x[i] = sum / row[i];
+    }
+}
+
+// Lᵀ x = b (на месте)
+void SolveUpper(const std::vector<double>& l, size_t n, std::vector<double>& x) {
+    for (size_t i = n; i-- > 0;) {
+        double sum = x[i];
+        for (size_t k = i + 1; k < n; ++k) sum -= l[k * n + i] * x[k];
+        x[i] = sum / l[i * n + i];
+    }
+}
+
+std::vector<double> BuildCovariance(const std::vector<Features>& points, const Features& lengthScales, double nugget) {
+    const size_t n = points.size();
+    std::vector<double> k(n * n);
+    for (size_t i = 0; i < n; ++i) {
+        k[i * n + i] = 1.0 + nugget;
+        for (size_t j = 0; j < i; ++j) {
+            double value = Kernel(points[i], points[j], lengthScales);
+            k[i * n + j] = value;
+            k[j * n + i] = value;
+        }
+    }
+    return k;
+}
+
+/**
+ * Нормированная ошибка скользящего контроля: для ГП остаток при исключении
+ * точки i равен α_i / [K⁻¹]_ii, где α = K⁻¹ y. Ошибки выходов делятся
+ * на их дисперсию и суммируются. +inf - разложение не удалось.
+ */
+double LeaveOneOutError(const std::vector<Features>& points,
+                        const std::vector<std::vector<double>>& centered,
+                        const std::vector<double>& outputVariance,
+                        const Features& lengthScales, double nugget) {
+    const size_t n = points.size();
+    std::vector<double> l = BuildCovariance(points, lengthScales, nugget);
+    if (!Cholesky(l, n)) return std::numeric_limits<double>::infinity();
+
+    // diag(K⁻¹)_i = Σ_k (L⁻¹)_ki²; столбцы L⁻¹ - решения L x = e_i
+    std::vector<double> inverseDiagonal(n, 0.0);
+    std::vector<double> column(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(column.begin(), column.end(), 0.0);
+        column[i] = 1.0;
+        for (size_t r = i; r < n; ++r) {
+            const double* row = &l[r * n];
+            double sum = column[r];
+            for (size_t k = i; k < r; ++k) sum -= row[k] * column[k];
+            column[r] = sum / row[r];
+            inverseDiagonal[i] += column[r] * column[r];
+        }
+    }
+
+    double error = 0.0;
+    for (size_t o = 0; o < centered.size(); ++o) {
+        if (outputVariance[o] <= 0.0) continue;
+        std::vector<double> alpha = centered[o];
+        SolveLower(l, n, alpha);
+        SolveUpper(l, n, alpha);
+
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double residual = alpha[i] / inverseDiagonal[i];
+            sum += residual * residual;
+        }
+        error += sum / (n * outputVariance[o]);
+    }
+    return error;
+}
+
+} // namespace
+
+double SurrogatePrediction::RelativeUncertainty() const {
+    const double eps = 1e-12;
+    double throughputError = throughputStd / std::max(std::abs(throughput), eps);
+    double delayError = delayStd / std::max(std::abs(delay), eps);
+    return std::max(throughputError, delayError);
+}
+
+SurrogateModel::SurrogateModel()
+    : m_offset{}, m_scale{}, m_lengthScales{}, m_nugget(1e-4) {
+    m_scale.fill(1.0);
+    m_lengthScales.fill(1.0);
+}
+
+SurrogateModel::Features SurrogateModel::MakeFeatures(double lambda, double bufferSize, uint32_t packetSize,
+                                                      double dataRateMbps, uint32_t numNodes) {
+    return {lambda, bufferSize, static_cast<double>(packetSize),
+            dataRateMbps, static_cast<double>(numNodes)};
+}
+
+SurrogateModel::Features SurrogateModel::Normalize(const Features& features) const {
+    Features normalized;
+    for (size_t d = 0; d < kNumFeatures; ++d) {
+        normalized[d] = (features[d] - m_offset[d]) / m_scale[d];
+    }
+    return normalized;
+}
+
+bool SurrogateModel::Train(const std::vector<HistoryRecord>& history, const std::string& networkType) {
+    m_points.clear();
+    m_cholesky.clear();
+
+    std::vector<const HistoryRecord*> records;
+    for (const HistoryRecord& record : history) {
+        if (record.networkType != networkType) continue;
+        if (!std::isfinite(record.throughput) || !std::isfinite(record.delay) || !std::isfinite(record.packetLoss)) continue;
+        records.push_back(&record);
+    }
+    if (records.size() > kMaxTrainingPoints) {
+        records.erase(records.begin(), records.end() - kMaxTrainingPoints);
+    }
+    if (records.size() < kMinTrainingPoints) {
+        return false;
+    }
+
+    const size_t n = records.size();
+    std::vector<Features> raw(n);
+    std::vector<std::vector<double>> targets(kNumOutputs, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i) {
+        const HistoryRecord& r = *records[i];
+        raw[i] = MakeFeatures(r.lambda, r.nodeBufferMean, r.packetSize, r.dataRateMbps, r.numNodes);
+        targets[0][i] = r.throughput;
+        targets[1][i] = r.delay;
+        targets[2][i] = r.packetLoss;
+    }
+
+    // Нормировка признаков на [0, 1]; постоянный признак не влияет на расстояние
+    std::array<bool, kNumFeatures> varying{};
+    for (size_t d = 0; d < kNumFeatures; ++d) {
+        double low = raw[0][d];
+        double high = raw[0][d];
+        for (const Features& x : raw) {
+            low = std::min(low, x[d]);
+            high = std::max(high, x[d]);
+        }
+        m_offset[d] = low;
+        varying[d] = high > low;
+        m_scale[d] = varying[d] ? high - low : 1.0;
+    }
+    m_points.resize(n);
+    for (size_t i = 0; i < n; ++i) m_points[i] = Normalize(raw[i]);
+
+    // Центрирование выходов
+    std::vector<std::vector<double>> centered(kNumOutputs);
+    std::vector<double> outputVariance(kNumOutputs, 0.0);
+    for (size_t o = 0; o < kNumOutputs; ++o) {
+        double mean = 0.0;
+        for (double y : targets[o]) mean += y;
+        mean /= n;
+        m_outputs[o].mean = mean;
+
+        centered[o].resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            centered[o][i] = targets[o][i] - mean;
+            outputVariance[o] += centered[o][i] * centered[o][i];
+        }
+        outputVariance[o] /= n;
+    }
+
+    // Выбор гиперпараметров по скользящему контролю (кандидаты шага - параллельно)
+    struct Candidate {
+        Features lengthScales;
+        double nugget;
+    };
+    auto selectBest = [&](const std::vector<Candidate>& candidates, double& bestError) -> size_t {
+        std::mutex bestMutex;
+        size_t best = candidates.size();
+        WorkerPool::Shared().ParallelFor(candidates.size(), [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                double error = LeaveOneOutError(m_points, centered, outputVariance,
+                                                candidates[c].lengthScales, candidates[c].nugget);
+                std::lock_guard<std::mutex> lock(bestMutex);
+                if (error < bestError || (error == bestError && best < candidates.size() && c < best)) {
+                    bestError = error;
+                    best = c;
+                }
+            }
+        }, candidates.size());
+        return best;
+    };
+
+    std::vector<Candidate> candidates;
+    for (double lengthScale : kLengthScales) {
+        for (double nugget : kNuggets) {
+            Candidate candidate;
+            candidate.lengthScales.fill(lengthScale);
+            candidate.nugget = nugget;
+            candidates.push_back(candidate);
+        }
+    }
+
+    double bestError = std::numeric_limits<double>::infinity();
+    size_t best = selectBest(candidates, bestError);
+    if (best >= candidates.size()) {
+        m_points.clear();
+        return false;
+    }
+    m_lengthScales = candidates[best].lengthScales;
+    m_nugget = candidates[best].nugget;
+
+    for (int sweep = 0; sweep < kRefinementSweeps; ++sweep) {
+        for (size_t d = 0; d < kNumFeatures; ++d) {
+            if (!varying[d]) continue; // Признак не меняется в выборке
+            candidates.clear();
+            for (double multiplier : kScaleMultipliers) {
+                Candidate candidate{m_lengthScales, m_nugget};
+                candidate.lengthScales[d] *= multiplier;
+                candidates.push_back(candidate);
+            }
+            best = selectBest(candidates, bestError);
+            if (best < candidates.size()) {
+                m_lengthScales = candidates[best].lengthScales;
+            }
+        }
+    }
+
+    m_cholesky = BuildCovariance(m_points, m_lengthScales, m_nugget);
+    if (!Cholesky(m_cholesky, n)) {
+        m_points.clear();
+        m_cholesky.clear();
+        return false;
+    }
+
+    for (size_t o = 0; o < kNumOutputs; ++o) {
+        std::vector<double> alpha = centered[o];
+        SolveLower(m_cholesky, n, alpha);
+        double quadratic = 0.0;
+        for (double value : alpha) quadratic += value * value; // yᵀK⁻¹y = |L⁻¹y|²
+        SolveUpper(m_cholesky, n, alpha);
+
+        m_outputs[o].weights = alpha;
+        m_outputs[o].variance = quadratic / n;
+    }
+    return true;
+}
+
+bool SurrogateModel::IsTrained() const {
+    return !m_cholesky.empty();
+}
+
+size_t SurrogateModel::Samples() const {
+    return m_points.size();
+}
+
+const SurrogateModel::Features& SurrogateModel::LengthScales() const {
+    return m_lengthScales;
+}
+
+SurrogatePrediction SurrogateModel::Predict(const Features& features) const {
+    SurrogatePrediction prediction;
+    const double inf = std::numeric_limits<double>::infinity();
+    if (!IsTrained()) {
+        prediction.throughputStd = prediction.delayStd = prediction.packetLossStd = inf;
+        return prediction;
+    }
+
+    const size_t n = m_points.size();
+    const Features x = Normalize(features);
+    std::vector<double> k(n);
+    for (size_t i = 0; i < n; ++i) k[i] = Kernel(x, m_points[i], m_lengthScales);
+
+    // Дисперсия латентной функции: σ_f² (1 - kᵀK⁻¹k), kᵀK⁻¹k = |L⁻¹k|²
+    std::vector<double> v = k;
+    SolveLower(m_cholesky, n, v);
+    double explained = 0.0;
+    for (double value : v) explained += value * value;
+    double reduction = std::max(0.0, 1.0 - explained);
+
+    double values[kNumOutputs];
+    double deviations[kNumOutputs];
+    for (size_t o = 0; o < kNumOutputs; ++o) {
+        const Output& output = m_outputs[o];
+        double mean = output.mean;
+        for (size_t i = 0; i < n; ++i) mean += k[i] * output.weights[i];
+        values[o] = mean;
+        deviations[o] = std::sqrt(output.variance * reduction);
+    }
+
+    prediction.throughput = std::max(0.0, values[0]);
+    prediction.delay = std::max(0.0, values[1]);
+    prediction.packetLoss = std::min(1.0, std::max(0.0, values[2]));
+    prediction.throughputStd = deviations[0];
+    prediction.delayStd = deviations[1];
+    prediction.packetLossStd = deviations[2];
+    return prediction;
+}
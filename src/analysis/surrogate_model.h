@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../metrics/results_history.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Прогноз суррогатной модели с оценкой неопределённости (СКО прогноза).
+ */
+struct SurrogatePrediction {
+    double throughput = 0.0;
+    double delay = 0.0;
+    double packetLoss = 0.0;
+    double throughputStd = 0.0;
+    double delayStd = 0.0;
+    double packetLossStd = 0.0;
+
+    // max(СКО / |прогноз|) по пропускной способности и задержке
+    double RelativeUncertainty() const;
+};
+
+/**
+ * Суррогатная модель (кригинг / гауссовский процесс) результатов симуляции
+ * по признакам (lambda, bufferSize, packetSize, dataRateMbps, numNodes),
+ * где bufferSize - средняя ёмкость очередей узлов.
+ *
+ * Признаки нормируются на диапазон обучающей выборки. Ядро - гауссово
+ * с отдельным масштабом длины по каждому признаку (ARD), к диагонали
+ * добавляется «самородок» (шум симуляции). Гиперпараметры выбираются по
+ * ошибке скользящего контроля (leave-one-out), которая для ГП считается
+ * в замкнутой форме: сначала общий масштаб и самородок, затем покоординатное
+ * уточнение масштабов; кандидаты каждого шага проверяются параллельно.
+ * Для каждого выхода (пропускная способность, задержка, потери) оцениваются
+ * своё среднее и дисперсия.
+ */
+class SurrogateModel {
+public:
+    static constexpr size_t kNumFeatures = 5;
+    static constexpr size_t kNumOutputs = 3;
+    static constexpr size_t kMinTrainingPoints = 8;
+    static constexpr size_t kMaxTrainingPoints = 1000;
+
+    using Features = std::array<double, kNumFeatures>;
+
+    SurrogateModel();
+
+    // bufferSize - средняя ёмкость очередей узлов (SimulationConfig::MeanNodeBufferSize)
+    static Features MakeFeatures(double lambda, double bufferSize, uint32_t packetSize,
+                                 double dataRateMbps, uint32_t numNodes);
+
+    /**
+     * Обучение по записям истории с NetworkType == networkType
+     * (используются последние kMaxTrainingPoints записей). Остальные параметры
+     * сети признаками не являются: history должна содержать только записи
+     * с Settings запроса (ResultsHistory::LoadMatching).
+     * false - недостаточно точек, модель не обучена.
+     */
+    bool Train(const std::vector<HistoryRecord>& history, const std::string& networkType);
+
+    bool IsTrained() const;
+    size_t Samples() const;
+    const Features& LengthScales() const;
+
+    SurrogatePrediction Predict(const Features& features) const;
+
+private:
+    struct Output {
+        double mean = 0.0;
+        double variance = 0.0;       // σ_f² (оценка максимального правдоподобия)
+        std::vector<double> weights; // (K + σ_n² I)⁻¹ (y - mean)
+    };
+
+    Features Normalize(const Features& features) const;
+
+    std::vector<Features> m_points; // Нормированные точки обучения
+    Features m_offset;
+    Features m_scale;
+    Features m_lengthScales;
+    double m_nugget;
+    std::vector<double> m_cholesky; // Нижнетреугольный множитель (n × n, построчно)
+    std::array<Output, kNumOutputs> m_outputs;
+};
@@ -0,0 +1,208 @@
+#include "tandem_decomposition.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Стационарные характеристики M/M/1/K, устойчивые при ρ >> 1 и больших K
+struct Subsystem {
+    double p0 = 1.0;
+    double pK = 0.0;
+    double avgSystemSize = 0.0;
+};
+
+// Среднее число заявок M/M/1/K при ρ < 1
+double MeanSize(double rho, double K) {
+    const double rhoK = std::pow(rho, K);
+    const double rhoK1 = rhoK * rho;
+    return rho * (1.0 - (K + 1.0) * rhoK + K * rhoK1) / ((1.0 - rho) * (1.0 - rhoK1));
+}
+
+Subsystem Evaluate(double arrival, double mu, uint32_t capacity) {
+    Subsystem s;
+    if (arrival <= 0.0 || mu <= 0.0) return s;
+    const double K = static_cast<double>(std::max<uint32_t>(capacity, 1));
+    const double rho = arrival / mu;
+
+    if (std::abs(rho - 1.0) < 1e-9) {
+        s.p0 = s.pK = 1.0 / (K + 1.0);
+        s.avgSystemSize = K / 2.0;
+    } else if (rho < 1.0) {
+        s.p0 = (1.0 - rho) / (1.0 - std::pow(rho, K + 1.0));
+        s.pK = s.p0 * std::pow(rho, K);
+        s.avgSystemSize = MeanSize(rho, K);
+    } else {
+        // Симметрия n -> K - n: распределение M/M/1/K с r = 1/ρ, отсчитанное от K
+        const double r = 1.0 / rho;
+        s.pK = (1.0 - r) / (1.0 - std::pow(r, K + 1.0));
+        s.p0 = s.pK * std::pow(r, K);
+        s.avgSystemSize = K - MeanSize(r, K);
+    }
+    return s;
+}
+
+} // namespace
+
+TandemNetworkResult TandemDecomposition::Solve(const TandemNetwork& network,
+                                               double tolerance,
+                                               int maxIterations) {
+    TandemNetworkResult result;
+    const size_t M = network.serviceRates.size();
+    if (M == 0 || network.externalArrivals.size() != M || network.capacities.size() != M ||
+        network.next.size() != M) {
+        return result;
+    }
+    for (double mu : network.serviceRates) {
+        if (mu <= 0.0) return result;
+    }
+
+    // Порядок от входов к выходу (Кан); станции вне порядка - цикл
+    std::vector<size_t> predecessorCount(M, 0);
+    for (size_t i = 0; i < M; ++i) {
+        const int j = network.next[i];
+        if (j >= static_cast<int>(M)) return result;
+        if (j >= 0) ++predecessorCount[j];
+    }
+    std::vector<size_t> order;
+    order.reserve(M);
+    for (size_t i = 0; i < M; ++i) {
+        if (predecessorCount[i] == 0) order.push_back(i);
+    }
+    for (size_t k = 0; k < order.size(); ++k) {
+        const int j = network.next[order[k]];
+        if (j >= 0 && --predecessorCount[j] == 0) order.push_back(static_cast<size_t>(j));
+    }
+    if (order.size() != M) return result;
+
+    // Предшественники станций в формате CSR
+    std::vector<size_t> inOffsets(M + 1, 0);
+    for (size_t i = 0; i < M; ++i) {
+        if (network.next[i] >= 0) ++inOffsets[network.next[i] + 1];
+    }
+    for (size_t j = 0; j < M; ++j) inOffsets[j + 1] += inOffsets[j];
+    std::vector<size_t> inSources(inOffsets[M]);
+    std::vector<size_t> fill(inOffsets.begin(), inOffsets.end() - 1);
+    for (size_t i = 0; i < M; ++i) {
+        if (network.next[i] >= 0) inSources[fill[network.next[i]]++] = i;
+    }
+
+    // upstream[i] - интенсивность станции i как входа следующей подсистемы (с учётом простоя),
+    // downstream[i] - как выхода своей подсистемы (с учётом блокировки)
+    std::vector<double> upstream(network.serviceRates);
+    std::vector<double> downstream(network.serviceRates);
+    std::vector<double> external(M);
+    std::vector<Subsystem> subsystems(M);
+    std::vector<double> throughput(M, 0.0);
+    for (size_t j = 0; j < M; ++j) external[j] = std::max(0.0, network.externalArrivals[j]);
+
+    auto evaluate = [&](size_t j) {
+        double arrival = external[j];
+        for (size_t e = inOffsets[j]; e < inOffsets[j + 1]; ++e) arrival += upstream[inSources[e]];
+        subsystems[j] = Evaluate(arrival, downstream[j], network.capacities[j]);
+        throughput[j] = arrival * (1.0 - subsystems[j].pK);
+    };
+    for (size_t j : order) evaluate(j);
+
+    for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+        // От входов к выходу: простой станции i = 1 - X_i / μ_i^d, поэтому
+        //   1 / μ_i^u = 1 / μ_i + 1 / X_i - 1 / μ_i^d
+        for (size_t j : order) {
+            for (size_t e = inOffsets[j]; e < inOffsets[j + 1]; ++e) {
+                const size_t i = inSources[e];
+                if (throughput[i] <= 0.0) continue;
+                upstream[i] = 1.0 / (1.0 / network.serviceRates[i] + 1.0 / throughput[i] - 1.0 / downstream[i]);
+            }
+            evaluate(j);
+        }
+
+        // От выхода к входам: блокировка станции i = 1 - X_i / μ_i^u, X_i = μ_i^u (1 - P_K(next)), поэтому
+        //   1 / μ_i^d = 1 / μ_i + 1 / X_i - 1 / μ_i^u
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            const size_t i = *it;
+            const int j = network.next[i];
+            if (j < 0) continue;
+            const double passed = upstream[i] * (1.0 - subsystems[j].pK);
+            if (passed <= 0.0) continue;
+            downstream[i] = 1.0 / (1.0 / network.serviceRates[i] + 1.0 / passed - 1.0 / upstream[i]);
+            evaluate(i);
+        }
+
+        // Невязка сохранения потока на каждом переходе i -> next[i]
+        double maxDelta = 0.0;
+        double maxRate = 0.0;
+        for (size_t i = 0; i < M; ++i) {
+            maxRate = std::max(maxRate, throughput[i]);
+            const int j = network.next[i];
+            if (j < 0) continue;
+            maxDelta = std::max(maxDelta, std::abs(throughput[i] - upstream[i] * (1.0 - subsystems[j].pK)));
+        }
+        result.iterations = iteration;
+        result.residual = maxDelta / std::max(1.0, maxRate);
+        if (result.residual < tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    // Характеристики станций
+    result.arrivalRate.assign(M, 0.0);
+    result.effectiveServiceRate = downstream;
+    result.throughput = throughput;
+    result.blockingProbability.assign(M, 0.0);
+    result.starvationProbability.assign(M, 0.0);
+    result.lossProbability.assign(M, 0.0);
+    result.avgSystemSize.assign(M, 0.0);
+    result.delay.assign(M, 0.0);
+    result.pathDelay.assign(M, 0.0);
+    for (size_t j = 0; j < M; ++j) {
+        const Subsystem& s = subsystems[j];
+        result.arrivalRate[j] = (s.pK < 1.0) ? throughput[j] / (1.0 - s.pK) : 0.0;
+        result.starvationProbability[j] = s.p0;
+        result.blockingProbability[j] = std::max(0.0, throughput[j] / downstream[j] - throughput[j] / network.serviceRates[j]);
+        result.lossProbability[j] = s.pK;
+        result.avgSystemSize[j] = s.avgSystemSize;
+        result.delay[j] = (throughput[j] > 0.0) ? s.avgSystemSize / throughput[j] : 0.0;
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const size_t i = *it;
+        const int j = network.next[i];
+        result.pathDelay[i] = result.delay[i] + ((j >= 0) ? result.pathDelay[j] : 0.0);
+        if (j < 0) result.throughputOut += throughput[i];
+    }
+
+    double accepted = 0.0;
+    double weightedDelay = 0.0;
+    for (size_t i = 0; i < M; ++i) {
+        const double rate = external[i] * (1.0 - result.lossProbability[i]);
+        accepted += rate;
+        weightedDelay += rate * result.pathDelay[i];
+    }
+    result.endToEndDelay = (accepted > 0.0) ? weightedDelay / accepted : 0.0;
+    return result;
+}
+
+TandemNetwork TandemDecomposition::FromRouting(const JacksonNetwork& routing) {
+    TandemNetwork network;
+    const size_t M = routing.serviceRates.size();
+    if (routing.externalArrivals.size() != M || routing.capacities.size() != M) {
+        return network;
+    }
+    network.externalArrivals = routing.externalArrivals;
+    network.serviceRates = routing.serviceRates;
+    network.capacities.resize(M);
+    network.next.assign(M, -1);
+    for (size_t i = 0; i < M; ++i) {
+        network.capacities[i] = std::max<uint32_t>(routing.capacities[i], 1);
+        if (routing.rowOffsets.empty()) continue;
+        const size_t begin = routing.rowOffsets[i];
+        const size_t end = routing.rowOffsets[i + 1];
+        if (end == begin) continue;
+        // Блокировка после обслуживания определена только для одного преемника
+        if (end - begin > 1 || std::abs(routing.probabilities[begin] - 1.0) > 1e-9) {
+            return TandemNetwork();
+        }
+        network.next[i] = static_cast<int>(routing.columns[begin]);
+    }
+    return network;
+}
@@ -0,0 +1,177 @@
+#include "transient_analysis.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Наибольшее Λδ одного шага униформизации
+const double kMaxStepRate = 50.0;
+
+// Разогрев ищется не дальше kMaxWarmupRelaxations времён релаксации
+const double kMaxWarmupRelaxations = 100.0;
+
+// Переход v <- v P, P = I + Q / Λ для M/M/1/K
+void Multiply(const std::vector<double>& v, std::vector<double>& out, double a, double s) {
+    // a = λ / Λ, s = μ / Λ
+    const size_t K = v.size() - 1;
+    out[0] = v[0] * (1.0 - a) + v[1] * s;
+    for (size_t n = 1; n < K; ++n) {
+        out[n] = v[n - 1] * a + v[n] * (1.0 - a - s) + v[n + 1] * s;
+    }
+    out[K] = v[K - 1] * a + v[K] * (1.0 - s);
+}
+
+// Продвижение распределения p на время t
+void Advance(std::vector<double>& p, double lambda, double mu, double t, double epsilon) {
+    if (t <= 0.0) return;
+    const double rate = lambda + mu;
+    const double a = lambda / rate;
+    const double s = mu / rate;
+    const int steps = std::max(1, static_cast<int>(std::ceil(rate * t / kMaxStepRate)));
+    const double q = rate * t / steps;
+
+    std::vector<double> term(p.size());
+    std::vector<double> next(p.size());
+    std::vector<double> sum(p.size());
+    for (int step = 0; step < steps; ++step) {
+        double weight = std::exp(-q);
+        double accumulated = weight;
+        term = p;
+        for (size_t n = 0; n < p.size(); ++n) sum[n] = weight * term[n];
+        for (int k = 1; 1.0 - accumulated > epsilon && k < 100000; ++k) {
+            Multiply(term, next, a, s);
+            term.swap(next);
+            weight *= q / k;
+            accumulated += weight;
+            for (size_t n = 0; n < p.size(); ++n) sum[n] += weight * term[n];
+        }
+        // Нормировка компенсирует отброшенный остаток ряда
+        for (size_t n = 0; n < p.size(); ++n) p[n] = sum[n] / accumulated;
+    }
+}
+
+std::vector<double> EmptyState(int capacity) {
+    std::vector<double> p(static_cast<size_t>(std::max(capacity, 1)) + 1, 0.0);
+    p[0] = 1.0;
+    return p;
+}
+
+double TotalVariation(const std::vector<double>& p, const std::vector<double>& pi) {
+    double distance = 0.0;
+    for (size_t n = 0; n < p.size(); ++n) distance += std::abs(p[n] - pi[n]);
+    return 0.5 * distance;
+}
+
+} // namespace
+
+std::vector<double> TransientMM1K::Distribution(double lambda, double mu, int capacity, double t,
+                                                double epsilon) {
+    std::vector<double> p = EmptyState(capacity);
+    if (lambda <= 0.0 || mu <= 0.0) return p;
+    Advance(p, lambda, mu, t, epsilon);
+    return p;
+}
+
+std::vector<std::vector<double>> TransientMM1K::Trajectory(double lambda, double mu, int capacity,
+                                                           const std::vector<double>& times,
+                                                           double epsilon) {
+    std::vector<std::vector<double>> trajectory;
+    trajectory.reserve(times.size());
+    std::vector<double> p = EmptyState(capacity);
+    double current = 0.0;
+    for (double t : times) {
+        if (lambda > 0.0 && mu > 0.0 && t > current) {
+            Advance(p, lambda, mu, t - current, epsilon);
+            current = t;
+        }
+        trajectory.push_back(p);
+    }
+    return trajectory;
+}
+
+std::vector<double> TransientMM1K::Stationary(double lambda, double mu, int capacity) {
+    std::vector<double> pi = EmptyState(capacity);
+    if (lambda <= 0.0 || mu <= 0.0) return pi;
+    // π_n ∝ ρ^n, нормировка от наибольшего члена (устойчиво при ρ > 1)
+    const double rho = lambda / mu;
+    const size_t K = pi.size() - 1;
+    const double logRho = std::log(rho);
+    const double logMax = (rho > 1.0) ? K * logRho : 0.0;
+    double total = 0.0;
+    for (size_t n = 0; n <= K; ++n) {
+        pi[n] = std::exp(n * logRho - logMax);
+        total += pi[n];
+    }
+    for (double& value : pi) value /= total;
+    return pi;
+}
+
+double TransientMM1K::RelaxationTime(double lambda, double mu, int capacity) {
+    if (lambda <= 0.0 || mu <= 0.0) return 0.0;
+    const double K = static_cast<double>(std::max(capacity, 1));
+    const double gap = lambda + mu - 2.0 * std::sqrt(lambda * mu) * std::cos(M_PI / (K + 1.0));
+    return (gap > 0.0) ? 1.0 / gap : 0.0;
+}
+
+double TransientMM1K::WarmupTime(double lambda, double mu, int capacity, double tolerance) {
+    const double relaxation = RelaxationTime(lambda, mu, capacity);
+    if (relaxation <= 0.0) return 0.0;
+
+    const std::vector<double> pi = Stationary(lambda, mu, capacity);
+    std::vector<double> p = EmptyState(capacity);
+    const double step = relaxation / 4.0;
+    double t = 0.0;
+    while (TotalVariation(p, pi) > tolerance && t < kMaxWarmupRelaxations * relaxation) {
+        Advance(p, lambda, mu, step, 1e-12);
+        t += step;
+    }
+    return t;
+}
+
+double TransientMM1K::AsymptoticVariance(double lambda, double mu, int capacity) {
+    if (lambda <= 0.0 || mu <= 0.0) return 0.0;
+    const std::vector<double> pi = Stationary(lambda, mu, capacity);
+    double mean = 0.0;
+    for (size_t n = 0; n < pi.size(); ++n) mean += n * pi[n];
+
+    // Σ_{m<=n} π_m (m - L) = -Σ_{m>n} π_m (m - L): берётся сумма по меньшей части
+    // распределения, иначе при π_n -> 0 ошибка округления делится на π_n
+    const size_t K = pi.size() - 1;
+    std::vector<double> tail(K + 1, 0.0);
+    std::vector<double> tailMass(K + 1, 0.0);
+    for (size_t n = K; n > 0; --n) {
+        tail[n - 1] = tail[n] + pi[n] * (n - mean);
+        tailMass[n - 1] = tailMass[n] + pi[n];
+    }
+    double variance = 0.0;
+    double head = 0.0;
+    for (size_t n = 0; n < K; ++n) {
+        head += pi[n] * (n - mean);
+        const double partial = (tailMass[n] < 0.5) ? -tail[n] : head;
+        if (pi[n] > 0.0) variance += partial * partial / (lambda * pi[n]);
+    }
+    return 2.0 * variance;
+}
+
+RunLengthPlan TransientMM1K::PlanRunLength(double lambda, double mu, int capacity, double precision,
+                                           double z, double warmupTolerance) {
+    RunLengthPlan plan;
+    if (lambda <= 0.0 || mu <= 0.0 || precision <= 0.0) return plan;
+
+    const std::vector<double> pi = Stationary(lambda, mu, capacity);
+    for (size_t n = 0; n < pi.size(); ++n) plan.meanSize += n * pi[n];
+    plan.throughput = lambda * (1.0 - pi.back());
+    plan.relaxationTime = RelaxationTime(lambda, mu, capacity);
+    plan.warmupTime = WarmupTime(lambda, mu, capacity, warmupTolerance);
+    plan.asymptoticVariance = AsymptoticVariance(lambda, mu, capacity);
+
+    const double sizeLength = (plan.meanSize > 0.0)
+        ? plan.asymptoticVariance * z * z / std::pow(precision * plan.meanSize, 2)
+        : 0.0;
+    const double throughputLength = (plan.throughput > 0.0)
+        ? z * z / (precision * precision * plan.throughput)
+        : 0.0;
+    plan.runLength = std::max(sizeLength, throughputLength);
+    return plan;
+}
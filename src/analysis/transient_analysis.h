@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Длительность прогона для оценки среднего с заданной точностью.
+ * Отсчёт времени - от момента, когда источник начинает передавать в пустую очередь.
+ */
+struct RunLengthPlan {
+    double relaxationTime = 0.0;      // 1 / (спектральная щель генератора)
+    double warmupTime = 0.0;          // Расстояние по вариации до стационарного <= warmupTolerance
+    double meanSize = 0.0;            // Стационарное L
+    double throughput = 0.0;          // λ (1 - p_K)
+    double asymptoticVariance = 0.0;  // σ² = lim T Var(среднее N за T)
+    double runLength = 0.0;           // Длина интервала измерений после разогрева
+};
+
+/**
+ * Нестационарный анализ M/M/1/K (K - ёмкость системы, не меньше 1).
+ *
+ * p(t) из пустого состояния вычисляется униформизацией:
+ *   p(t) = Σ_k e^{-Λt} (Λt)^k / k! p(0) P^k,  P = I + Q / Λ,  Λ = λ + μ,
+ * ряд обрывается, когда остаток весов Пуассона меньше epsilon; большое Λt
+ * делится на шаги с Λδ <= 50, чтобы e^{-Λδ} не исчезало.
+ */
+class TransientMM1K {
+public:
+    // p_n(t), n = 0..K, в момент t при старте из пустой системы
+    static std::vector<double> Distribution(double lambda, double mu, int capacity, double t,
+                                            double epsilon = 1e-12);
+
+    // p(t) на возрастающей сетке times (каждая точка - продолжение от предыдущей)
+    static std::vector<std::vector<double>> Trajectory(double lambda, double mu, int capacity,
+                                                       const std::vector<double>& times,
+                                                       double epsilon = 1e-12);
+
+    // Стационарное распределение π_n
+    static std::vector<double> Stationary(double lambda, double mu, int capacity);
+
+    /**
+     * Время релаксации 1 / γ: собственные числа генератора M/M/1/K -
+     * 0 и λ + μ - 2 √(λμ) cos(jπ / (K + 1)), j = 1..K, поэтому
+     * γ = λ + μ - 2 √(λμ) cos(π / (K + 1)).
+     */
+    static double RelaxationTime(double lambda, double mu, int capacity);
+
+    // Наименьшее t (с шагом в четверть времени релаксации), при котором ||p(t) - π||_TV <= tolerance
+    static double WarmupTime(double lambda, double mu, int capacity, double tolerance);
+
+    /**
+     * Асимптотическая дисперсия среднего по времени числа заявок (формула
+     * для процессов рождения-гибели):
+     *   σ² = 2 Σ_{n=0}^{K-1} (Σ_{m<=n} π_m (m - L))² / (λ π_n).
+     */
+    static double AsymptoticVariance(double lambda, double mu, int capacity);
+
+    /**
+     * Разогрев и длительность измерений, при которых полуширина доверительного
+     * интервала (z - квантиль нормального распределения) для L и для
+     * пропускной способности не превышает precision от оценки:
+     *   T_L = σ² z² / (precision L)²,  T_X = z² / (precision² X),
+     * где число обслуженных заявок приближённо считается пуассоновским.
+     */
+    static RunLengthPlan PlanRunLength(double lambda, double mu, int capacity, double precision,
+                                       double z = 1.96, double warmupTolerance = 0.01);
+};
@@ -4,6 +4,7 @@
 #include <cctype>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <stdexcept>
 
 SimulationConfig::SimulationConfig()
@@ -31,7 +32,92 @@ SimulationConfig::SimulationConfig()
       udpClientPortStart(2000),
       buzenCustomersMultiplier(2.0),
       serviceRate(5.0),
-      numGroups(3) {}
+      numGroups(3),
+      calibrationEnabled(true),
+      surrogateEnabled(false),
+      surrogateMaxUncertainty(0.05),
+      sweepDesign("none"),
+      sweepSamples(16),
+      sweepLevels(3),
+      sweepWorkers(0),
+      sweepSeed(1),
+      sweepPointId(-1),
+      bufferBudget(0),
+      bufferDelayWeight(0.05),
+      bufferConfirmCandidates(3),
+      warmupTime(0.0),
+      autoDuration(false),
+      durationPrecision(0.05),
+      warmupTolerance(0.01),
+      serviceScv(0.0),
+      packetTrace(false),
+      packetTraceSampling(1.0),
+      trafficModel("cbr"),
+      trafficTraceFile(""),
+      trafficTraceTimeScale(0.0),
+      trafficOnOffDistribution("pareto"),
+      trafficHurst(0.8),
+      trafficOnMeanS(0.1),
+      trafficOffMeanS(0.4),
+      groupRouting("global"),
+      groupQueueDisc("none"),
+      backboneTopology("ring"),
+      backboneTreeFanout(2),
+      backboneRateFactor(2.0),
+      backboneDelayMs(-1.0),
+      adhocRouting("none"),
+      wifiChannelWidth(0),
+      wifiRateManager("ideal"),
+      wifiAmpduSize(-1),
+      wifiAmsduSize(-1) {}
+
+uint32_t SimulationConfig::NodeBufferSize(uint32_t nodeId) const {
+    if (nodeId < nodeBuffers.size() && nodeBuffers[nodeId] > 0) {
+        return nodeBuffers[nodeId];
+    }
+    return bufferSize;
+}
+
+double SimulationConfig::MeanNodeBufferSize() const {
+    if (numNodes == 0) {
+        return bufferSize;
+    }
+    double total = 0.0;
+    for (uint32_t i = 0; i < numNodes; ++i) {
+        total += NodeBufferSize(i);
+    }
+    return total / numNodes;
+}
+
+double SimulationConfig::NodeServiceRate(uint32_t nodeId) const {
+    if (nodeId < nodeServiceRates.size() && nodeServiceRates[nodeId] > 0.0) {
+        return nodeServiceRates[nodeId];
+    }
+    return serviceRate;
+}
+
+double SimulationConfig::NodeHurst(uint32_t nodeId) const {
+    if (nodeId < nodeHursts.size() && nodeHursts[nodeId] > 0.0) {
+        return nodeHursts[nodeId];
+    }
+    return trafficHurst;
+}
+
+double SimulationConfig::NodeDataRateMbps(uint32_t nodeId) const {
+    if (serviceRate <= 0.0) {
+        return dataRateMbps;
+    }
+    return dataRateMbps * NodeServiceRate(nodeId) / serviceRate;
+}
+
+bool SimulationConfig::HasHeterogeneousServiceRates() const {
+    for (uint32_t i = 0; i < numNodes; ++i) {
+        if (NodeServiceRate(i) != serviceRate) {
+            return true;
+        }
+    }
+    return false;
+}
 
 SimulationConfig EnvironmentConfig::Load(const std::string& filename) {
     SimulationConfig config;
@@ -103,6 +189,20 @@ SimulationConfig EnvironmentConfig::Load(const std::string& filename) {
         }
     }
 
+    for (size_t nodeId = config.numNodes; nodeId < config.nodeServiceRates.size(); ++nodeId) {
+        if (config.nodeServiceRates[nodeId] > 0.0) {
+            throw std::runtime_error("NODE_" + std::to_string(nodeId) + "_SERVICE_RATE is out of range for declared NUM_NODES");
+        }
+    }
+    config.nodeServiceRates.resize(config.numNodes, 0.0);
+
+    for (size_t nodeId = config.numNodes; nodeId < config.nodeHursts.size(); ++nodeId) {
+        if (config.nodeHursts[nodeId] > 0.0) {
+            throw std::runtime_error("NODE_" + std::to_string(nodeId) + "_HURST is out of range for declared NUM_NODES");
+        }
+    }
+    config.nodeHursts.resize(config.numNodes, 0.0);
+
     if (nodeLoadKeys.size() != config.numNodes) {
         throw std::runtime_error("Expected NODE_X_LOAD entries for all nodes in range [0, " + std::to_string(config.numNodes - 1) + "]");
     }
@@ -119,6 +219,109 @@ SimulationConfig EnvironmentConfig::Load(const std::string& filename) {
         throw std::runtime_error("nodeBuffers size mismatch with NUM_NODES");
     }
 
+    if (config.warmupTime < 0.0 || config.warmupTime >= config.simulationDuration) {
+        throw std::runtime_error("WARMUP_TIME must be in [0, SIMULATION_DURATION)");
+    }
+
+    if (config.durationPrecision <= 0.0 || config.warmupTolerance <= 0.0 || config.warmupTolerance >= 1.0) {
+        throw std::runtime_error("DURATION_PRECISION must be positive and WARMUP_TOLERANCE in (0, 1)");
+    }
+
+    if (config.serviceScv < 0.0) {
+        throw std::runtime_error("SERVICE_SCV must be non-negative");
+    }
+
+    if (config.packetTraceSampling <= 0.0 || config.packetTraceSampling > 1.0) {
+        throw std::runtime_error("PACKET_TRACE_SAMPLING must be in (0, 1]");
+    }
+
+    if (config.trafficModel != "cbr" && config.trafficModel != "trace" && config.trafficModel != "onoff") {
+        throw std::runtime_error("Unknown TRAFFIC_MODEL: " + config.trafficModel + " (expected cbr, trace or onoff)");
+    }
+
+    if (config.trafficOnOffDistribution != "pareto" && config.trafficOnOffDistribution != "lognormal") {
+        throw std::runtime_error("Unknown TRAFFIC_ONOFF_DISTRIBUTION: " + config.trafficOnOffDistribution +
+                                 " (expected pareto or lognormal)");
+    }
+
+    for (uint32_t i = 0; i < config.numNodes; ++i) {
+        if (config.NodeHurst(i) < 0.5 || config.NodeHurst(i) >= 1.0) {
+            throw std::runtime_error("TRAFFIC_HURST and NODE_X_HURST must be in [0.5, 1)");
+        }
+    }
+
+    if (config.trafficOnMeanS <= 0.0 || config.trafficOffMeanS <= 0.0) {
+        throw std::runtime_error("TRAFFIC_ON_MEAN_S and TRAFFIC_OFF_MEAN_S must be greater than zero");
+    }
+
+    if (config.trafficModel == "trace" && config.trafficTraceFile.empty()) {
+        throw std::runtime_error("TRAFFIC_MODEL=trace requires TRAFFIC_TRACE_FILE");
+    }
+
+    if (config.trafficTraceTimeScale < 0.0) {
+        throw std::runtime_error("TRAFFIC_TRACE_TIME_SCALE must be non-negative");
+    }
+
+    if (config.groupRouting != "global" && config.groupRouting != "static") {
+        throw std::runtime_error("Unknown GROUP_ROUTING: " + config.groupRouting + " (expected global or static)");
+    }
+
+    if (config.adhocRouting != "none" && config.adhocRouting != "static" &&
+        config.adhocRouting != "olsr" && config.adhocRouting != "aodv") {
+        throw std::runtime_error("Unknown ADHOC_ROUTING: " + config.adhocRouting + " (expected none, static, olsr or aodv)");
+    }
+
+    if (config.gridWidth == 0) {
+        throw std::runtime_error("GRID_WIDTH must be greater than zero");
+    }
+
+    if (config.backboneTopology != "ring" && config.backboneTopology != "star" &&
+        config.backboneTopology != "mesh" && config.backboneTopology != "tree") {
+        throw std::runtime_error("Unknown BACKBONE_TOPOLOGY: " + config.backboneTopology +
+                                 " (expected ring, star, mesh or tree)");
+    }
+
+    if (config.backboneTreeFanout == 0 || config.backboneRateFactor <= 0.0) {
+        throw std::runtime_error("BACKBONE_TREE_FANOUT and BACKBONE_RATE_FACTOR must be greater than zero");
+    }
+
+    static const std::unordered_set<std::string> queueDiscs = {"default", "none", "codel", "fq_codel", "pie", "red"};
+    if (!queueDiscs.count(config.groupQueueDisc)) {
+        throw std::runtime_error("Unknown GROUP_QUEUE_DISC: " + config.groupQueueDisc +
+                                 " (expected default, none, codel, fq_codel, pie or red)");
+    }
+
+    // Наибольшие ширина канала и размеры A-MPDU / A-MSDU по стандарту (0 - нет агрегации)
+    struct WifiLimits { uint32_t channelWidth; int ampdu; int amsdu; };
+    static const std::map<std::string, WifiLimits> wifiLimits = {
+        {"80211a", {20, 0, 0}},
+        {"80211b", {0, 0, 0}},
+        {"80211g", {20, 0, 0}},
+        {"80211n", {40, 65535, 7935}},
+        {"80211ac", {160, 1048575, 11398}},
+        {"80211ax", {160, 6500631, 11398}}
+    };
+    auto limits = wifiLimits.find(config.wifiStandard);
+    if (limits == wifiLimits.end()) {
+        throw std::runtime_error("Unknown WIFI_STANDARD: " + config.wifiStandard +
+                                 " (expected 80211a, 80211b, 80211g, 80211n, 80211ac or 80211ax)");
+    }
+    const uint32_t width = config.wifiChannelWidth;
+    if (width != 0 && (width > limits->second.channelWidth || (width != 20 && width != 40 && width != 80 && width != 160))) {
+        throw std::runtime_error("WIFI_CHANNEL_WIDTH " + std::to_string(width) + " MHz is not supported by " + config.wifiStandard);
+    }
+    if (config.wifiRateManager != "ideal" && config.wifiRateManager != "constant" && config.wifiRateManager != "minstrel") {
+        throw std::runtime_error("Unknown WIFI_RATE_MANAGER: " + config.wifiRateManager + " (expected ideal, constant or minstrel)");
+    }
+    if (config.wifiAmpduSize < -1 || config.wifiAmpduSize > limits->second.ampdu) {
+        throw std::runtime_error("WIFI_AMPDU_SIZE must be in [0, " + std::to_string(limits->second.ampdu) +
+                                 "] for " + config.wifiStandard);
+    }
+    if (config.wifiAmsduSize < -1 || config.wifiAmsduSize > limits->second.amsdu) {
+        throw std::runtime_error("WIFI_AMSDU_SIZE must be in [0, " + std::to_string(limits->second.amsdu) +
+                                 "] for " + config.wifiStandard);
+    }
+
     std::cout << "Config loaded from: " << filename << std::endl;
     return config;
 }
@@ -153,6 +356,144 @@ void EnvironmentConfig::ProcessConfigValue(SimulationConfig& config,
     } else if (key == "GRAPH_INTERPOLATION_POINTS") {
         config.graphInterpolationPoints = std::stoi(value);
         scalarKeys.insert(key);
+    } else if (key == "CALIBRATION_ENABLED") {
+        config.calibrationEnabled = (value == "1" || value == "true" || value == "TRUE");
+    } else if (key == "SURROGATE_ENABLED") {
+        config.surrogateEnabled = (value == "1" || value == "true" || value == "TRUE");
+    } else if (key == "SURROGATE_MAX_UNCERTAINTY") {
+        config.surrogateMaxUncertainty = std::stod(value);
+    } else if (key == "SWEEP_DESIGN") {
+        config.sweepDesign = value;
+    } else if (key == "SWEEP_SAMPLES") {
+        config.sweepSamples = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "SWEEP_LEVELS") {
+        config.sweepLevels = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "SWEEP_WORKERS") {
+        config.sweepWorkers = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "SWEEP_SEED") {
+        config.sweepSeed = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "BUFFER_BUDGET") {
+        config.bufferBudget = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "BUFFER_DELAY_WEIGHT") {
+        config.bufferDelayWeight = std::stod(value);
+    } else if (key == "BUFFER_CONFIRM_CANDIDATES") {
+        config.bufferConfirmCandidates = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "WARMUP_TIME") {
+        config.warmupTime = std::stod(value);
+    } else if (key == "AUTO_DURATION") {
+        config.autoDuration = (value == "1" || value == "true" || value == "TRUE");
+    } else if (key == "DURATION_PRECISION") {
+        config.durationPrecision = std::stod(value);
+    } else if (key == "WARMUP_TOLERANCE") {
+        config.warmupTolerance = std::stod(value);
+    } else if (key == "SERVICE_SCV") {
+        config.serviceScv = std::stod(value);
+    } else if (key == "PACKET_TRACE") {
+        config.packetTrace = (value == "1" || value == "true" || value == "TRUE");
+    } else if (key == "PACKET_TRACE_SAMPLING") {
+        config.packetTraceSampling = std::stod(value);
+    } else if (key == "TRAFFIC_MODEL") {
+        config.trafficModel = value;
+    } else if (key == "TRAFFIC_TRACE_FILE") {
+        config.trafficTraceFile = value;
+    } else if (key == "TRAFFIC_TRACE_TIME_SCALE") {
+        config.trafficTraceTimeScale = std::stod(value);
+    } else if (key == "TRAFFIC_ONOFF_DISTRIBUTION") {
+        config.trafficOnOffDistribution = value;
+    } else if (key == "TRAFFIC_HURST") {
+        config.trafficHurst = std::stod(value);
+    } else if (key == "TRAFFIC_ON_MEAN_S") {
+        config.trafficOnMeanS = std::stod(value);
+    } else if (key == "TRAFFIC_OFF_MEAN_S") {
+        config.trafficOffMeanS = std::stod(value);
+    } else if (key == "GROUP_ROUTING") {
+        config.groupRouting = value;
+    } else if (key == "BACKBONE_TOPOLOGY") {
+        config.backboneTopology = value;
+    } else if (key == "BACKBONE_TREE_FANOUT") {
+        config.backboneTreeFanout = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "BACKBONE_RATE_FACTOR") {
+        config.backboneRateFactor = std::stod(value);
+    } else if (key == "BACKBONE_DELAY_MS") {
+        config.backboneDelayMs = std::stod(value);
+    } else if (key.rfind("BACKBONE_LINK_", 0) == 0 && key.find("_RATE_MBPS") != std::string::npos) {
+        size_t linkId = std::stoul(key.substr(14, key.find("_RATE_MBPS") - 14));
+        double rate = std::stod(value);
+        if (rate <= 0.0) {
+            throw std::runtime_error(key + " must be greater than zero");
+        }
+        if (linkId >= config.backboneLinkRates.size()) {
+            config.backboneLinkRates.resize(linkId + 1, 0.0);
+        }
+        config.backboneLinkRates[linkId] = rate;
+    } else if (key == "GROUP_QUEUE_DISC") {
+        config.groupQueueDisc = value;
+    } else if (key == "ADHOC_ROUTING") {
+        config.adhocRouting = value;
+    } else if (key == "WIFI_STANDARD") {
+        config.wifiStandard = value;
+    } else if (key == "WIFI_CHANNEL_WIDTH") {
+        config.wifiChannelWidth = static_cast<uint32_t>(std::stoul(value));
+    } else if (key == "WIFI_RATE_MANAGER") {
+        config.wifiRateManager = value;
+    } else if (key == "WIFI_AMPDU_SIZE") {
+        config.wifiAmpduSize = std::stoi(value);
+    } else if (key == "WIFI_AMSDU_SIZE") {
+        config.wifiAmsduSize = std::stoi(value);
+    } else if (key == "GRID_WIDTH") {
+        config.gridWidth = static_cast<uint32_t>(std::stoul(value));
+    } else if (key.rfind("SWEEP_", 0) == 0) {
+        static const std::unordered_set<std::string> knownFactors = {
+            "LAMBDA", "BUFFER_SIZE", "PACKET_SIZE", "DATA_RATE_MBPS",
+            "LINK_DELAY_MS", "WIFI_MAX_RANGE", "NUM_GROUPS", "TRAFFIC_HURST"
+        };
+        std::string name = key.substr(6);
+        if (!knownFactors.count(name)) {
+            throw std::runtime_error("Unknown sweep parameter: " + key);
+        }
+        auto colon = value.find(':');
+        if (colon == std::string::npos) {
+            throw std::runtime_error(key + " must be given as min:max");
+        }
+        SweepFactor factor{name, std::stod(value.substr(0, colon)), std::stod(value.substr(colon + 1))};
+        if (factor.maxValue < factor.minValue) {
+            throw std::runtime_error(key + ": max is less than min");
+        }
+        auto existing = std::find_if(config.sweepFactors.begin(), config.sweepFactors.end(),
+                                     [&name](const SweepFactor& f) { return f.name == name; });
+        if (existing != config.sweepFactors.end()) {
+            *existing = factor;
+        } else {
+            config.sweepFactors.push_back(factor);
+        }
+    } else if (key.rfind("NODE_", 0) == 0 && key.find("_SERVICE_RATE") != std::string::npos) {
+        auto underscore1 = key.find('_');
+        auto underscore2 = key.find('_', underscore1 + 1);
+        if (underscore2 != std::string::npos) {
+            int nodeId = std::stoi(key.substr(underscore1 + 1, underscore2 - underscore1 - 1));
+            if (nodeId >= 0) {
+                double rate = std::stod(value);
+                if (rate <= 0.0) {
+                    throw std::runtime_error(key + " must be greater than zero");
+                }
+                if (static_cast<size_t>(nodeId) >= config.nodeServiceRates.size()) {
+                    config.nodeServiceRates.resize(static_cast<size_t>(nodeId) + 1, 0.0);
+                }
+                config.nodeServiceRates[static_cast<size_t>(nodeId)] = rate;
+            }
+        }
+    } else if (key.rfind("NODE_", 0) == 0 && key.find("_HURST") != std::string::npos) {
+        auto underscore1 = key.find('_');
+        auto underscore2 = key.find('_', underscore1 + 1);
+        if (underscore2 != std::string::npos) {
+            int nodeId = std::stoi(key.substr(underscore1 + 1, underscore2 - underscore1 - 1));
+            if (nodeId >= 0) {
+                if (static_cast<size_t>(nodeId) >= config.nodeHursts.size()) {
+                    config.nodeHursts.resize(static_cast<size_t>(nodeId) + 1, 0.0);
+                }
+                config.nodeHursts[static_cast<size_t>(nodeId)] = std::stod(value);
+            }
+        }
     } else if (key.rfind("NODE_", 0) == 0 && key.find("_LOAD") != std::string::npos) {
         auto underscore1 = key.find('_');
         auto underscore2 = key.find('_', underscore1 + 1);
@@ -5,6 +5,17 @@
 #include <unordered_set>
 #include <vector>
 
+/**
+ * Параметр многомерного плана экспериментов: SWEEP_<NAME>=min:max
+ * (NAME - LAMBDA, BUFFER_SIZE, PACKET_SIZE, DATA_RATE_MBPS, LINK_DELAY_MS,
+ * WIFI_MAX_RANGE, NUM_GROUPS).
+ */
+struct SweepFactor {
+    std::string name;
+    double minValue;
+    double maxValue;
+};
+
 struct SimulationConfig {
     double simulationDuration;
     uint32_t packetSize;
@@ -16,6 +27,8 @@ struct SimulationConfig {
     
     std::vector<double> nodeLoads;
     std::vector<uint32_t> nodeBuffers;
+    std::vector<double> nodeServiceRates;  // NODE_X_SERVICE_RATE (0 - serviceRate)
+    std::vector<double> nodeHursts;        // NODE_X_HURST (0 - trafficHurst)
     
     int graphDpi;
     int graphInterpolationPoints;
@@ -39,7 +52,99 @@ struct SimulationConfig {
     double serviceRate;
     uint32_t numGroups;
     
+    // Калибровка моделей пропускной способности по истории симуляций
+    bool calibrationEnabled;
+    
+    // Ответ из суррогатной модели вместо симуляции при малой неопределённости
+    bool surrogateEnabled;
+    double surrogateMaxUncertainty;
+    
+    // План экспериментов по нескольким параметрам
+    std::string sweepDesign;       // "none", "factorial", "lhs", "sobol"
+    uint32_t sweepSamples;         // Число точек для lhs / sobol
+    uint32_t sweepLevels;          // Число уровней каждого параметра для factorial
+    uint32_t sweepWorkers;         // Число рабочих процессов (0 - по числу ядер)
+    uint32_t sweepSeed;
+    std::vector<SweepFactor> sweepFactors;
+    int64_t sweepPointId;          // Выполняемая точка плана (-1 - вне плана); задаёт SweepRunner
+    
+    // Оптимизация распределения буферов (BUFFER_BUDGET = 0 - выключена)
+    uint32_t bufferBudget;
+    double bufferDelayWeight;
+    uint32_t bufferConfirmCandidates;
+    
+    // Разогрев: FlowMonitor учитывает только пакеты, отправленные после warmupTime
+    double warmupTime;
+    
+    // Длительность каждой точки по нестационарному анализу M/M/1/K
+    // (SIMULATION_DURATION - верхняя граница)
+    bool autoDuration;
+    double durationPrecision;      // Относительная полуширина 95% интервала
+    double warmupTolerance;        // Допустимое расстояние по вариации до стационарного
+    
+    // Квадрат коэффициента вариации времени обслуживания для M/G/1/K
+    // (0 - постоянное, как у пакетов фиксированной длины; 1 - экспоненциальное)
+    double serviceScv;
+    
+    // Бинарная трасса пакетов (scratch/public/packet_trace_<тип>_<lambda>.bin)
+    bool packetTrace;
+    double packetTraceSampling;    // Доля трассируемых пакетов, (0, 1]
+    
+    // Источники трафика узлов: "cbr" (постоянный интервал), "trace"
+    // (воспроизведение трассы поступлений trafficTraceFile) или "onoff"
+    // (сеансы с тяжёлыми хвостами длительностей всплесков и пауз)
+    std::string trafficModel;
+    std::string trafficTraceFile;
+    double trafficTraceTimeScale;  // Множитель времени трассы (0 - по lambda * nodeLoad)
+    std::string trafficOnOffDistribution; // "pareto", "lognormal"
+    double trafficHurst;           // Показатель Хёрста H в [0.5, 1): форма Парето 3 - 2H
+    double trafficOnMeanS;         // Средняя длительность всплеска, с
+    double trafficOffMeanS;        // Средняя длительность паузы, с
+    
+    // Маршрутизация GroupSimulator: "global" (SPF по всем узлам) или
+    // "static" (иерархические маршруты групп по кольцу магистрали)
+    std::string groupRouting;
+    
+    // Корневая дисциплина очереди устройств GroupSimulator: "none" (только DropTail
+    // устройства), "default" (FqCoDel ns-3), "codel", "fq_codel", "pie", "red"
+    std::string groupQueueDisc;
+    
+    // Магистраль GroupSimulator между главными узлами групп
+    std::string backboneTopology;          // "ring", "star", "mesh", "tree"
+    uint32_t backboneTreeFanout;           // Число дочерних групп узла дерева
+    double backboneRateFactor;             // Скорость связи к скорости главного узла
+    double backboneDelayMs;                // < 0 - половина linkDelayMs
+    std::vector<double> backboneLinkRates; // BACKBONE_LINK_X_RATE_MBPS (0 - по backboneRateFactor)
+    
+    // Маршрутизация AdHocSimulator: "none" (только прямая достижимость),
+    // "static" (кратчайшие пути по решётке), "olsr", "aodv"
+    std::string adhocRouting;
+    
+    // Wi-Fi AdHocSimulator (стандарт - wifiStandard)
+    uint32_t wifiChannelWidth;     // МГц (0 - по умолчанию для стандарта)
+    std::string wifiRateManager;   // "ideal", "constant", "minstrel"
+    int wifiAmpduSize;             // Байт для AC_BE (-1 - по умолчанию ns-3, 0 - без агрегации)
+    int wifiAmsduSize;
+    
     SimulationConfig();
+    
+    // Ёмкость очереди узла: NODE_X_BUFFER, если задан (> 0), иначе bufferSize
+    uint32_t NodeBufferSize(uint32_t nodeId) const;
+    
+    // Среднее NodeBufferSize по узлам (bufferSize при numNodes = 0)
+    double MeanNodeBufferSize() const;
+    
+    // Интенсивность обслуживания узла: NODE_X_SERVICE_RATE, если задана, иначе serviceRate
+    double NodeServiceRate(uint32_t nodeId) const;
+    
+    // Показатель Хёрста источника onoff узла: NODE_X_HURST, если задан, иначе trafficHurst
+    double NodeHurst(uint32_t nodeId) const;
+    
+    // Скорость канала устройства узла, пропорциональная его интенсивности обслуживания
+    double NodeDataRateMbps(uint32_t nodeId) const;
+    
+    // Есть ли узлы с интенсивностью обслуживания, отличной от serviceRate
+    bool HasHeterogeneousServiceRates() const;
 };
 
 class EnvironmentConfig {
@@ -2,29 +2,159 @@
 #include "env/environment_config.h"
 #include "simulation/adhoc_simulator.h"
 #include "simulation/group_simulator.h"
+#include "simulation/backbone_topology.h"
 #include "writers/csv_writer.h"
 #include "analysis/analysis_methods.h"
 #include "analysis/queueing_models.h" 
+#include "analysis/analysis_cache.h"
+#include "analysis/model_calibration.h"
+#include "analysis/surrogate_model.h"
+#include "analysis/buffer_optimizer.h"
+#include "analysis/dcf_model.h"
+#include "analysis/hierarchical_model.h"
+#include "analysis/transient_analysis.h"
+#include "analysis/sensitivity.h"
+#include "metrics/results_history.h"
+#include "sweep/sweep_runner.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <exception>
+#include <limits>
+#include <string>
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("NetworkSimulation");
 
-// Структура для хранения результатов анализа различными методами
-struct AnalysisResults {
-    std::vector<double> lambdas;
-    std::vector<double> actualThroughputs;
-    std::vector<double> actualDelays;
-    std::vector<double> meanValueAnalysis;
-    std::vector<double> globalBalanceMethod;
-    std::vector<double> gordonNewellMethod;
-    std::vector<double> buzenMethod;
-    std::vector<double> meanValueDelay;
-};
+const std::string kHistoryFile = "scratch/public/simulation_history.csv";
+const std::string kCalibrationFile = "scratch/public/model_calibration.env";
+
+// Интенсивности обслуживания узлов (NODE_X_SERVICE_RATE); в групповой сети
+// главные узлы передают по магистрали со скоростью, умноженной на BACKBONE_RATE_FACTOR
+std::vector<double> NodeServiceRates(const SimulationConfig& config, bool isAdHoc) {
+    std::vector<double> rates;
+    for (uint32_t i = 0; i < config.numNodes; ++i) {
+        rates.push_back(config.NodeServiceRate(i));
+    }
+    if (!isAdHoc) {
+        // Разбиение на группы - как в GroupSimulator
+        const uint32_t groups = std::max<uint32_t>(1, std::min(config.numGroups, config.numNodes));
+        uint32_t node = 0;
+        for (uint32_t g = 0; g < groups; ++g) {
+            rates[node] *= config.backboneRateFactor;
+            node += config.numNodes / groups + ((g < config.numNodes % groups) ? 1 : 0);
+        }
+    }
+    return rates;
+}
+
+// Магистраль групповой сети для аналитических моделей - как в GroupSimulator: связи
+// BACKBONE_TOPOLOGY, скорость направления - BACKBONE_LINK_X_RATE_MBPS или скорость
+// передающего главного узла x BACKBONE_RATE_FACTOR (множитель к скорости узла)
+BackboneParameters Backbone(const SimulationConfig& config) {
+    const uint32_t groups = std::max<uint32_t>(1, std::min(config.numGroups, config.numNodes));
+    std::vector<uint32_t> masters(groups, 0);
+    for (uint32_t g = 1; g < groups; ++g) {
+        masters[g] = masters[g - 1] + config.numNodes / groups + ((g - 1 < config.numNodes % groups) ? 1 : 0);
+    }
+    
+    BackboneParameters backbone;
+    backbone.links = BackboneTopology::Links(config.backboneTopology, groups, config.backboneTreeFanout);
+    for (size_t l = 0; l < backbone.links.size(); ++l) {
+        for (uint32_t group : {backbone.links[l].a, backbone.links[l].b}) {
+            const double nodeRate = config.NodeDataRateMbps(masters[group]);
+            const bool fixedRate = l < config.backboneLinkRates.size() && config.backboneLinkRates[l] > 0.0;
+            backbone.rateFactors.push_back((fixedRate && nodeRate > 0.0)
+                ? config.backboneLinkRates[l] / nodeRate
+                : config.backboneRateFactor);
+        }
+    }
+    backbone.delayMs = config.backboneDelayMs;
+    return backbone;
+}
+
+// Интенсивность обслуживания узла в кадрах/с на скорости его канала (пакет UDP + заголовки UDP/IP)
+double NodeFrameRate(const SimulationConfig& config, uint32_t nodeId) {
+    return config.NodeDataRateMbps(nodeId) * 1000000.0 / (8.0 * (config.packetSize + 28));
+}
+
+// μ_i узлов в кадрах/с; в групповой сети главные узлы - с BACKBONE_RATE_FACTOR, как в NodeServiceRates
+std::vector<double> NodeFrameRates(const SimulationConfig& config, bool isAdHoc) {
+    std::vector<double> rates;
+    for (uint32_t i = 0; i < config.numNodes; ++i) {
+        rates.push_back(NodeFrameRate(config, i));
+    }
+    if (!isAdHoc) {
+        const uint32_t groups = std::max<uint32_t>(1, std::min(config.numGroups, config.numNodes));
+        uint32_t node = 0;
+        for (uint32_t g = 0; g < groups; ++g) {
+            rates[node] *= config.backboneRateFactor;
+            node += config.numNodes / groups + ((g < config.numNodes % groups) ? 1 : 0);
+        }
+    }
+    return rates;
+}
+
+// Поток кадров (пакетов/с) в Мбит/с на уровне IP, как пропускная способность FlowMonitor
+double FrameRateToMbps(const SimulationConfig& config, double packetsPerSecond) {
+    return packetsPerSecond * (config.packetSize + 28) * 8.0 / 1000000.0;
+}
+
+// Предлагаемая нагрузка на уровне IP (пакет UDP + заголовки UDP/IP, как в FlowMonitor), Мбит/с
+double OfferedLoadMbps(const SimulationConfig& config, double lambda) {
+    double totalLoad = 0.0;
+    for (double load : config.nodeLoads) totalLoad += load;
+    return lambda * totalLoad * (config.packetSize + 28) * 8.0 / 1000000.0;
+}
+
+// Конфигурация точки lambda: при AUTO_DURATION разогрев и длительность измерений
+// берутся по наиболее медленной очереди узла (M/M/1/K, μ - кадры на скорости канала узла)
+SimulationConfig PointConfig(const SimulationConfig& config, double lambda) {
+    if (!config.autoDuration) {
+        return config;
+    }
+    
+    double warmup = 0.0;
+    double runLength = 0.0;
+    double relaxation = 0.0;
+    for (uint32_t i = 0; i < config.numNodes; ++i) {
+        double nodeLambda = lambda * config.nodeLoads[i];
+        double mu = NodeFrameRate(config, i);
+        RunLengthPlan plan = TransientMM1K::PlanRunLength(nodeLambda, mu, static_cast<int>(config.NodeBufferSize(i)),
+                                                          config.durationPrecision, 1.96, config.warmupTolerance);
+        warmup = std::max(warmup, plan.warmupTime);
+        runLength = std::max(runLength, plan.runLength);
+        relaxation = std::max(relaxation, plan.relaxationTime);
+    }
+    
+    // Отсчёт от запуска последнего источника; клиенты останавливаются за 0.1 с до конца
+    SimulationConfig pointConfig = config;
+    double required = config.startTimeMax + warmup + runLength + 0.1;
+    pointConfig.simulationDuration = std::min(config.simulationDuration, required);
+    pointConfig.warmupTime = std::min(config.startTimeMax + warmup, 0.5 * pointConfig.simulationDuration);
+    
+    std::cout << "Auto duration: " << pointConfig.simulationDuration << " s (warm-up " << pointConfig.warmupTime
+              << " s, relaxation time " << relaxation << " s"
+              << (required > config.simulationDuration ? ", precision target capped by SIMULATION_DURATION" : "")
+              << ")" << std::endl;
+    return pointConfig;
+}
+
+// Иерархическая модель групповой сети с параметрами узлов из конфигурации
+GroupModelResult GroupModel(const SimulationConfig& config, double lambda) {
+    std::vector<double> dataRates;
+    for (uint32_t i = 0; i < config.numNodes; ++i) {
+        dataRates.push_back(config.NodeDataRateMbps(i));
+    }
+    return AnalysisMethods::GroupHierarchicalModel(lambda, config.nodeLoads, dataRates, config.nodeBuffers,
+                                                   static_cast<int>(config.bufferSize),
+                                                   static_cast<int>(config.numGroups),
+                                                   config.packetSize, config.linkDelayMs, Backbone(config));
+}
 
 // Функция для анализа результатов различными методами
 AnalysisResults AnalyzeWithAllMethods(const std::vector<SimulationMetrics>& results, 
@@ -46,32 +176,88 @@ AnalysisResults AnalyzeWithAllMethods(const std::vector<SimulationMetrics>& resu
         avgBufferSize /= config.nodeBuffers.size();
     }
     
+    double mu = serviceRate;  // Интенсивность обслуживания
+    
+    // Сохраняем исходные данные
     for (size_t i = 0; i < results.size(); ++i) {
-        double lambda = lambdaValues[i];  // Используем реальные значения lambda
-        double mu = serviceRate;  // Интенсивность обслуживания
-        
-        // Сохраняем исходные данные
-        analysisResults.lambdas.push_back(lambda);
+        analysisResults.lambdas.push_back(lambdaValues[i]);  // Используем реальные значения lambda
         analysisResults.actualThroughputs.push_back(results[i].throughput);
         analysisResults.actualDelays.push_back(results[i].delay);
+    }
+    
+    // Применяем разные методы анализа сразу ко всему массиву lambda
+    const std::vector<double>& lambdas = analysisResults.lambdas;
+    analysisResults.meanValueAnalysis = analyzer.MeanValueAnalysisBatch(lambdas, mu, avgBufferSize, numNodes);
+    analysisResults.globalBalanceMethod = analyzer.GlobalBalanceMethodBatch(lambdas, mu, avgBufferSize, numNodes);
+    analysisResults.gordonNewellMethod = analyzer.GordonNewellMethodBatch(lambdas, mu, avgBufferSize, numNodes);
+    analysisResults.buzenMethod = analyzer.BuzenMethodBatch(lambdas, mu, avgBufferSize, numNodes);
+    
+    // Используем правильные методы MVA для расчета задержки в зависимости от режима
+    // Режим 1 (Ad-hoc): итерационный MVA для 9 узлов
+    // Режим 2 (Group): иерархический MVA с агрегацией (3 подсети по 3 узла)
+    if (isAdHoc) {
+        // Режим 1: Ad-hoc (9 узлов по отдельности) - итерационный MVA
+        analysisResults.meanValueDelay = analyzer.CalculateMVADelay_Mode1Batch(lambdas, mu, avgBufferSize, numNodes);
+        if (config.HasHeterogeneousServiceRates()) {
+            // NODE_X_SERVICE_RATE: последовательная сеть с μ_i каждого узла
+            std::vector<double> serviceRates = NodeServiceRates(config, true);
+            for (size_t i = 0; i < lambdas.size(); ++i) {
+                analysisResults.meanValueDelay[i] = analyzer.CalculateSeriesMM1Delay(lambdas[i], serviceRates);
+            }
+        }
+    } else {
+        // Режим 2: Group (3 подсети по 3 узла) - иерархический MVA с агрегацией (FES)
+        // numNodes здесь - число групп; узлов в группе - по NUM_NODES, как в GroupSimulator
+        int nodesPerGroup = (config.numNodes > 0 && config.numGroups > 0)
+            ? static_cast<int>(config.numNodes / config.numGroups) : 3;
+        analysisResults.meanValueDelay = analyzer.CalculateMVADelay_Mode2Batch(lambdas, mu, avgBufferSize, config.numGroups, nodesPerGroup);
+        if (config.HasHeterogeneousServiceRates()) {
+            // NODE_X_SERVICE_RATE: группы из узлов с их μ_i
+            std::vector<double> serviceRates = NodeServiceRates(config, true);
+            for (size_t i = 0; i < lambdas.size(); ++i) {
+                analysisResults.meanValueDelay[i] = analyzer.CalculateMVADelay_Mode2(
+                    lambdas[i], serviceRates, static_cast<int>(config.numGroups));
+            }
+        }
+    }
+    
+    // Сеть Джексона, построенная по тем же правилам трафика, что и симулятор;
+    // μ_i - кадры/с на скорости канала узла, пропускная способность - в Мбит/с
+    std::vector<double> serviceRates = NodeFrameRates(config, true);
+    for (double lambda : lambdas) {
+        JacksonNetworkResult jackson = analyzer.JacksonNetworkAnalysis(
+            lambda, config.nodeLoads, serviceRates, config.nodeBuffers,
+            static_cast<int>(config.bufferSize), isAdHoc ? 0 : static_cast<int>(config.numGroups), Backbone(config));
+        analysisResults.jacksonThroughput.push_back(FrameRateToMbps(config, jackson.deliveredThroughput));
+        analysisResults.jacksonDelay.push_back(jackson.meanSojournTime);
         
-        // Применяем разные методы анализа
-        analysisResults.meanValueAnalysis.push_back(analyzer.MeanValueAnalysis(lambda, mu, avgBufferSize, numNodes));
-        analysisResults.globalBalanceMethod.push_back(analyzer.GlobalBalanceMethod(lambda, mu, avgBufferSize, numNodes));
-        analysisResults.gordonNewellMethod.push_back(analyzer.GordonNewellMethod(lambda, mu, avgBufferSize, numNodes));
-        analysisResults.buzenMethod.push_back(analyzer.BuzenMethod(lambda, mu, avgBufferSize, numNodes));
+        // Пустой результат - маршрутизация симулятора не описывается блокировкой BAS
+        TandemNetworkResult tandem = analyzer.TandemDecompositionAnalysis(
+            lambda, config.nodeLoads, serviceRates, config.nodeBuffers,
+            static_cast<int>(config.bufferSize), isAdHoc ? 0 : static_cast<int>(config.numGroups), Backbone(config));
+        const bool decomposed = !tandem.throughput.empty();
+        analysisResults.decompositionThroughput.push_back(
+            decomposed ? FrameRateToMbps(config, tandem.throughputOut) : std::numeric_limits<double>::quiet_NaN());
+        analysisResults.decompositionDelay.push_back(
+            decomposed ? tandem.endToEndDelay : std::numeric_limits<double>::quiet_NaN());
         
-        // Используем правильные методы MVA для расчета задержки в зависимости от режима
-        // Режим 1 (Ad-hoc): итерационный MVA для 9 узлов
-        // Режим 2 (Group): иерархический MVA с агрегацией (3 подсети по 3 узла)
-        if (isAdHoc) {
-            // Режим 1: Ad-hoc (9 узлов по отдельности) - итерационный MVA
-            analysisResults.meanValueDelay.push_back(analyzer.CalculateMVADelay_Mode1(lambda, mu, avgBufferSize, numNodes));
-        } else {
-            // Режим 2: Group (3 подсети по 3 узла) - иерархический MVA с агрегацией (FES)
-            int nodesPerGroup = (numNodes > 0 && config.numGroups > 0) ? numNodes / config.numGroups : 3;
-            analysisResults.meanValueDelay.push_back(analyzer.CalculateMVADelay_Mode2(lambda, mu, avgBufferSize, config.numGroups, nodesPerGroup));
-        }
+        // Глубокие буферы - по устойчивым формулам без симуляции
+        const int servers = isAdHoc ? 1 : static_cast<int>(std::max<uint32_t>(1, std::min(config.numGroups, config.numNodes)));
+        QueueModelResult pooled = analyzer.PooledChannelAnalysis(
+            lambda, config.nodeLoads, serviceRates, config.nodeBuffers, static_cast<int>(config.bufferSize), servers);
+        analysisResults.pooledChannelThroughput.push_back(FrameRateToMbps(config, pooled.throughput));
+        analysisResults.pooledChannelDelay.push_back(pooled.delay);
+        
+        QueueModelResult nodes = analyzer.IndependentNodesMG1K(
+            lambda, config.nodeLoads, NodeFrameRates(config, isAdHoc), config.nodeBuffers,
+            static_cast<int>(config.bufferSize), config.serviceScv);
+        analysisResults.nodeMG1KThroughput.push_back(FrameRateToMbps(config, nodes.throughput));
+        analysisResults.nodeMG1KDelay.push_back(nodes.delay);
+        
+        double offered = OfferedLoadMbps(config, lambda);
+        analysisResults.protocolModelThroughput.push_back(isAdHoc
+            ? analyzer.AdHocDcfThroughputModel(offered, config.wifiStandard, config.packetSize, config.numNodes)
+            : GroupModel(config, lambda).throughputMbps);
     }
     
     return analysisResults;
@@ -157,13 +343,384 @@ void PerformComparativeAnalysis(const std::vector<SimulationMetrics>& adHocResul
     double adHocModelPrediction = analyzer.AdHocThroughputModel(avgLoad, config.dataRateMbps, config.numNodes);
     double groupModelPrediction = analyzer.GroupThroughputModel(avgLoad, config.dataRateMbps, config.numGroups);
     
+    // Насыщение DCF для 1..2N станций одним пакетным вызовом
+    std::vector<uint32_t> stationCounts;
+    for (uint32_t n = 1; n <= 2 * config.numNodes; ++n) stationCounts.push_back(n);
+    std::vector<DcfSaturationResult> saturation = DcfModel::SolveBatch(
+        DcfModel::ForStandard(config.wifiStandard), config.packetSize, stationCounts);
+    std::ofstream dcfFile("scratch/public/dcf_saturation.csv");
+    dcfFile << "Stations,Tau,CollisionProbability,Throughput_Mbps,ServiceTime_s\n";
+    for (const DcfSaturationResult& point : saturation) {
+        dcfFile << point.numStations << "," << point.tau << "," << point.collisionProbability << ","
+                << point.throughputMbps << "," << point.serviceTime << "\n";
+    }
+    const DcfSaturationResult& adHocSaturation = saturation[config.numNodes - 1];
+    
+    // Иерархическая модель на сетке G x (узлов в группе) при наибольшей интенсивности
+    std::vector<uint32_t> groupCounts, groupSizes;
+    for (uint32_t g = 1; g <= 8; ++g) groupCounts.push_back(g);
+    for (uint32_t n = 2; n <= 16; ++n) groupSizes.push_back(n);
+    double meanLoad = 0.0;
+    for (double load : config.nodeLoads) meanLoad += load;
+    meanLoad /= std::max<size_t>(config.nodeLoads.size(), 1);
+    std::vector<GroupModelResult> grid = HierarchicalGroupModel::EvaluateGrid(
+        config.lambdaEnd, meanLoad, config.dataRateMbps, config.bufferSize, config.packetSize,
+        config.linkDelayMs, groupCounts, groupSizes);
+    std::ofstream gridFile("scratch/public/group_model_grid.csv");
+    gridFile << "Groups,NodesPerGroup,Throughput_Mbps,LanThroughput_Mbps,BackboneThroughput_Mbps,Delay_s,LossRate\n";
+    for (size_t g = 0; g < groupCounts.size(); ++g) {
+        for (size_t n = 0; n < groupSizes.size(); ++n) {
+            const GroupModelResult& point = grid[g * groupSizes.size() + n];
+            gridFile << groupCounts[g] << "," << groupSizes[n] << "," << point.throughputMbps << ","
+                     << point.lanThroughputMbps << "," << point.backboneThroughputMbps << ","
+                     << point.delay << "," << point.lossRate << "\n";
+        }
+    }
+    GroupModelResult groupHierarchical = GroupModel(config, config.lambdaEnd);
+    
     std::cout << "  M/M/1 Model Prediction: " << mm1Prediction << " Mbps" << std::endl;
+    std::cout << "  802.11 DCF Saturation (Bianchi, " << config.wifiStandard << ", N=" << config.numNodes
+              << "): " << adHocSaturation.throughputMbps << " Mbps, collision probability "
+              << adHocSaturation.collisionProbability << std::endl;
     std::cout << "  AdHoc Model Prediction: " << adHocModelPrediction << " Mbps" << std::endl;
     std::cout << "  Group Model Prediction: " << groupModelPrediction << " Mbps" << std::endl;
+    std::cout << "  Group Hierarchical Model (lambda=" << config.lambdaEnd << "): "
+              << groupHierarchical.throughputMbps << " Mbps (LAN " << groupHierarchical.lanThroughputMbps
+              << ", backbone " << groupHierarchical.backboneThroughputMbps << "), loss "
+              << groupHierarchical.lossRate << std::endl;
     std::cout << "  Actual AdHoc: " << adHocAvgThroughput << " Mbps" << std::endl;
     std::cout << "  Actual Group: " << groupAvgThroughput << " Mbps" << std::endl;
 }
 
+// Ответ суррогатной модели для точки lambda; false - неопределённость выше порога
+bool AnswerFromSurrogate(const SurrogateModel& surrogate,
+                         const SimulationConfig& config,
+                         double lambda,
+                         SimulationMetrics& metrics) {
+    if (!config.surrogateEnabled || !surrogate.IsTrained()) {
+        return false;
+    }
+    
+    SurrogatePrediction prediction = surrogate.Predict(SurrogateModel::MakeFeatures(
+        lambda, config.MeanNodeBufferSize(), config.packetSize, config.dataRateMbps, config.numNodes));
+    if (prediction.RelativeUncertainty() > config.surrogateMaxUncertainty) {
+        return false;
+    }
+    
+    metrics = SimulationMetrics();
+    metrics.throughput = prediction.throughput;
+    metrics.delay = prediction.delay;
+    metrics.packetLoss = prediction.packetLoss;
+    metrics.simulationTime = config.simulationDuration;
+    metrics.rxBytes = prediction.throughput * 1000000.0 * config.simulationDuration / 8.0;
+    if (!config.nodeLoads.empty()) {
+        double totalLoad = 0.0;
+        for (double load : config.nodeLoads) totalLoad += load;
+        metrics.load = totalLoad / config.nodeLoads.size();
+    }
+    
+    std::cout << "  Surrogate answer (uncertainty " << prediction.RelativeUncertainty() * 100
+              << "%): Throughput " << prediction.throughput << " +/- " << prediction.throughputStd
+              << " Mbps, Delay " << prediction.delay << " +/- " << prediction.delayStd << " s" << std::endl;
+    return true;
+}
+
+// Многомерный план экспериментов (SWEEP_DESIGN) вместо обычного прохода по Lambda
+void RunParameterSweep(const SimulationConfig& config) {
+    std::vector<SweepPoint> points = SweepRunner::BuildPoints(config);
+    std::cout << "Sweep design: " << config.sweepDesign << ", factors: " << config.sweepFactors.size()
+              << ", points: " << points.size() << std::endl;
+    
+    std::vector<SweepResult> results = SweepRunner::Run(config, points, config.sweepWorkers);
+    
+    size_t completed = 0;
+    for (const SweepResult& result : results) {
+        if (!result.completed) continue;
+        ++completed;
+        // Факторы плана вне признаков суррогата попадают в Settings записи
+        SimulationConfig pointConfig = SweepRunner::Apply(config, result.point);
+        ResultsHistory::Append(kHistoryFile, "AdHoc", pointConfig, result.point.lambda, result.adHoc);
+        ResultsHistory::Append(kHistoryFile, "Group", pointConfig, result.point.lambda, result.group);
+    }
+    
+    SweepRunner::WriteResults(config, results, "scratch/public/sweep_results.csv");
+    std::cout << "Sweep finished: " << completed << "/" << results.size()
+              << " points completed, results in scratch/public/sweep_results.csv" << std::endl;
+}
+
+// Поузловые загрузки M/M/1/K, MVA по сети и узкое место для каждой точки Lambda
+void ReportNodeUtilization(const SimulationConfig& config, const std::vector<double>& lambdaValues) {
+    std::ofstream file("scratch/public/node_utilization.csv");
+    file << "NetworkType,Lambda,Node,ServiceRate,ArrivalRate,Utilization,LossRate,Delay,MVA_Utilization,Bottleneck\n";
+    
+    for (bool isAdHoc : {true, false}) {
+        const char* networkType = isAdHoc ? "AdHoc" : "Group";
+        std::vector<double> serviceRates = NodeServiceRates(config, isAdHoc);
+        NodeUtilizationResult last;
+        
+        for (double lambda : lambdaValues) {
+            NodeUtilizationResult nodes = AnalysisMethods::HeterogeneousNodeAnalysis(
+                lambda, config.nodeLoads, serviceRates, config.nodeBuffers, static_cast<int>(config.bufferSize));
+            for (size_t i = 0; i < nodes.utilization.size(); ++i) {
+                double mvaUtilization = (i < nodes.closedNetwork.utilization.size())
+                    ? nodes.closedNetwork.utilization[i] : 0.0;
+                file << networkType << "," << lambda << "," << i << "," << nodes.serviceRate[i] << ","
+                     << nodes.arrivalRate[i] << "," << nodes.utilization[i] << "," << nodes.lossRate[i] << ","
+                     << nodes.delay[i] << "," << mvaUtilization << "," << (i == nodes.bottleneck ? 1 : 0) << "\n";
+            }
+            last = nodes;
+        }
+        
+        if (lambdaValues.empty() || last.utilization.empty()) continue;
+        std::cout << "\nPer-Node Utilization (" << networkType << ", Lambda=" << lambdaValues.back() << "):" << std::endl;
+        for (size_t i = 0; i < last.utilization.size(); ++i) {
+            std::cout << "  Node " << i << " - mu: " << last.serviceRate[i]
+                      << ", rho: " << last.utilization[i]
+                      << ", Loss: " << last.lossRate[i]
+                      << ", T: " << last.delay[i] << std::endl;
+        }
+        std::cout << "  Bottleneck: node " << last.bottleneck << " (offered load "
+                  << last.bottleneckLoad << ")" << std::endl;
+    }
+}
+
+// Блокировка и простой узлов по декомпозиции сети с конечными буферами
+void ReportTandemDecomposition(const SimulationConfig& config, const std::vector<double>& lambdaValues) {
+    std::ofstream file("scratch/public/tandem_decomposition.csv");
+    file << "NetworkType,Lambda,Node,ArrivalRate,Throughput,Blocking,Starvation,LossRate,Delay,PathDelay\n";
+    
+    for (bool isAdHoc : {true, false}) {
+        const char* networkType = isAdHoc ? "AdHoc" : "Group";
+        // Кадры/с на скорости канала узла; множители магистрали добавляет Backbone(config)
+        std::vector<double> serviceRates = NodeFrameRates(config, true);
+        TandemNetworkResult last;
+        
+        for (double lambda : lambdaValues) {
+            TandemNetworkResult tandem = AnalysisMethods::TandemDecompositionAnalysis(
+                lambda, config.nodeLoads, serviceRates, config.nodeBuffers,
+                static_cast<int>(config.bufferSize), isAdHoc ? 0 : static_cast<int>(config.numGroups),
+                Backbone(config));
+            for (size_t i = 0; i < tandem.throughput.size(); ++i) {
+                file << networkType << "," << lambda << "," << i << "," << tandem.arrivalRate[i] << ","
+                     << tandem.throughput[i] << "," << tandem.blockingProbability[i] << ","
+                     << tandem.starvationProbability[i] << "," << tandem.lossProbability[i] << ","
+                     << tandem.delay[i] << "," << tandem.pathDelay[i] << "\n";
+            }
+            last = tandem;
+        }
+        
+        if (lambdaValues.empty()) continue;
+        if (last.throughput.empty()) {
+            std::cout << "\nBlocking Decomposition (" << networkType << "): not applicable, "
+                      << "a station forwards to more than one successor" << std::endl;
+            continue;
+        }
+        std::cout << "\nBlocking Decomposition (" << networkType << ", Lambda=" << lambdaValues.back() << "): "
+                  << "throughput " << FrameRateToMbps(config, last.throughputOut) << " Mbps, end-to-end delay " << last.endToEndDelay
+                  << " s, " << last.iterations << " iterations"
+                  << (last.converged ? "" : " (not converged)") << std::endl;
+    }
+}
+
+// Производные λ_eff, p_K и T по λ, μ, K узлов (автоматическое дифференцирование) и колено насыщения
+void ReportSensitivity(const SimulationConfig& config, const std::vector<double>& lambdaValues) {
+    std::ofstream file("scratch/public/sensitivity.csv");
+    file << "NetworkType,Lambda,Node,ArrivalRate,ServiceRate,Buffer,"
+         << "Throughput,dThroughput_dLambda,dThroughput_dMu,dThroughput_dK,"
+         << "Loss,dLoss_dLambda,dLoss_dMu,dLoss_dK,"
+         << "Delay,dDelay_dLambda,dDelay_dMu,dDelay_dK,KneeLambda\n";
+    
+    for (bool isAdHoc : {true, false}) {
+        const char* networkType = isAdHoc ? "AdHoc" : "Group";
+        std::vector<double> serviceRates = NodeServiceRates(config, isAdHoc);
+        
+        // Колено узла - по его интенсивности; колено сети - наименьшее λ, при котором колена достигает какой-либо узел
+        std::vector<double> knees(config.numNodes, 0.0);
+        double networkKnee = std::numeric_limits<double>::infinity();
+        uint32_t kneeNode = 0;
+        for (uint32_t i = 0; i < config.numNodes; ++i) {
+            knees[i] = SensitivityAnalysis::SaturationKnee(serviceRates[i], config.NodeBufferSize(i));
+            if (config.nodeLoads[i] > 0.0 && knees[i] / config.nodeLoads[i] < networkKnee) {
+                networkKnee = knees[i] / config.nodeLoads[i];
+                kneeNode = i;
+            }
+        }
+        
+        for (double lambda : lambdaValues) {
+            for (uint32_t i = 0; i < config.numNodes; ++i) {
+                const double arrivalRate = lambda * config.nodeLoads[i];
+                const double buffer = config.NodeBufferSize(i);
+                NodeSensitivity node = SensitivityAnalysis::MM1K(arrivalRate, serviceRates[i], buffer);
+                file << networkType << "," << lambda << "," << i << "," << arrivalRate << ","
+                     << serviceRates[i] << "," << buffer;
+                for (const ParameterGradient* g : {&node.throughput, &node.loss, &node.delay}) {
+                    file << "," << g->value << "," << g->dLambda << "," << g->dMu << "," << g->dK;
+                }
+                file << "," << knees[i] << "\n";
+            }
+        }
+        
+        if (lambdaValues.empty() || std::isinf(networkKnee)) continue;
+        
+        // Узел, где лишний пакет буфера спасает больше всего пакетов/с при наибольшей Lambda
+        const double lambda = lambdaValues.back();
+        uint32_t bufferNode = 0;
+        double bufferGain = 0.0;
+        for (uint32_t i = 0; i < config.numNodes; ++i) {
+            const double arrivalRate = lambda * config.nodeLoads[i];
+            NodeSensitivity node = SensitivityAnalysis::MM1K(arrivalRate, serviceRates[i], config.NodeBufferSize(i));
+            const double gain = -arrivalRate * node.loss.dK;
+            if (gain > bufferGain) {
+                bufferGain = gain;
+                bufferNode = i;
+            }
+        }
+        std::cout << "\nSensitivity (" << networkType << "): saturation knee at Lambda=" << networkKnee
+                  << " (node " << kneeNode << ", dThroughput/dLambda = 0.5)";
+        if (bufferGain > 0.0) {
+            std::cout << "; at Lambda=" << lambda << " one more buffer slot on node " << bufferNode
+                      << " saves " << bufferGain << " pkt/s";
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Потери симуляции против поузловой M/M/1/K при тех же λ_i, μ_i, K_i: насколько
+// всплески источника (TRAFFIC_MODEL=onoff / trace) увеличивают потери над пуассоновскими
+void ReportBurstinessLoss(const SimulationConfig& config,
+                          const std::vector<double>& lambdaValues,
+                          const std::vector<SimulationMetrics>& adHocResults,
+                          const std::vector<SimulationMetrics>& groupResults) {
+    double hurst = 0.0;
+    if (config.trafficModel == "onoff") {
+        for (uint32_t i = 0; i < config.numNodes; ++i) hurst += config.NodeHurst(i);
+        hurst /= config.numNodes;
+    }
+
+    // Разбиение на группы - как в GroupSimulator: главный узел отправляет только при
+    // нескольких группах (по магистрали, со скоростью BACKBONE_RATE_FACTOR), обычный -
+    // при хотя бы одном другом обычном узле в группе
+    const uint32_t groups = std::max<uint32_t>(1, std::min(config.numGroups, config.numNodes));
+    std::vector<bool> groupSends(config.numNodes, false);
+    for (uint32_t g = 0, node = 0; g < groups; ++g) {
+        const uint32_t size = config.numNodes / groups + ((g < config.numNodes % groups) ? 1 : 0);
+        for (uint32_t k = 0; k < size; ++k) {
+            groupSends[node + k] = (k == 0) ? groups > 1 : size > 2;
+        }
+        node += size;
+    }
+
+    std::ofstream file("scratch/public/burstiness_loss.csv");
+    file << "NetworkType,Lambda,TrafficModel,Distribution,Hurst,MM1K_Loss,Sim_Loss,LossExcess,LossRatio\n";
+
+    for (bool isAdHoc : {true, false}) {
+        const char* networkType = isAdHoc ? "AdHoc" : "Group";
+        const std::vector<SimulationMetrics>& results = isAdHoc ? adHocResults : groupResults;
+        // μ_i - кадры/с на скорости канала узла, как у симуляторов (не SERVICE_RATE)
+        std::vector<double> frameRates = NodeFrameRates(config, isAdHoc);
+        double lastModel = 0.0, lastSim = 0.0, worstRatio = 0.0, worstLambda = 0.0;
+
+        for (size_t p = 0; p < lambdaValues.size() && p < results.size(); ++p) {
+            NodeUtilizationResult nodes = AnalysisMethods::HeterogeneousNodeAnalysis(
+                lambdaValues[p], config.nodeLoads, frameRates, config.nodeBuffers, static_cast<int>(config.bufferSize));
+            // Доля потерянных пакетов сети - потери отправляющих узлов, взвешенные по λ_i
+            double offered = 0.0, lost = 0.0;
+            for (size_t i = 0; i < nodes.lossRate.size(); ++i) {
+                if (isAdHoc ? config.numNodes < 2 : !groupSends[i]) continue;
+                offered += nodes.arrivalRate[i];
+                lost += nodes.arrivalRate[i] * nodes.lossRate[i];
+            }
+            const double modelLoss = (offered > 0.0) ? lost / offered : 0.0;
+            const double simLoss = results[p].packetLoss;
+            const double ratio = (modelLoss > 0.0) ? simLoss / modelLoss : 0.0;
+            file << networkType << "," << lambdaValues[p] << "," << config.trafficModel << ","
+                 << config.trafficOnOffDistribution << "," << hurst << "," << modelLoss << ","
+                 << simLoss << "," << simLoss - modelLoss << "," << ratio << "\n";
+
+            if (ratio > worstRatio) {
+                worstRatio = ratio;
+                worstLambda = lambdaValues[p];
+            }
+            lastModel = modelLoss;
+            lastSim = simLoss;
+        }
+
+        if (lambdaValues.empty() || results.empty()) continue;
+        std::cout << "\nLoss vs M/M/1/K (" << networkType << ", traffic " << config.trafficModel;
+        if (config.trafficModel == "onoff") {
+            std::cout << " " << config.trafficOnOffDistribution << ", H=" << hurst;
+        }
+        std::cout << "): at Lambda=" << lambdaValues[std::min(lambdaValues.size(), results.size()) - 1]
+                  << " model " << lastModel << ", sim " << lastSim;
+        if (worstRatio > 0.0) {
+            std::cout << "; largest excess x" << worstRatio << " at Lambda=" << worstLambda;
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Поиск распределения буферов по M/M/1/K и проверка лучших вариантов симуляцией
+void RunBufferOptimization(const SimulationConfig& config) {
+    const double lambda = config.lambdaEnd; // Наиболее нагруженная точка диапазона
+    std::ofstream file("scratch/public/buffer_optimization.csv");
+    file << "NetworkType,Candidate,Buffers,Model_Loss,Model_P95_s,Model_Objective,"
+         << "Sim_Loss,Sim_P95_s,Sim_Objective\n";
+    
+    std::cout << "\n=== BUFFER ALLOCATION (budget " << config.bufferBudget
+              << " packets, Lambda=" << lambda << ") ===" << std::endl;
+    
+    for (bool isAdHoc : {true, false}) {
+        const char* networkType = isAdHoc ? "AdHoc" : "Group";
+        
+        BufferAllocationProblem problem;
+        problem.budget = config.bufferBudget;
+        problem.delayWeight = config.bufferDelayWeight;
+        problem.serviceRates = NodeServiceRates(config, isAdHoc);
+        for (uint32_t i = 0; i < config.numNodes; ++i) {
+            problem.arrivalRates.push_back(lambda * config.nodeLoads[i]);
+        }
+        
+        BufferOptimizerOptions options;
+        options.numCandidates = config.bufferConfirmCandidates;
+        std::vector<BufferAllocation> candidates = BufferOptimizer::Optimize(problem, options);
+        
+        // Текущее распределение из .env - для сравнения
+        std::vector<uint32_t> baseline;
+        for (uint32_t i = 0; i < config.numNodes; ++i) baseline.push_back(config.NodeBufferSize(i));
+        candidates.insert(candidates.begin(), BufferOptimizer::Evaluate(problem, baseline));
+        
+        double bestObjective = std::numeric_limits<double>::infinity();
+        std::string bestBuffers;
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            const BufferAllocation& allocation = candidates[c];
+            std::string buffers;
+            for (size_t i = 0; i < allocation.buffers.size(); ++i) {
+                buffers += (i ? ";" : "") + std::to_string(allocation.buffers[i]);
+            }
+            
+            SimulationConfig candidateConfig = config;
+            candidateConfig.nodeBuffers = allocation.buffers;
+            SimulationMetrics metrics = isAdHoc ? AdHocSimulator::Run(candidateConfig, lambda)
+                                                : GroupSimulator::Run(candidateConfig, lambda);
+            double simObjective = metrics.packetLoss + config.bufferDelayWeight * metrics.delayP95;
+            
+            std::string label = (c == 0) ? "baseline" : std::to_string(c);
+            std::cout << "  " << networkType << " " << label << " [" << buffers << "]"
+                      << " model: loss " << allocation.lossRate << ", p95 " << allocation.tailDelay
+                      << " s; sim: loss " << metrics.packetLoss << ", p95 " << metrics.delayP95 << " s" << std::endl;
+            file << networkType << "," << label << "," << buffers << ","
+                 << allocation.lossRate << "," << allocation.tailDelay << "," << allocation.objective << ","
+                 << metrics.packetLoss << "," << metrics.delayP95 << "," << simObjective << "\n";
+            
+            if (simObjective < bestObjective) {
+                bestObjective = simObjective;
+                bestBuffers = label + " [" + buffers + "]";
+            }
+        }
+        std::cout << "  " << networkType << " best by simulation: " << bestBuffers << std::endl;
+    }
+}
+
 int main(int argc, char *argv[]) {
     std::cout << "Starting NS-3 Network Analysis with ENV Configuration..." << std::endl;
     std::cout << "==========================================================" << std::endl;
@@ -179,6 +736,32 @@ int main(int argc, char *argv[]) {
     int result = system("mkdir -p scratch/public");
     (void)result;
     
+    if (config.calibrationEnabled) {
+        ThroughputModelCoefficients coefficients;
+        if (ModelCalibration::Load(kCalibrationFile, coefficients)) {
+            AnalysisMethods::SetThroughputModelCoefficients(coefficients);
+            std::cout << "Loaded model calibration: " << kCalibrationFile << std::endl;
+        }
+    }
+    
+    if (config.sweepDesign != "none") {
+        RunParameterSweep(config);
+        return 0;
+    }
+    
+    SurrogateModel adHocSurrogate;
+    SurrogateModel groupSurrogate;
+    int surrogateAnswers = 0;
+    if (config.surrogateEnabled) {
+        // Только записи с теми же параметрами сети, что не входят в признаки суррогата
+        std::vector<HistoryRecord> history = ResultsHistory::LoadMatching(kHistoryFile, config);
+        adHocSurrogate.Train(history, "AdHoc");
+        groupSurrogate.Train(history, "Group");
+        std::cout << "Surrogate models - AdHoc samples: " << adHocSurrogate.Samples()
+                  << ", Group samples: " << groupSurrogate.Samples()
+                  << ", max uncertainty: " << config.surrogateMaxUncertainty * 100 << "%" << std::endl;
+    }
+    
     int numPoints = static_cast<int>((config.lambdaEnd - config.lambdaStart) / config.lambdaStep) + 1;
     std::cout << "Running " << numPoints << " simulation points..." << std::endl;
     std::cout << "Lambda range: " << config.lambdaStart << " to " << config.lambdaEnd 
@@ -192,22 +775,63 @@ int main(int argc, char *argv[]) {
         std::cout << "\n=== Simulation Point " << (i + 1) << "/" << numPoints 
                   << " (Lambda=" << lambda << ") ===" << std::endl;
         
-        SimulationMetrics adHocMetrics = AdHocSimulator::Run(config, lambda);
+        // В историю попадают только результаты симуляции, не ответы суррогата
+        SimulationConfig pointConfig = PointConfig(config, lambda);
+        SimulationMetrics adHocMetrics;
+        if (AnswerFromSurrogate(adHocSurrogate, config, lambda, adHocMetrics)) {
+            ++surrogateAnswers;
+        } else {
+            adHocMetrics = AdHocSimulator::Run(pointConfig, lambda);
+            ResultsHistory::Append(kHistoryFile, "AdHoc", pointConfig, lambda, adHocMetrics);
+        }
         adHocResults.push_back(adHocMetrics);
         
         std::cout << std::endl;
         
-        SimulationMetrics groupMetrics = GroupSimulator::Run(config, lambda);
+        SimulationMetrics groupMetrics;
+        if (AnswerFromSurrogate(groupSurrogate, config, lambda, groupMetrics)) {
+            ++surrogateAnswers;
+        } else {
+            groupMetrics = GroupSimulator::Run(pointConfig, lambda);
+            ResultsHistory::Append(kHistoryFile, "Group", pointConfig, lambda, groupMetrics);
+        }
         groupResults.push_back(groupMetrics);
         
         std::cout << "----------------------------------------" << std::endl;
         
         double adHocModel = analyzer.AdHocThroughputModel(adHocMetrics.load, config.dataRateMbps, config.numNodes);
         double groupModel = analyzer.GroupThroughputModel(groupMetrics.load, config.dataRateMbps, config.numGroups);
+        double adHocDcf = analyzer.AdHocDcfThroughputModel(OfferedLoadMbps(config, lambda), config.wifiStandard,
+                                                           config.packetSize, config.numNodes);
         
         std::cout << "Point Analysis:" << std::endl;
-        std::cout << "  AdHoc - Actual: " << adHocMetrics.throughput << " Mbps, Model: " << adHocModel << " Mbps" << std::endl;
-        std::cout << "  Group - Actual: " << groupMetrics.throughput << " Mbps, Model: " << groupModel << " Mbps" << std::endl;
+        std::cout << "  AdHoc - Actual: " << adHocMetrics.throughput << " Mbps, Model: " << adHocModel
+                  << " Mbps, DCF: " << adHocDcf << " Mbps" << std::endl;
+        std::cout << "  Group - Actual: " << groupMetrics.throughput << " Mbps, Model: " << groupModel
+                  << " Mbps, Hierarchical: " << GroupModel(config, lambda).throughputMbps << " Mbps" << std::endl;
+    }
+    
+    if (config.surrogateEnabled) {
+        std::cout << "\nSurrogate answers: " << surrogateAnswers << " of " << 2 * numPoints
+                  << " simulation runs" << std::endl;
+    }
+    
+    if (config.calibrationEnabled) {
+        CalibrationResult calibration = ModelCalibration::Fit(
+            ResultsHistory::LoadMatching(kHistoryFile, config), AnalysisMethods::GetThroughputModelCoefficients());
+        ModelCalibration::Save(calibration, kCalibrationFile);
+        AnalysisMethods::SetThroughputModelCoefficients(calibration.coefficients);
+        
+        std::cout << "\nModel Calibration (" << kHistoryFile << "):" << std::endl;
+        std::cout << "  AdHoc - contention: " << calibration.coefficients.adHocContention
+                  << ", samples: " << calibration.adHoc.samples
+                  << ", RMSE: " << calibration.adHoc.rmse << " Mbps ("
+                  << calibration.adHoc.relativeError * 100 << "%)" << std::endl;
+        std::cout << "  Group - penalty: " << calibration.coefficients.groupPenalty
+                  << ", floor: " << calibration.coefficients.groupFloor
+                  << ", samples: " << calibration.group.samples
+                  << ", RMSE: " << calibration.group.rmse << " Mbps ("
+                  << calibration.group.relativeError * 100 << "%)" << std::endl;
     }
     
     std::cout << "\n==========================================================" << std::endl;
@@ -262,6 +886,58 @@ int main(int argc, char *argv[]) {
     std::cout << "  Ad-Hoc Model Throughput: " << adHocModel << " Mbps" << std::endl;
     std::cout << "  Group Model Throughput: " << groupModel << " Mbps" << std::endl;
     
+    ClosedNetworkResult closedNetwork = analyzer.ClosedNetworkAnalysis(config.nodeLoads, config.nodeBuffers,
+                                                                       NodeServiceRates(config, true));
+    
+    std::cout << "\nClosed Network (Buzen convolution, N=" << closedNetwork.population << "):" << std::endl;
+    std::cout << "  ln G(N): " << closedNetwork.logNormalizationConstant
+              << ", System Throughput: " << closedNetwork.systemThroughput << std::endl;
+    for (size_t i = 0; i < closedNetwork.utilization.size(); ++i) {
+        std::cout << "  Node " << i << " - U: " << closedNetwork.utilization[i]
+                  << ", X: " << closedNetwork.throughput[i]
+                  << ", Q: " << closedNetwork.queueLength[i]
+                  << ", T: " << closedNetwork.residenceTime[i] << std::endl;
+    }
+    
+    // Точное решение цепи Маркова для максимальной нагрузки диапазона
+    double ctmcLambda = lambdaValues.empty() ? config.lambdaEnd : lambdaValues.back();
+    for (bool isAdHoc : {true, false}) {
+        std::cout << "\nGlobal Balance CTMC (" << (isAdHoc ? "AdHoc" : "Group")
+                  << ", Lambda=" << ctmcLambda << "):" << std::endl;
+        try {
+            CtmcNetworkResult ctmc = analyzer.GlobalBalanceNetwork(
+                ctmcLambda, config.serviceRate, config.nodeLoads, config.nodeBuffers,
+                static_cast<int>(config.bufferSize), isAdHoc ? 0 : static_cast<int>(config.numGroups));
+            std::cout << "  States: " << ctmc.numStates << ", Iterations: " << ctmc.iterations
+                      << ", Residual: " << ctmc.residual << (ctmc.converged ? "" : " (not converged)") << std::endl;
+            for (size_t i = 0; i < ctmc.throughput.size(); ++i) {
+                std::cout << "  Node " << i << " - X: " << ctmc.throughput[i]
+                          << ", Loss: " << ctmc.lossProbability[i]
+                          << ", L: " << ctmc.avgSystemSize[i]
+                          << ", T: " << ctmc.delay[i] << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cout << "  Skipped: " << e.what() << std::endl;
+        }
+    }
+    
+    for (bool isAdHoc : {true, false}) {
+        JacksonNetworkResult jackson = analyzer.JacksonNetworkAnalysis(
+            ctmcLambda, config.nodeLoads, NodeServiceRates(config, true), config.nodeBuffers,
+            static_cast<int>(config.bufferSize), isAdHoc ? 0 : static_cast<int>(config.numGroups), Backbone(config));
+        std::cout << "\nJackson Network (" << (isAdHoc ? "AdHoc" : "Group") << ", Lambda=" << ctmcLambda
+                  << ", stations: " << jackson.arrivalRate.size() << "):" << std::endl;
+        std::cout << "  Delivered: " << jackson.deliveredThroughput
+                  << ", Mean Sojourn: " << jackson.meanSojournTime << " s"
+                  << ", Iterations: " << jackson.iterations
+                  << (jackson.stable ? "" : " (unstable stations)") << std::endl;
+    }
+    
+    ReportNodeUtilization(config, lambdaValues);
+    ReportTandemDecomposition(config, lambdaValues);
+    ReportSensitivity(config, lambdaValues);
+    ReportBurstinessLoss(config, lambdaValues, adHocResults, groupResults);
+    
     AnalysisResults adHocAnalysis = AnalyzeWithAllMethods(adHocResults, config, true, lambdaValues);
     AnalysisResults groupAnalysis = AnalyzeWithAllMethods(groupResults, config, false, lambdaValues);
     
@@ -272,5 +948,13 @@ int main(int argc, char *argv[]) {
     // Записываем результаты анализа для построения графиков с четырьмя методами
     CsvWriter::WriteAnalysisWithMethods(adHocAnalysis, groupAnalysis, "scratch/public/analysis_with_methods.csv");
     
+    if (config.bufferBudget > 0) {
+        RunBufferOptimization(config);
+    }
+    
+    AnalysisCache& cache = AnalysisCache::Instance();
+    std::cout << "\nAnalysis cache: hits " << cache.Hits() << ", misses " << cache.Misses()
+              << ", entries " << cache.Size() << std::endl;
+    
     return 0;
 }
\ No newline at end of file
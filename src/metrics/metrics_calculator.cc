@@ -2,10 +2,13 @@
 #include <algorithm>
 #include <limits>
 #include <numeric> // <-- Добавлено для std::accumulate
+#include <map>
 
 SimulationMetrics MetricsCalculator::Calculate(Ptr<FlowMonitor> flowMonitor, 
                                                double simulationTime, 
-                                               const std::vector<double>& nodeLoads) {
+                                               const std::vector<double>& nodeLoads,
+                                               Ptr<Ipv4FlowClassifier> classifier,
+                                               const std::set<uint16_t>& excludedPorts) {
     SimulationMetrics metrics;
     metrics.simulationTime = simulationTime;
     
@@ -23,6 +26,8 @@ SimulationMetrics MetricsCalculator::Calculate(Ptr<FlowMonitor> flowMonitor,
     double totalTxBytes = 0;
     double totalRxBytes = 0;
     uint64_t totalHops = 0; // ИСПРАВЛЕНО: Тип изменен на uint64_t для соответствия flowStats
+    std::map<double, uint64_t> delayBins; // Объединённая гистограмма задержек: конец интервала -> число пакетов
+    uint64_t delayBinTotal = 0;
     
     metrics.nodeThroughput.clear();
     metrics.nodeDelay.clear();
@@ -31,6 +36,13 @@ SimulationMetrics MetricsCalculator::Calculate(Ptr<FlowMonitor> flowMonitor,
     metrics.nodeLostPackets.clear();
     
     for (auto& flow : stats) {
+        // Служебные потоки (порты протокола маршрутизации) не входят в метрики данных
+        if (classifier && !excludedPorts.empty()) {
+            Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow(flow.first);
+            if (excludedPorts.count(tuple.sourcePort) || excludedPorts.count(tuple.destinationPort)) {
+                continue;
+            }
+        }
         FlowMonitor::FlowStats flowStats = flow.second;
         
         totalTxPackets += flowStats.txPackets;
@@ -59,6 +71,14 @@ SimulationMetrics MetricsCalculator::Calculate(Ptr<FlowMonitor> flowMonitor,
             
             totalThroughput += flowThroughput;
             totalHops += flowStats.timesForwarded; // timesForwarded - это *сумма хопов* для *всех* rx пакетов
+            
+            const Histogram& histogram = flowStats.delayHistogram;
+            for (uint32_t bin = 0; bin < histogram.GetNBins(); ++bin) {
+                uint32_t count = histogram.GetBinCount(bin);
+                if (count == 0) continue;
+                delayBins[histogram.GetBinEnd(bin)] += count;
+                delayBinTotal += count;
+            }
             validFlows++;
             
             // -----------------------------------------------------------------
@@ -115,6 +135,17 @@ SimulationMetrics MetricsCalculator::Calculate(Ptr<FlowMonitor> flowMonitor,
     }
     
     metrics.throughput = totalThroughput;
+    
+    // Перцентиль по объединённой гистограмме (с точностью до ширины интервала)
+    metrics.delayP95 = 0;
+    uint64_t cumulative = 0;
+    for (const auto& bin : delayBins) {
+        cumulative += bin.second;
+        if (cumulative >= 0.95 * static_cast<double>(delayBinTotal)) {
+            metrics.delayP95 = bin.first;
+            break;
+        }
+    }
 
     if (delaySamples > 0) {
         // Среднее число хопов = (Сумма всех хопов) / (Сумма всех *полученных пакетов*)
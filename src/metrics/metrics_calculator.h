@@ -2,6 +2,7 @@
 
 #include "ns3/flow-monitor-module.h"
 #include "simulation_metrics.h"
+#include <set>
 #include <vector>
 
 using namespace ns3;
@@ -10,6 +11,8 @@ class MetricsCalculator {
 public:
     static SimulationMetrics Calculate(Ptr<FlowMonitor> flowMonitor, 
                                       double simulationTime, 
-                                      const std::vector<double>& nodeLoads);
+                                      const std::vector<double>& nodeLoads,
+                                      Ptr<Ipv4FlowClassifier> classifier = nullptr,
+                                      const std::set<uint16_t>& excludedPorts = {});
 };
 
@@ -0,0 +1,248 @@
+#include "results_history.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+const char* const kHeader =
+    "NetworkType,Lambda,Load,Throughput_Mbps,Delay_s,PacketLoss,"
+    "NumNodes,NumGroups,BufferSize,PacketSize,DataRate_Mbps,ServiceRate,SimulationDuration,NodeBuffer_Mean,Settings";
+
+// Значения через "/" (запятая разделяет столбцы CSV)
+template <typename T>
+void WriteList(std::ostream& stream, const std::vector<T>& values) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) stream << "/";
+        stream << values[i];
+    }
+}
+
+// Среднее и значения относительно него ("uniform", если все равны)
+void WriteProfile(std::ostream& stream, const std::vector<double>& values, bool withMean) {
+    double total = 0.0;
+    bool uniform = true;
+    for (double value : values) {
+        total += value;
+        uniform = uniform && value == values.front();
+    }
+    if (withMean) {
+        stream << (values.empty() ? 0.0 : total / values.size()) << "x";
+    }
+    if (uniform || total <= 0.0) {
+        stream << "uniform";
+        return;
+    }
+    std::vector<double> relative;
+    for (double value : values) {
+        relative.push_back(value * values.size() / total);
+    }
+    WriteList(stream, relative);
+}
+
+std::vector<std::string> SplitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        if (!field.empty() && field.back() == '\r') field.pop_back();
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+} // namespace
+
+HistoryRecord::HistoryRecord()
+    : lambda(0), load(0), throughput(0), delay(0), packetLoss(0),
+      numNodes(0), numGroups(0), bufferSize(0), packetSize(0),
+      dataRateMbps(0), serviceRate(0), simulationDuration(0), nodeBufferMean(0) {}
+
+void ResultsHistory::Append(const std::string& filename,
+                            const std::string& networkType,
+                            const SimulationConfig& config,
+                            double lambda,
+                            const SimulationMetrics& metrics) {
+    bool writeHeader = false;
+    {
+        std::ifstream existing(filename);
+        std::string header;
+        writeHeader = !std::getline(existing, header);
+        if (!header.empty() && header.back() == '\r') header.pop_back();
+        if (!writeHeader && header != kHeader) {
+            // Файл со старым набором столбцов сохраняется рядом, история начинается заново
+            existing.close();
+            std::rename(filename.c_str(), (filename + ".old").c_str());
+            writeHeader = true;
+        }
+    }
+
+    std::ofstream file(filename, std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open history file: " + filename);
+    }
+
+    if (writeHeader) {
+        file << kHeader << "\n";
+    }
+
+    file.precision(17);
+    file << networkType << "," << lambda << "," << metrics.load << ","
+         << metrics.throughput << "," << metrics.delay << "," << metrics.packetLoss << ","
+         << config.numNodes << "," << config.numGroups << "," << config.bufferSize << ","
+         << config.packetSize << "," << config.dataRateMbps << "," << config.serviceRate << ","
+         << config.simulationDuration << "," << config.MeanNodeBufferSize() << "," << Settings(networkType, config) << "\n";
+}
+
+std::string ResultsHistory::Settings(const std::string& networkType, const SimulationConfig& config) {
+    std::ostringstream settings;
+    settings.precision(12);
+    std::vector<double> capacities;
+    std::vector<double> serviceRates;
+    for (uint32_t i = 0; i < config.numNodes; ++i) {
+        capacities.push_back(config.NodeBufferSize(i));
+        serviceRates.push_back(config.NodeServiceRate(i));
+    }
+    settings << "loads=";
+    WriteProfile(settings, config.nodeLoads, true);
+    settings << ";buffers=";
+    WriteProfile(settings, capacities, false);
+    settings << ";serviceRates=";
+    WriteProfile(settings, serviceRates, true);
+    settings << ";traffic=" << config.trafficModel;
+    if (config.trafficModel == "trace") {
+        settings << ";traceFile=" << config.trafficTraceFile << ";traceScale=" << config.trafficTraceTimeScale;
+    }
+    if (config.trafficModel == "onoff") {
+        std::vector<double> hursts;
+        for (uint32_t i = 0; i < config.numNodes; ++i) {
+            hursts.push_back(config.NodeHurst(i));
+        }
+        settings << ";onoff=" << config.trafficOnOffDistribution
+                 << ";onMean=" << config.trafficOnMeanS << ";offMean=" << config.trafficOffMeanS << ";hursts=";
+        WriteProfile(settings, hursts, true);
+    }
+
+    if (networkType == "AdHoc") {
+        settings << ";wifi=" << config.wifiStandard << ";range=" << config.wifiMaxRange
+                 << ";channelWidth=" << config.wifiChannelWidth << ";rateManager=" << config.wifiRateManager
+                 << ";ampdu=" << config.wifiAmpduSize << ";amsdu=" << config.wifiAmsduSize
+                 << ";grid=" << config.gridWidth << "/" << config.gridDeltaX << "/" << config.gridDeltaY
+                 << ";routing=" << config.adhocRouting;
+    } else {
+        settings << ";groups=" << config.numGroups << ";linkDelay=" << config.linkDelayMs
+                 << ";routing=" << config.groupRouting << ";queueDisc=" << config.groupQueueDisc
+                 << ";backbone=" << config.backboneTopology;
+        if (config.backboneTopology == "tree") {
+            settings << ";fanout=" << config.backboneTreeFanout;
+        }
+        settings << ";backboneFactor=" << config.backboneRateFactor
+                 << ";backboneDelay=" << config.backboneDelayMs << ";backboneRates=";
+        WriteList(settings, config.backboneLinkRates);
+    }
+
+    std::string result = settings.str();
+    for (char& c : result) {
+        if (c == ',') c = '_'; // Запятая в пути трассы не должна сдвигать столбцы
+    }
+    return result;
+}
+
+std::vector<HistoryRecord> ResultsHistory::Load(const std::string& filename) {
+    std::vector<HistoryRecord> records;
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return records;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        return records;
+    }
+
+    std::unordered_map<std::string, size_t> column;
+    std::vector<std::string> header = SplitCsvLine(line);
+    for (size_t i = 0; i < header.size(); ++i) {
+        column[header[i]] = i;
+    }
+
+    auto index = [&column](const std::string& name) -> long {
+        auto it = column.find(name);
+        return (it == column.end()) ? -1 : static_cast<long>(it->second);
+    };
+
+    const long typeColumn = index("NetworkType");
+    const long loadColumn = index("Load");
+    const long throughputColumn = index("Throughput_Mbps");
+    if (typeColumn < 0 || loadColumn < 0 || throughputColumn < 0) {
+        throw std::runtime_error("History file has no NetworkType/Load/Throughput_Mbps columns: " + filename);
+    }
+
+    const long lambdaColumn = index("Lambda");
+    const long delayColumn = index("Delay_s");
+    const long lossColumn = index("PacketLoss");
+    const long nodesColumn = index("NumNodes");
+    const long groupsColumn = index("NumGroups");
+    const long bufferColumn = index("BufferSize");
+    const long packetColumn = index("PacketSize");
+    const long dataRateColumn = index("DataRate_Mbps");
+    const long serviceRateColumn = index("ServiceRate");
+    const long durationColumn = index("SimulationDuration");
+    const long nodeBufferColumn = index("NodeBuffer_Mean");
+    const long settingsColumn = index("Settings");
+
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields = SplitCsvLine(line);
+        if (fields.size() < header.size()) {
+            continue;
+        }
+
+        auto number = [&fields](long col) { return (col < 0) ? 0.0 : std::stod(fields[static_cast<size_t>(col)]); };
+        auto count = [&fields](long col) {
+            return (col < 0) ? 0u : static_cast<uint32_t>(std::stoul(fields[static_cast<size_t>(col)]));
+        };
+
+        try {
+            HistoryRecord record;
+            record.networkType = fields[static_cast<size_t>(typeColumn)];
+            record.lambda = number(lambdaColumn);
+            record.load = number(loadColumn);
+            record.throughput = number(throughputColumn);
+            record.delay = number(delayColumn);
+            record.packetLoss = number(lossColumn);
+            record.numNodes = count(nodesColumn);
+            record.numGroups = count(groupsColumn);
+            record.bufferSize = count(bufferColumn);
+            record.packetSize = count(packetColumn);
+            record.dataRateMbps = number(dataRateColumn);
+            record.serviceRate = number(serviceRateColumn);
+            record.simulationDuration = number(durationColumn);
+            record.nodeBufferMean = number(nodeBufferColumn);
+            if (settingsColumn >= 0) record.settings = fields[static_cast<size_t>(settingsColumn)];
+            records.push_back(record);
+        } catch (const std::exception&) {
+            // Повреждённая строка (например, прерванная запись) - пропускаем
+        }
+    }
+
+    return records;
+}
+
+std::vector<HistoryRecord> ResultsHistory::LoadMatching(const std::string& filename,
+                                                        const SimulationConfig& config) {
+    const std::string adHocSettings = Settings("AdHoc", config);
+    const std::string groupSettings = Settings("Group", config);
+
+    std::vector<HistoryRecord> records;
+    for (HistoryRecord& record : Load(filename)) {
+        if (record.settings == (record.networkType == "AdHoc" ? adHocSettings : groupSettings)) {
+            records.push_back(std::move(record));
+        }
+    }
+    return records;
+}
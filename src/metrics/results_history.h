@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../env/environment_config.h"
+#include "simulation_metrics.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Одна точка накопленной истории симуляций: параметры запуска и результат.
+ */
+struct HistoryRecord {
+    std::string networkType; // "AdHoc" или "Group"
+    double lambda;
+    double load;
+    double throughput;
+    double delay;
+    double packetLoss;
+    uint32_t numNodes;
+    uint32_t numGroups;
+    uint32_t bufferSize;
+    uint32_t packetSize;
+    double dataRateMbps;
+    double serviceRate;
+    double simulationDuration;
+    double nodeBufferMean;   // Среднее NodeBufferSize(i) - признак суррогата
+    std::string settings;    // ResultsHistory::Settings запуска (пусто - старая запись)
+
+    HistoryRecord();
+};
+
+/**
+ * История результатов симуляций между запусками (CSV с заголовком, только дозапись).
+ * Используется для калибровки аналитических моделей и суррогатной модели.
+ *
+ * Кроме признаков (lambda, bufferSize, packetSize, dataRateMbps, numNodes)
+ * каждая запись хранит строку Settings - остальные параметры, от которых
+ * зависит результат симуляции данного типа сети. Записи с другими Settings
+ * описывают другую сеть и для обучения не используются.
+ */
+class ResultsHistory {
+public:
+    static void Append(const std::string& filename,
+                       const std::string& networkType,
+                       const SimulationConfig& config,
+                       double lambda,
+                       const SimulationMetrics& metrics);
+
+    // Столбцы ищутся по заголовку; строки с ошибками разбора пропускаются
+    static std::vector<HistoryRecord> Load(const std::string& filename);
+
+    // Записи, Settings которых совпадают с Settings(networkType записи, config)
+    static std::vector<HistoryRecord> LoadMatching(const std::string& filename,
+                                                   const SimulationConfig& config);
+
+    // "ключ=значение;..." без запятых: параметры config, не входящие в признаки.
+    // Ёмкости узлов - только профиль относительно среднего ("uniform", если все
+    // равны; среднее - признак), нагрузки - среднее и профиль, чтобы записи
+    // с разными NUM_NODES / BUFFER_SIZE совпадали
+    static std::string Settings(const std::string& networkType, const SimulationConfig& config);
+};
@@ -1,7 +1,10 @@
 #include "simulation_metrics.h"
 
 SimulationMetrics::SimulationMetrics()
-    : throughput(0), delay(0), packetLoss(0), load(0),
+    : throughput(0), delay(0), delayP95(0), packetLoss(0), load(0),
       txPackets(0), rxPackets(0), lostPackets(0), droppedPackets(0),
-      jitter(0), avgHopCount(0), txBytes(0), rxBytes(0), simulationTime(0) {}
+      jitter(0), avgHopCount(0), txBytes(0), rxBytes(0), simulationTime(0),
+      routingOverheadPackets(0), routingOverheadBytes(0),
+      aqmDroppedPackets(0),
+      backboneMaxUtilization(0), backboneMeanUtilization(0) {}
 
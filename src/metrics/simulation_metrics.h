@@ -6,6 +6,7 @@
 struct SimulationMetrics {
     double throughput;
     double delay;
+    double delayP95;   // 95-й перцентиль задержки по гистограммам FlowMonitor
     double packetLoss;
     double load;
     uint32_t txPackets;
@@ -17,6 +18,11 @@ struct SimulationMetrics {
     double txBytes;
     double rxBytes;
     double simulationTime;
+    uint32_t routingOverheadPackets;  // Служебные пакеты протокола маршрутизации (с ретрансляциями)
+    double routingOverheadBytes;
+    uint32_t aqmDroppedPackets;       // Потери корневых дисциплин очереди (AQM и переполнение)
+    double backboneMaxUtilization;    // Загрузка самого загруженного направления связи магистрали
+    double backboneMeanUtilization;
     std::map<uint32_t, double> nodeThroughput;
     std::map<uint32_t, double> nodeDelay;
     std::map<uint32_t, uint32_t> nodeTxPackets;
@@ -0,0 +1,92 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t numThreads)
+    : m_stopping(false) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_threads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::Size() const {
+    return m_threads.size();
+}
+
+std::future<void> WorkerPool::Submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> future = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(packaged));
+    }
+    m_condition.notify_one();
+    return future;
+}
+
+void WorkerPool::ParallelFor(size_t count,
+                             const std::function<void(size_t, size_t)>& fn,
+                             size_t maxChunks) {
+    if (count == 0) return;
+
+    size_t chunks = (maxChunks == 0) ? Size() : maxChunks;
+    chunks = std::max<size_t>(1, std::min(chunks, count));
+
+    // Один блок - выполняем в вызывающем потоке без накладных расходов
+    if (chunks == 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks);
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+        size_t end = std::min(count, begin + chunkSize);
+        futures.push_back(Submit([&fn, begin, end]() { fn(begin, end); }));
+    }
+
+    // Дожидаемся всех блоков до проброса исключения: задачи ссылаются на fn
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+WorkerPool& WorkerPool::Shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+void WorkerPool::WorkerLoop() {
+    for (;;) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * Пул рабочих потоков для параллельных аналитических расчётов.
+ *
+ * Примечание: симулятор ns-3 - глобальный синглтон, поэтому сами симуляции
+ * в потоках пула не запускаются; пул предназначен для чистых вычислений.
+ * ParallelFor нельзя вызывать изнутри задачи этого же пула.
+ */
+class WorkerPool {
+public:
+    // numThreads = 0 - по числу аппаратных потоков
+    explicit WorkerPool(size_t numThreads = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t Size() const;
+
+    std::future<void> Submit(std::function<void()> task);
+
+    /**
+     * Делит диапазон [0, count) на не более чем maxChunks блоков и выполняет
+     * fn(begin, end) для каждого блока параллельно. Возвращает управление после
+     * завершения всех блоков; исключение из блока пробрасывается вызывающему.
+     * maxChunks = 0 - по числу потоков пула.
+     */
+    void ParallelFor(size_t count,
+                     const std::function<void(size_t, size_t)>& fn,
+                     size_t maxChunks = 0);
+
+    // Общий пул процесса
+    static WorkerPool& Shared();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::queue<std::packaged_task<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping;
+};
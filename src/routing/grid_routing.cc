@@ -0,0 +1,82 @@
+#include "grid_routing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+using namespace ns3;
+
+std::vector<GridRouting::Position> GridRouting::GridPositions(uint32_t numNodes, uint32_t gridWidth,
+                                                              double deltaX, double deltaY) {
+    const uint32_t width = std::max<uint32_t>(gridWidth, 1);
+    std::vector<Position> positions(numNodes);
+    for (uint32_t i = 0; i < numNodes; ++i) {
+        positions[i].x = (i % width) * deltaX;
+        positions[i].y = (i / width) * deltaY;
+    }
+    return positions;
+}
+
+std::vector<std::vector<int>> GridRouting::NextHops(const std::vector<Position>& positions, double range) {
+    const size_t n = positions.size();
+    std::vector<std::vector<int>> neighbors(n);
+    for (size_t a = 0; a < n; ++a) {
+        for (size_t b = a + 1; b < n; ++b) {
+            double distance = std::hypot(positions[a].x - positions[b].x, positions[a].y - positions[b].y);
+            if (distance <= range) {
+                neighbors[a].push_back(static_cast<int>(b));
+                neighbors[b].push_back(static_cast<int>(a));
+            }
+        }
+    }
+
+    // Поиск в ширину от каждого источника: первый переход наследуется от родителя
+    std::vector<std::vector<int>> nextHops(n, std::vector<int>(n, -1));
+    for (size_t source = 0; source < n; ++source) {
+        std::vector<int>& next = nextHops[source];
+        next[source] = static_cast<int>(source);
+        std::queue<int> frontier;
+        for (int neighbor : neighbors[source]) {
+            next[neighbor] = neighbor;
+            frontier.push(neighbor);
+        }
+        while (!frontier.empty()) {
+            int node = frontier.front();
+            frontier.pop();
+            for (int neighbor : neighbors[node]) {
+                if (next[neighbor] >= 0) continue;
+                next[neighbor] = next[node];
+                frontier.push(neighbor);
+            }
+        }
+    }
+    return nextHops;
+}
+
+uint32_t GridRouting::Install(const Ipv4InterfaceContainer& interfaces,
+                              const std::vector<std::vector<int>>& nextHops) {
+    Ipv4StaticRoutingHelper staticRouting;
+    uint32_t routes = 0;
+    for (uint32_t source = 0; source < nextHops.size(); ++source) {
+        std::pair<Ptr<Ipv4>, uint32_t> local = interfaces.Get(source);
+        Ptr<Ipv4StaticRouting> routing = staticRouting.GetStaticRouting(local.first);
+        for (uint32_t destination = 0; destination < nextHops[source].size(); ++destination) {
+            int next = nextHops[source][destination];
+            // Соседи и недостижимые узлы - по маршруту подсети
+            if (next < 0 || static_cast<uint32_t>(next) == destination) continue;
+            routing->AddHostRouteTo(interfaces.GetAddress(destination), interfaces.GetAddress(next), local.second);
+            ++routes;
+        }
+    }
+    return routes;
+}
+
+uint32_t GridRouting::UnreachablePairs(const std::vector<std::vector<int>>& nextHops) {
+    uint32_t unreachable = 0;
+    for (const auto& row : nextHops) {
+        for (int next : row) {
+            if (next < 0) ++unreachable;
+        }
+    }
+    return unreachable;
+}
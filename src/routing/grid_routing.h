@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Статическая многошаговая маршрутизация AdHocSimulator (ADHOC_ROUTING=static).
+ * Граф связности строится по координатам решётки (как у GridPositionAllocator,
+ * RowFirst) и дальности RangePropagationLossModel: узлы соседние, если
+ * расстояние не больше wifiMaxRange. Кратчайшие по числу переходов пути
+ * считаются поиском в ширину от каждого узла и устанавливаются маршрутами
+ * к узлам /32; соседям пакеты идут напрямую по маршруту подсети.
+ */
+class GridRouting {
+public:
+    struct Position {
+        double x;
+        double y;
+    };
+
+    static std::vector<Position> GridPositions(uint32_t numNodes, uint32_t gridWidth,
+                                               double deltaX, double deltaY);
+
+    // nextHop[s][d] - следующий узел на пути s -> d (s при s == d, -1 - недостижим)
+    static std::vector<std::vector<int>> NextHops(const std::vector<Position>& positions, double range);
+
+    // Маршруты к узлам на расстоянии от двух переходов; возвращает их число.
+    // interfaces[i] - интерфейс Wi-Fi узла nodes.Get(i)
+    static uint32_t Install(const ns3::Ipv4InterfaceContainer& interfaces,
+                            const std::vector<std::vector<int>>& nextHops);
+
+    // Число пар (s, d), s != d, без пути
+    static uint32_t UnreachablePairs(const std::vector<std::vector<int>>& nextHops);
+};
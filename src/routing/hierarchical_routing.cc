@@ -0,0 +1,140 @@
+#include "hierarchical_routing.h"
+
+#include <algorithm>
+
+using namespace ns3;
+
+std::vector<std::pair<uint32_t, uint32_t>> HierarchicalRouting::CoverOctets(uint32_t first, uint32_t last) {
+    std::vector<std::pair<uint32_t, uint32_t>> prefixes;
+    uint64_t octet = first;
+    while (octet <= last) {
+        // Наибольший выровненный блок, начинающийся с octet и не выходящий за last
+        uint32_t bits = 0;
+        while (bits < 8 && octet % (uint64_t(1) << (bits + 1)) == 0 &&
+               octet + (uint64_t(1) << (bits + 1)) - 1 <= last) {
+            ++bits;
+        }
+        prefixes.emplace_back(static_cast<uint32_t>(octet), 24 - bits);
+        octet += uint64_t(1) << bits;
+    }
+    return prefixes;
+}
+
+uint32_t HierarchicalRouting::InstallMemberRoutes(const std::vector<NodeContainer>& groups,
+                                                  const std::vector<Ipv4InterfaceContainer>& groupInterfaces) {
+    Ipv4StaticRoutingHelper staticRouting;
+    uint32_t routes = 0;
+
+    // Обычные узлы: всё, что вне своей подсети, - через главный узел
+    for (uint32_t g = 0; g < groups.size(); ++g) {
+        const Ipv4Address master = groupInterfaces[g].GetAddress(0);
+        for (uint32_t k = 1; k < groups[g].GetN(); ++k) {
+            std::pair<Ptr<Ipv4>, uint32_t> local = groupInterfaces[g].Get(k);
+            staticRouting.GetStaticRouting(local.first)->SetDefaultRoute(master, local.second);
+            ++routes;
+        }
+    }
+    return routes;
+}
+
+uint32_t HierarchicalRouting::Install(const std::vector<NodeContainer>& groups,
+                                      const std::vector<Ipv4InterfaceContainer>& groupInterfaces,
+                                      const Ipv4InterfaceContainer& backboneInterfaces) {
+    Ipv4StaticRoutingHelper staticRouting;
+    const uint32_t numGroups = static_cast<uint32_t>(groups.size());
+    uint32_t routes = InstallMemberRoutes(groups, groupInterfaces);
+    if (numGroups < 2) return routes;
+
+    // Главные узлы: индексы устройств магистрали (локальное, соседнее)
+    auto addRoute = [&](uint32_t localIdx, uint32_t remoteIdx, bool isDefault,
+                        uint32_t octet = 0, uint32_t prefixLength = 0) {
+        std::pair<Ptr<Ipv4>, uint32_t> local = backboneInterfaces.Get(localIdx);
+        Ptr<Ipv4StaticRouting> routing = staticRouting.GetStaticRouting(local.first);
+        const Ipv4Address nextHop = backboneInterfaces.GetAddress(remoteIdx);
+        if (isDefault) {
+            routing->SetDefaultRoute(nextHop, local.second);
+        } else {
+            routing->AddNetworkRouteTo(Ipv4Address((10u << 24) | (1u << 16) | (octet << 8)),
+                                       Ipv4Mask(~0u << (32 - prefixLength)), nextHop, local.second);
+        }
+        ++routes;
+    };
+
+    if (numGroups == 2) {
+        // Одна связь: всё через соседа
+        addRoute(0, 1, true);
+        addRoute(1, 0, true);
+        return routes;
+    }
+
+    // Против часовой стрелки - группы на расстоянии d > G / 2 по часовой
+    const uint32_t counterClockwise = numGroups - 1 - numGroups / 2;
+    for (uint32_t g = 0; g < numGroups; ++g) {
+        const uint32_t prev = (g + numGroups - 1) % numGroups;
+        addRoute(2 * g, 2 * g + 1, true);
+
+        // Группы g - counterClockwise .. g - 1 (по модулю G), октет = номер группы + 1
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        if (counterClockwise == 0) {
+            // Нет групп, до которых короче против часовой стрелки
+        } else if (g >= counterClockwise) {
+            ranges.emplace_back(g - counterClockwise, g - 1);
+        } else {
+            if (g > 0) ranges.emplace_back(0, g - 1);
+            ranges.emplace_back(numGroups - (counterClockwise - g), numGroups - 1);
+        }
+        for (const auto& range : ranges) {
+            for (const auto& prefix : CoverOctets(range.first + 1, range.second + 1)) {
+                addRoute(2 * prev + 1, 2 * prev, false, prefix.first, prefix.second);
+            }
+        }
+    }
+    return routes;
+}
+
+uint32_t HierarchicalRouting::InstallShortestPaths(const std::vector<NodeContainer>& groups,
+                                                   const std::vector<Ipv4InterfaceContainer>& groupInterfaces,
+                                                   const std::vector<BackboneLink>& links,
+                                                   const Ipv4InterfaceContainer& backboneInterfaces) {
+    Ipv4StaticRoutingHelper staticRouting;
+    const uint32_t numGroups = static_cast<uint32_t>(groups.size());
+    uint32_t routes = InstallMemberRoutes(groups, groupInterfaces);
+
+    for (uint32_t g = 0; g < numGroups; ++g) {
+        // Первая связь кратчайшего пути к каждой группе (тот же поиск в ширину, что у аналитических моделей)
+        std::vector<int> firstLink(numGroups, -1);
+        for (uint32_t h = 0; h < numGroups; ++h) {
+            std::vector<uint32_t> path = BackboneTopology::Path(links, numGroups, g, h);
+            if (!path.empty()) firstLink[h] = static_cast<int>(path.front() / 2);
+        }
+        if (std::all_of(firstLink.begin(), firstLink.end(), [](int link) { return link < 0; })) continue;
+
+        // Связь, по которой идёт больше всего групп, - маршрут по умолчанию
+        std::vector<uint32_t> usage(links.size(), 0);
+        for (uint32_t h = 0; h < numGroups; ++h) {
+            if (firstLink[h] >= 0) ++usage[firstLink[h]];
+        }
+        const uint32_t defaultLink = static_cast<uint32_t>(
+            std::max_element(usage.begin(), usage.end()) - usage.begin());
+
+        auto interfaceOf = [&](uint32_t link, bool local) {
+            bool isA = links[link].a == g;
+            return 2 * link + ((isA == local) ? 0 : 1);
+        };
+        std::pair<Ptr<Ipv4>, uint32_t> localDefault = backboneInterfaces.Get(interfaceOf(defaultLink, true));
+        Ptr<Ipv4StaticRouting> routing = staticRouting.GetStaticRouting(localDefault.first);
+        routing->SetDefaultRoute(backboneInterfaces.GetAddress(interfaceOf(defaultLink, false)), localDefault.second);
+        ++routes;
+
+        for (uint32_t h = 0; h < numGroups; ++h) {
+            if (firstLink[h] < 0 || static_cast<uint32_t>(firstLink[h]) == defaultLink) continue;
+            const uint32_t link = static_cast<uint32_t>(firstLink[h]);
+            std::pair<Ptr<Ipv4>, uint32_t> local = backboneInterfaces.Get(interfaceOf(link, true));
+            routing->AddNetworkRouteTo(Ipv4Address((10u << 24) | (1u << 16) | ((h + 1) << 8)),
+                                       Ipv4Mask("255.255.255.0"),
+                                       backboneInterfaces.GetAddress(interfaceOf(link, false)), local.second);
+            ++routes;
+        }
+    }
+    return routes;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../simulation/backbone_topology.h"
+
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Статическая иерархическая маршрутизация GroupSimulator (GROUP_ROUTING=static)
+ * вместо SPF Ipv4GlobalRoutingHelper по всем узлам. Адресация регулярна:
+ * группа g - подсеть 10.1.<g+1>.0/24, главные узлы соединены кольцом
+ * магистрали 10.0.0.0/24, поэтому следующий переход считается на уровне групп:
+ * - обычный узел - маршрут по умолчанию через главный узел своей группы;
+ * - главный узел - группы, до которых короче против часовой стрелки, одним
+ *   блоком агрегированных префиксов через предыдущий узел кольца, остальные -
+ *   маршрут по умолчанию через следующий.
+ * На главный узел приходится O(log G) маршрутов, общее время установки -
+ * O(N + G log G) вместо SPF по всем узлам.
+ *
+ * Для других топологий магистрали (BACKBONE_TOPOLOGY) следующие переходы
+ * главных узлов ищутся поиском в ширину по графу групп: маршрут по умолчанию -
+ * через связь, по которой идёт больше всего групп, для остальных групп - по
+ * маршруту к подсети /24 (у листьев звезды и дерева - только маршрут по умолчанию).
+ */
+class HierarchicalRouting {
+public:
+    // Канал кольца i соединяет главные узлы групп i и (i + 1) % G, его
+    // устройства - backboneDevices[2i], [2i + 1]. Возвращает число маршрутов
+    static uint32_t Install(const std::vector<ns3::NodeContainer>& groups,
+                            const std::vector<ns3::Ipv4InterfaceContainer>& groupInterfaces,
+                            const ns3::Ipv4InterfaceContainer& backboneInterfaces);
+
+    // Произвольная магистраль: связь i - links[i], устройства backboneDevices[2i], [2i + 1]
+    static uint32_t InstallShortestPaths(const std::vector<ns3::NodeContainer>& groups,
+                                         const std::vector<ns3::Ipv4InterfaceContainer>& groupInterfaces,
+                                         const std::vector<BackboneLink>& links,
+                                         const ns3::Ipv4InterfaceContainer& backboneInterfaces);
+
+    // Наименьший набор префиксов (третий октет, длина префикса), покрывающий
+    // подсети 10.1.<first..last>.0/24
+    static std::vector<std::pair<uint32_t, uint32_t>> CoverOctets(uint32_t first, uint32_t last);
+
+private:
+    // Маршруты по умолчанию обычных узлов через главный узел группы
+    static uint32_t InstallMemberRoutes(const std::vector<ns3::NodeContainer>& groups,
+                                        const std::vector<ns3::Ipv4InterfaceContainer>& groupInterfaces);
+};
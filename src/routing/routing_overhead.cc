@@ -0,0 +1,37 @@
+#include "routing_overhead.h"
+
+#include "ns3/core-module.h"
+
+#include <utility>
+
+using namespace ns3;
+
+RoutingOverhead::RoutingOverhead(std::set<uint16_t> ports, double startTime)
+    : m_ports(std::move(ports)),
+      m_startTime(startTime),
+      m_packets(0),
+      m_bytes(0.0) {}
+
+void RoutingOverhead::Install(const NodeContainer& nodes) {
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+        Ptr<Ipv4L3Protocol> ipv4 = nodes.Get(i)->GetObject<Ipv4L3Protocol>();
+        if (!ipv4) continue;
+        ipv4->TraceConnectWithoutContext("Tx", MakeCallback(&RoutingOverhead::OnTx, this));
+    }
+}
+
+void RoutingOverhead::OnTx(Ptr<const Packet> packet, Ptr<Ipv4> /*ipv4*/, uint32_t /*interface*/) {
+    if (Simulator::Now().GetSeconds() < m_startTime) return;
+
+    // Пакет трассы Tx уже содержит заголовок IPv4
+    Ptr<Packet> copy = packet->Copy();
+    Ipv4Header ipHeader;
+    copy->RemoveHeader(ipHeader);
+    if (ipHeader.GetProtocol() != UdpL4Protocol::PROT_NUMBER || ipHeader.GetFragmentOffset() != 0) return;
+    UdpHeader udpHeader;
+    copy->PeekHeader(udpHeader);
+    if (!m_ports.count(udpHeader.GetDestinationPort()) && !m_ports.count(udpHeader.GetSourcePort())) return;
+
+    ++m_packets;
+    m_bytes += packet->GetSize();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <cstdint>
+#include <set>
+
+/**
+ * Служебный трафик протокола маршрутизации (OLSR, AODV): IP-пакеты UDP на
+ * портах протокола, переданные любым узлом после startTime, включая
+ * ретрансляции. Считается по трассе Tx Ipv4L3Protocol, а не FlowMonitor,
+ * потому что широковещательные пакеты не образуют потоков с одним получателем.
+ */
+class RoutingOverhead {
+public:
+    static const uint16_t kOlsrPort = 698;
+    static const uint16_t kAodvPort = 654;
+
+    RoutingOverhead(std::set<uint16_t> ports, double startTime);
+
+    void Install(const ns3::NodeContainer& nodes);
+
+    uint32_t Packets() const { return m_packets; }
+    double Bytes() const { return m_bytes; }
+
+private:
+    void OnTx(ns3::Ptr<const ns3::Packet> packet, ns3::Ptr<ns3::Ipv4> ipv4, uint32_t interface);
+
+    std::set<uint16_t> m_ports;
+    double m_startTime;
+    uint32_t m_packets;
+    double m_bytes;
+};
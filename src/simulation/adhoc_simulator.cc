@@ -1,5 +1,9 @@
 #include "adhoc_simulator.h"
 #include "../metrics/metrics_calculator.h"
+#include "../routing/grid_routing.h"
+#include "../routing/routing_overhead.h"
+#include "../trace/packet_tracer.h"
+#include "../traffic/traffic_installer.h"
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
@@ -7,10 +11,76 @@
 #include "ns3/wifi-module.h"
 #include "ns3/mobility-module.h"
 #include "ns3/flow-monitor-module.h"
+#include "ns3/olsr-module.h"
+#include "ns3/aodv-module.h"
+#include "ns3/traffic-control-module.h"
 #include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace ns3;
 
+namespace {
+
+WifiStandard StandardFromName(const std::string& name) {
+    if (name == "80211b") return WIFI_STANDARD_80211b;
+    if (name == "80211g") return WIFI_STANDARD_80211g;
+    if (name == "80211n") return WIFI_STANDARD_80211n;
+    if (name == "80211ac") return WIFI_STANDARD_80211ac;
+    if (name == "80211ax") return WIFI_STANDARD_80211ax;
+    return WIFI_STANDARD_80211a;
+}
+
+// Режимы без согласования скорости: наибольшая скорость стандарта для одного
+// потока при любой ширине канала и базовая скорость управляющих кадров
+std::string ConstantDataMode(const std::string& standard) {
+    if (standard == "80211b") return "DsssRate11Mbps";
+    if (standard == "80211g") return "ErpOfdmRate54Mbps";
+    if (standard == "80211n") return "HtMcs7";
+    if (standard == "80211ac") return "VhtMcs8";
+    if (standard == "80211ax") return "HeMcs11";
+    return "OfdmRate54Mbps";
+}
+
+std::string ControlMode(const std::string& standard) {
+    if (standard == "80211b") return "DsssRate1Mbps";
+    if (standard == "80211g") return "ErpOfdmRate6Mbps";
+    return "OfdmRate6Mbps";
+}
+
+// Поддерживаемые кадровые скорости без HT (NODE_X_SERVICE_RATE), по возрастанию
+std::vector<std::pair<double, std::string>> LegacyModes(const std::string& standard) {
+    if (standard == "80211b") {
+        return {{1, "DsssRate1Mbps"}, {2, "DsssRate2Mbps"}, {5.5, "DsssRate5_5Mbps"}, {11, "DsssRate11Mbps"}};
+    }
+    const std::string prefix = (standard == "80211g") ? "ErpOfdmRate" : "OfdmRate";
+    std::vector<std::pair<double, std::string>> modes;
+    for (uint32_t rate : {6, 9, 12, 18, 24, 36, 48, 54}) {
+        modes.emplace_back(rate, prefix + std::to_string(rate) + "Mbps");
+    }
+    return modes;
+}
+
+// Управление скоростью WIFI_RATE_MANAGER
+void SetRateManager(WifiHelper& wifi, const SimulationConfig& config) {
+    if (config.wifiRateManager == "constant") {
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode", StringValue(ConstantDataMode(config.wifiStandard)),
+                                     "ControlMode", StringValue(ControlMode(config.wifiStandard)));
+    } else if (config.wifiRateManager == "minstrel") {
+        bool highThroughput = config.wifiStandard == "80211n" || config.wifiStandard == "80211ac" ||
+                              config.wifiStandard == "80211ax";
+        wifi.SetRemoteStationManager(highThroughput ? "ns3::MinstrelHtWifiManager" : "ns3::MinstrelWifiManager");
+    } else {
+        wifi.SetRemoteStationManager("ns3::IdealWifiManager");
+    }
+}
+
+} // namespace
+
 SimulationMetrics AdHocSimulator::Run(const SimulationConfig& config, double lambda) {
     std::cout << "=== Running Ad-Hoc Simulation (Lambda=" << lambda << ") ===" << std::endl;
     
@@ -18,9 +88,10 @@ SimulationMetrics AdHocSimulator::Run(const SimulationConfig& config, double lam
     NodeContainer nodes;
     nodes.Create(config.numNodes);
     
-    // Настраиваем WiFi
+    // Настраиваем WiFi (WIFI_STANDARD, WIFI_RATE_MANAGER)
     WifiHelper wifi;
-    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetStandard(StandardFromName(config.wifiStandard));
+    SetRateManager(wifi, config);
     
     YansWifiChannelHelper wifiChannel;
     wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
@@ -29,39 +100,121 @@ SimulationMetrics AdHocSimulator::Run(const SimulationConfig& config, double lam
     
     YansWifiPhyHelper wifiPhy;
     wifiPhy.SetChannel(wifiChannel.Create());
+    if (config.wifiChannelWidth > 0) {
+        // Номер канала 0 - первый канал заданной ширины в диапазоне
+        std::string band = (config.wifiStandard == "80211b" || config.wifiStandard == "80211g")
+            ? "BAND_2_4GHZ" : "BAND_5GHZ";
+        wifiPhy.Set("ChannelSettings", StringValue("{0, " + std::to_string(config.wifiChannelWidth) +
+                                                   ", " + band + ", 0}"));
+    }
     
     WifiMacHelper wifiMac;
     wifiMac.SetType("ns3::AdhocWifiMac");
     
-    NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, nodes);
+    // Значение по умолчанию должно быть задано до создания устройств
+    Config::SetDefault("ns3::WifiMacQueue::MaxSize", 
+                     QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, config.bufferSize)));
     
-    // Размещаем узлы в решетке 3x3
+    NetDeviceContainer devices;
+    if (config.HasHeterogeneousServiceRates()) {
+        // NODE_X_SERVICE_RATE: узел со своей интенсивностью получает фиксированную
+        // кадровую скорость без HT - ближайшую снизу к наибольшей скорости стандарта
+        // без HT, умноженной на NODE_X_SERVICE_RATE / SERVICE_RATE (dataRateMbps -
+        // скорость CSMA, к Wi-Fi не относится); остальные узлы - WIFI_RATE_MANAGER
+        const std::vector<std::pair<double, std::string>> modes = LegacyModes(config.wifiStandard);
+        const double referenceRate = modes.back().first;
+        for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+            if (config.NodeServiceRate(i) == config.serviceRate) {
+                SetRateManager(wifi, config);
+            } else {
+                const double targetRate = referenceRate * config.NodeServiceRate(i) / config.serviceRate;
+                std::string mode = modes.front().second;
+                for (const auto& candidate : modes) {
+                    if (candidate.first <= targetRate) mode = candidate.second;
+                }
+                wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                             "DataMode", StringValue(mode),
+                                             "ControlMode", StringValue(ControlMode(config.wifiStandard)));
+            }
+            devices.Add(wifi.Install(wifiPhy, wifiMac, nodes.Get(i)));
+        }
+    } else {
+        devices = wifi.Install(wifiPhy, wifiMac, nodes);
+    }
+    
+    // Поузловые ёмкости очередей MAC (NODE_X_BUFFER) и агрегация кадров
+    // (WIFI_AMPDU_SIZE, WIFI_AMSDU_SIZE; трафик UDP идёт в AC_BE)
+    for (uint32_t i = 0; i < devices.GetN(); ++i) {
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        Ptr<WifiMac> mac = device->GetMac();
+        QueueSize maxSize(QueueSizeUnit::PACKETS, config.NodeBufferSize(i));
+        if (mac->GetQosSupported()) {
+            for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO}) {
+                mac->GetQosTxop(ac)->GetWifiMacQueue()->SetMaxSize(maxSize);
+            }
+            if (config.wifiAmpduSize >= 0) {
+                mac->SetAttribute("BE_MaxAmpduSize", UintegerValue(static_cast<uint32_t>(config.wifiAmpduSize)));
+            }
+            if (config.wifiAmsduSize >= 0) {
+                mac->SetAttribute("BE_MaxAmsduSize", UintegerValue(static_cast<uint32_t>(config.wifiAmsduSize)));
+            }
+        } else {
+            mac->GetTxop()->GetWifiMacQueue()->SetMaxSize(maxSize);
+        }
+    }
+    
+    // Размещаем узлы в решетке шириной gridWidth (по умолчанию 3x3)
     MobilityHelper mobility;
     mobility.SetPositionAllocator("ns3::GridPositionAllocator",
                                  "MinX", DoubleValue(0.0),
                                  "MinY", DoubleValue(0.0),
                                  "DeltaX", DoubleValue(config.gridDeltaX),
                                  "DeltaY", DoubleValue(config.gridDeltaY),
-                                 "GridWidth", UintegerValue(3),  // Фиксированная ширина решетки 3
+                                 "GridWidth", UintegerValue(config.gridWidth),
                                  "LayoutType", StringValue("RowFirst"));
     
     mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
     mobility.Install(nodes);
     
-    // Устанавливаем стек протоколов
+    // Устанавливаем стек протоколов (ADHOC_ROUTING=olsr / aodv - с протоколом маршрутизации)
     InternetStackHelper internet;
+    std::set<uint16_t> controlPorts;
+    if (config.adhocRouting == "olsr") {
+        OlsrHelper olsr;
+        Ipv4StaticRoutingHelper staticRouting;
+        Ipv4ListRoutingHelper list;
+        list.Add(staticRouting, 0);
+        list.Add(olsr, 10);
+        internet.SetRoutingHelper(list);
+        controlPorts.insert(RoutingOverhead::kOlsrPort);
+    } else if (config.adhocRouting == "aodv") {
+        AodvHelper aodv;
+        internet.SetRoutingHelper(aodv);
+        controlPorts.insert(RoutingOverhead::kAodvPort);
+    }
     internet.Install(nodes);
     
     Ipv4AddressHelper ipv4;
     ipv4.SetBase("10.1.1.0", "255.255.255.0");
     Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
     
-    // Настройка буферов для узлов - пропускаем, так как WiFi не поддерживает прямой доступ к TxQueue
-    // Вместо этого используем параметры QoS
-    Config::SetDefault("ns3::WifiMacQueue::MaxSize", 
-                     QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, config.bufferSize)));
+    // Assign ставит FqCoDel ns-3 перед устройством: без его снятия очередь
+    // копилась бы в дисциплине, а не в очереди MAC ёмкостью NODE_X_BUFFER
+    TrafficControlHelper trafficControl;
+    trafficControl.Uninstall(devices);
+    
+    // ADHOC_ROUTING=static: кратчайшие пути по графу связности решётки
+    if (config.adhocRouting == "static") {
+        std::vector<std::vector<int>> nextHops = GridRouting::NextHops(
+            GridRouting::GridPositions(nodes.GetN(), config.gridWidth, config.gridDeltaX, config.gridDeltaY),
+            config.wifiMaxRange);
+        uint32_t routes = GridRouting::Install(interfaces, nextHops);
+        std::cout << "Static grid routing: " << routes << " multi-hop routes, "
+                  << GridRouting::UnreachablePairs(nextHops) << " unreachable pairs" << std::endl;
+    }
     
     Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    TrafficInstaller traffic(config, lambda);
     
     // Создаем приложения для каждого узла
     for (uint32_t i = 0; i < nodes.GetN(); ++i) {
@@ -79,15 +232,7 @@ SimulationMetrics AdHocSimulator::Run(const SimulationConfig& config, double lam
             serverApp.Start(Seconds(0.0));
             serverApp.Stop(Seconds(config.simulationDuration));
             
-            UdpClientHelper client(interfaces.GetAddress(receiverIdx), port);
-            // Убираем ограничение MaxPackets, чтобы нагрузка росла с Lambda
-            // Количество пакетов = lambda * simulationDuration
-            uint32_t totalPackets = static_cast<uint32_t>(nodeLambda * config.simulationDuration * 1.5);
-            client.SetAttribute("MaxPackets", UintegerValue(totalPackets));
-            client.SetAttribute("Interval", TimeValue(Seconds(1.0 / nodeLambda)));
-            client.SetAttribute("PacketSize", UintegerValue(config.packetSize));
-            
-            ApplicationContainer clientApp = client.Install(nodes.Get(i));
+            ApplicationContainer clientApp = traffic.Install(nodes.Get(i), i, interfaces.GetAddress(receiverIdx), port);
             double startTime = rv->GetValue(config.startTimeMin, config.startTimeMax);
             clientApp.Start(Seconds(startTime));
             clientApp.Stop(Seconds(config.simulationDuration - 0.1));
@@ -95,15 +240,42 @@ SimulationMetrics AdHocSimulator::Run(const SimulationConfig& config, double lam
     }
     
     FlowMonitorHelper flowMonitor;
+    flowMonitor.SetMonitorAttribute("StartTime", TimeValue(Seconds(config.warmupTime)));
     Ptr<FlowMonitor> monitor = flowMonitor.InstallAll();
     
+    std::unique_ptr<RoutingOverhead> overhead;
+    if (!controlPorts.empty()) {
+        overhead = std::make_unique<RoutingOverhead>(controlPorts, config.warmupTime);
+        overhead->Install(nodes);
+    }
+    
+    std::unique_ptr<PacketTracer> tracer;
+    if (config.packetTrace) {
+        tracer = std::make_unique<PacketTracer>(PacketTracer::FileName("AdHoc", lambda), config.packetTraceSampling);
+        tracer->Install(nodes);
+    }
+    
     Simulator::Stop(Seconds(config.simulationDuration));
     Simulator::Run();
     
-    SimulationMetrics metrics = MetricsCalculator::Calculate(monitor, config.simulationDuration, config.nodeLoads);
+    // Интервал измерений - после разогрева
+    double measuredTime = config.simulationDuration - config.warmupTime;
+    SimulationMetrics metrics = MetricsCalculator::Calculate(
+        monitor, measuredTime, config.nodeLoads,
+        DynamicCast<Ipv4FlowClassifier>(flowMonitor.GetClassifier()), controlPorts);
+    if (overhead) {
+        metrics.routingOverheadPackets = overhead->Packets();
+        metrics.routingOverheadBytes = overhead->Bytes();
+    }
     
     Simulator::Destroy();
     
+    // Трасса закрывается после Destroy: события очередей могут приходить до конца симуляции
+    if (tracer) {
+        tracer->Close();
+        std::cout << "Packet trace: " << tracer->RecordsWritten() << " records" << std::endl;
+    }
+    
     return metrics;
 }
 
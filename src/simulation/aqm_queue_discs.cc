@@ -0,0 +1,79 @@
+#include "aqm_queue_discs.h"
+
+#include "ns3/core-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <algorithm>
+
+using namespace ns3;
+
+namespace {
+
+// Очередь устройства под AQM: один пакет в передаче, остальное - в дисциплине
+const uint32_t kAqmDeviceQueuePackets = 1;
+
+void SetDeviceQueueSize(Ptr<NetDevice> device, uint32_t packets) {
+    QueueSize size(QueueSizeUnit::PACKETS, packets);
+    if (Ptr<CsmaNetDevice> csma = DynamicCast<CsmaNetDevice>(device)) {
+        csma->GetQueue()->SetMaxSize(size);
+    } else if (Ptr<PointToPointNetDevice> p2p = DynamicCast<PointToPointNetDevice>(device)) {
+        p2p->GetQueue()->SetMaxSize(size);
+    }
+}
+
+} // namespace
+
+AqmQueueDiscs::AqmQueueDiscs(const SimulationConfig& config)
+    : m_config(config),
+      m_droppedBase(0) {}
+
+void AqmQueueDiscs::Install(Ptr<NetDevice> device, uint32_t nodeId) {
+    const std::string& mode = m_config.groupQueueDisc;
+    TrafficControlHelper trafficControl;
+
+    if (mode == "default") {
+        Ptr<TrafficControlLayer> layer = device->GetNode()->GetObject<TrafficControlLayer>();
+        Ptr<QueueDisc> root = layer ? layer->GetRootQueueDiscOnDevice(device) : nullptr;
+        if (root) m_queueDiscs.push_back(root);
+        return;
+    }
+    trafficControl.Uninstall(device);
+    if (mode == "none") return;
+
+    const uint32_t buffer = m_config.NodeBufferSize(nodeId);
+    QueueSizeValue maxSize(QueueSize(QueueSizeUnit::PACKETS, buffer));
+    if (mode == "codel") {
+        trafficControl.SetRootQueueDisc("ns3::CoDelQueueDisc", "MaxSize", maxSize);
+    } else if (mode == "fq_codel") {
+        trafficControl.SetRootQueueDisc("ns3::FqCoDelQueueDisc", "MaxSize", maxSize);
+    } else if (mode == "pie") {
+        trafficControl.SetRootQueueDisc("ns3::PieQueueDisc", "MaxSize", maxSize);
+    } else {
+        // Пороги RED - четверть и три четверти ёмкости (MaxTh = 3 MinTh)
+        double minTh = std::max(1.0, 0.25 * buffer);
+        double maxTh = std::max(minTh + 1.0, 0.75 * buffer);
+        trafficControl.SetRootQueueDisc("ns3::RedQueueDisc", "MaxSize", maxSize,
+                                        "MinTh", DoubleValue(minTh), "MaxTh", DoubleValue(maxTh));
+    }
+    QueueDiscContainer installed = trafficControl.Install(device);
+    m_queueDiscs.push_back(installed.Get(0));
+    SetDeviceQueueSize(device, kAqmDeviceQueuePackets);
+}
+
+void AqmQueueDiscs::ScheduleReset(double startTime) {
+    Simulator::Schedule(Seconds(startTime), &AqmQueueDiscs::Reset, this);
+}
+
+void AqmQueueDiscs::Reset() {
+    m_droppedBase = 0;
+    m_droppedBase = DroppedPackets();
+}
+
+uint64_t AqmQueueDiscs::DroppedPackets() const {
+    uint64_t dropped = 0;
+    for (const Ptr<QueueDisc>& queueDisc : m_queueDiscs) {
+        dropped += queueDisc->GetStats().nTotalDroppedPackets;
+    }
+    return dropped - m_droppedBase;
+}
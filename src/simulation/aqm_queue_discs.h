@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../env/environment_config.h"
+
+#include "ns3/network-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Корневые дисциплины очереди устройств GroupSimulator (GROUP_QUEUE_DISC):
+ * - none - без дисциплины, только DropTail устройства (NODE_X_BUFFER):
+ *   FqCoDel, который ns-3 ставит при назначении адресов, снимается;
+ * - default - дисциплина ns-3 по умолчанию (FqCoDel до 10240 пакетов)
+ *   остаётся, потери определяет она, а не NODE_X_BUFFER;
+ * - codel, fq_codel, pie, red - AQM ёмкостью NODE_X_BUFFER пакетов, очередь
+ *   устройства сокращается до одного пакета, чтобы очередь копилась в AQM.
+ * ECN не включается: UDP-источники на метки не реагируют. Счётчик потерь
+ * дисциплин считается после разогрева.
+ */
+class AqmQueueDiscs {
+public:
+    explicit AqmQueueDiscs(const SimulationConfig& config);
+
+    // Вызывать после назначения адресов (Ipv4AddressHelper ставит дисциплину по умолчанию)
+    void Install(ns3::Ptr<ns3::NetDevice> device, uint32_t nodeId);
+
+    // Запоминает счётчики в момент startTime: учитываются только события после него
+    void ScheduleReset(double startTime);
+
+    uint64_t DroppedPackets() const;
+
+private:
+    void Reset();
+
+    const SimulationConfig& m_config;
+    std::vector<ns3::Ptr<ns3::QueueDisc>> m_queueDiscs;
+    uint64_t m_droppedBase;
+};
@@ -0,0 +1,70 @@
+#include "backbone_topology.h"
+
+#include <algorithm>
+
+std::vector<BackboneLink> BackboneTopology::Links(const std::string& topology, uint32_t numGroups,
+                                                  uint32_t treeFanout) {
+    std::vector<BackboneLink> links;
+    if (numGroups < 2) return links;
+
+    if (topology == "star") {
+        for (uint32_t g = 1; g < numGroups; ++g) links.push_back({0, g});
+    } else if (topology == "mesh") {
+        for (uint32_t a = 0; a < numGroups; ++a) {
+            for (uint32_t b = a + 1; b < numGroups; ++b) links.push_back({a, b});
+        }
+    } else if (topology == "tree") {
+        const uint32_t fanout = std::max<uint32_t>(treeFanout, 1);
+        for (uint32_t g = 1; g < numGroups; ++g) links.push_back({(g - 1) / fanout, g});
+    } else {
+        // Кольцо (при двух группах - одна связь)
+        const uint32_t numLinks = (numGroups > 2) ? numGroups : 1;
+        for (uint32_t i = 0; i < numLinks; ++i) links.push_back({i, (i + 1) % numGroups});
+    }
+    return links;
+}
+
+std::vector<uint32_t> BackboneTopology::Path(const std::vector<BackboneLink>& links, uint32_t numGroups,
+                                              uint32_t from, uint32_t to) {
+    std::vector<uint32_t> path;
+    if (from == to || from >= numGroups || to >= numGroups) return path;
+
+    // Поиск в ширину от from: направление, по которому достигнута каждая группа
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> adjacent(numGroups);
+    for (uint32_t l = 0; l < links.size(); ++l) {
+        adjacent[links[l].a].emplace_back(2 * l, links[l].b);
+        adjacent[links[l].b].emplace_back(2 * l + 1, links[l].a);
+    }
+    std::vector<int> parentDirection(numGroups, -1);
+    std::vector<bool> visited(numGroups, false);
+    std::vector<uint32_t> frontier{from};
+    visited[from] = true;
+    for (size_t head = 0; head < frontier.size() && !visited[to]; ++head) {
+        for (const auto& edge : adjacent[frontier[head]]) {
+            if (visited[edge.second]) continue;
+            visited[edge.second] = true;
+            parentDirection[edge.second] = static_cast<int>(edge.first);
+            frontier.push_back(edge.second);
+        }
+    }
+    if (!visited[to]) return path;
+
+    for (uint32_t group = to; group != from;) {
+        const uint32_t direction = static_cast<uint32_t>(parentDirection[group]);
+        path.push_back(direction);
+        const BackboneLink& link = links[direction / 2];
+        group = (direction % 2 == 0) ? link.a : link.b;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+BackboneParameters BackboneTopology::Resolve(const BackboneParameters& parameters, uint32_t numGroups) {
+    BackboneParameters resolved = parameters;
+    if (resolved.links.empty()) {
+        resolved.links = Links("ring", numGroups, 2);
+        resolved.rateFactors.clear();
+    }
+    resolved.rateFactors.resize(2 * resolved.links.size(), 2.0);
+    return resolved;
+}
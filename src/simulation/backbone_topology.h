@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Связь магистрали между главными узлами групп a и b (устройство 0 - на a)
+struct BackboneLink {
+    uint32_t a;
+    uint32_t b;
+};
+
+/**
+ * Магистраль для аналитических моделей в том виде, в каком её строит
+ * GroupSimulator: связи, скорость направлений относительно скорости CSMA
+ * передающего главного узла и задержка.
+ */
+struct BackboneParameters {
+    std::vector<BackboneLink> links;
+    std::vector<double> rateFactors;   // [2l] - связь l от a к b, [2l + 1] - от b к a
+    double delayMs = -1.0;             // < 0 - половина задержки CSMA
+};
+
+/**
+ * Топологии магистрали GroupSimulator (BACKBONE_TOPOLOGY):
+ * - ring - кольцо 0-1-...-(G-1)-0 (связь i: i и (i + 1) % G; при G = 2 - одна связь);
+ * - star - звезда с центром в группе 0;
+ * - mesh - полносвязная, G (G - 1) / 2 связей;
+ * - tree - дерево с корнем 0, родитель группы g - (g - 1) / fanout.
+ */
+class BackboneTopology {
+public:
+    static std::vector<BackboneLink> Links(const std::string& topology, uint32_t numGroups, uint32_t treeFanout);
+
+    // Направления связей на кратчайшем пути (поиск в ширину) от группы from к группе to:
+    // 2l - связь l от a к b, 2l + 1 - от b к a; пусто, если from == to или to недостижима
+    static std::vector<uint32_t> Path(const std::vector<BackboneLink>& links, uint32_t numGroups,
+                                      uint32_t from, uint32_t to);
+
+    // Параметры по умолчанию (пустые links) - кольцо с множителем скорости 2
+    static BackboneParameters Resolve(const BackboneParameters& parameters, uint32_t numGroups);
+};
+
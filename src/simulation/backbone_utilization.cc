@@ -0,0 +1,72 @@
+#include "backbone_utilization.h"
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+namespace {
+
+void OnBackboneTx(BackboneUtilization* utilization, size_t direction, Ptr<const Packet> packet) {
+    utilization->Record(direction, packet->GetSize());
+}
+
+} // namespace
+
+BackboneUtilization::BackboneUtilization(double startTime)
+    : m_startTime(startTime) {}
+
+void BackboneUtilization::Add(uint32_t link, uint32_t fromGroup, uint32_t toGroup,
+                              Ptr<PointToPointNetDevice> device, double rateMbps) {
+    const size_t direction = m_directions.size();
+    m_directions.push_back({link, fromGroup, toGroup, rateMbps, 0});
+    device->TraceConnectWithoutContext("PhyTxEnd", MakeBoundCallback(&OnBackboneTx, this, direction));
+}
+
+void BackboneUtilization::Record(size_t direction, uint32_t bytes) {
+    if (Simulator::Now().GetSeconds() < m_startTime) return;
+    m_directions[direction].bytes += bytes;
+}
+
+double BackboneUtilization::Utilization(size_t direction, double measuredTime) const {
+    const Direction& d = m_directions[direction];
+    if (measuredTime <= 0.0 || d.rateMbps <= 0.0) return 0.0;
+    return d.bytes * 8.0 / (d.rateMbps * 1e6 * measuredTime);
+}
+
+double BackboneUtilization::MaxUtilization(double measuredTime) const {
+    double maxUtilization = 0.0;
+    for (size_t i = 0; i < m_directions.size(); ++i) {
+        maxUtilization = std::max(maxUtilization, Utilization(i, measuredTime));
+    }
+    return maxUtilization;
+}
+
+double BackboneUtilization::MeanUtilization(double measuredTime) const {
+    if (m_directions.empty()) return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < m_directions.size(); ++i) sum += Utilization(i, measuredTime);
+    return sum / m_directions.size();
+}
+
+void BackboneUtilization::Write(const std::string& filename, double measuredTime) const {
+    std::ofstream file(filename);
+    file << "Link,FromGroup,ToGroup,Rate_Mbps,Tx_Mbps,Utilization\n";
+    for (size_t i = 0; i < m_directions.size(); ++i) {
+        const Direction& d = m_directions[i];
+        double txMbps = (measuredTime > 0.0) ? d.bytes * 8.0 / (measuredTime * 1e6) : 0.0;
+        file << d.link << "," << d.fromGroup << "," << d.toGroup << "," << d.rateMbps << ","
+             << txMbps << "," << Utilization(i, measuredTime) << "\n";
+    }
+}
+
+std::string BackboneUtilization::FileName(double lambda, int64_t sweepPointId) {
+    std::ostringstream name;
+    name << "scratch/public/backbone_links_";
+    if (sweepPointId >= 0) name << "point" << sweepPointId << "_";
+    name << lambda << ".csv";
+    return name.str();
+}
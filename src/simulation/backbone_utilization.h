@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Загрузка связей магистрали по направлениям: байты, переданные устройством
+ * PointToPoint после startTime (трасса PhyTxEnd, с заголовком PPP), к
+ * ёмкости направления за время измерений.
+ */
+class BackboneUtilization {
+public:
+    explicit BackboneUtilization(double startTime);
+
+    void Add(uint32_t link, uint32_t fromGroup, uint32_t toGroup,
+             ns3::Ptr<ns3::PointToPointNetDevice> device, double rateMbps);
+
+    void Record(size_t direction, uint32_t bytes);
+
+    double Utilization(size_t direction, double measuredTime) const;
+    double MaxUtilization(double measuredTime) const;
+    double MeanUtilization(double measuredTime) const;
+
+    // Link,FromGroup,ToGroup,Rate_Mbps,Tx_Mbps,Utilization по направлениям
+    void Write(const std::string& filename, double measuredTime) const;
+
+    // scratch/public/backbone_links_<lambda>.csv; в точке плана - backbone_links_point<id>_<lambda>.csv,
+    // чтобы рабочие процессы с одинаковой lambda не писали в один файл
+    static std::string FileName(double lambda, int64_t sweepPointId);
+
+private:
+    struct Direction {
+        uint32_t link;
+        uint32_t fromGroup;
+        uint32_t toGroup;
+        double rateMbps;
+        uint64_t bytes;
+    };
+
+    double m_startTime;
+    std::vector<Direction> m_directions;
+};
@@ -1,5 +1,11 @@
 #include "group_simulator.h"
 #include "../metrics/metrics_calculator.h"
+#include "../routing/hierarchical_routing.h"
+#include "aqm_queue_discs.h"
+#include "backbone_topology.h"
+#include "backbone_utilization.h"
+#include "../trace/packet_tracer.h"
+#include "../traffic/traffic_installer.h"
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
@@ -7,7 +13,10 @@
 #include "ns3/csma-module.h"
 #include "ns3/point-to-point-module.h"
 #include "ns3/flow-monitor-module.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 using namespace ns3;
@@ -15,9 +24,13 @@ using namespace ns3;
 SimulationMetrics GroupSimulator::Run(const SimulationConfig& config, double lambda) {
     std::cout << "=== Running Group Simulation (Lambda=" << lambda << ") ===" << std::endl;
     
-    // Создаем 3 группы по 3 узла (всего 9 узлов)
-    const uint32_t numGroups = 3;
-    const uint32_t nodesPerGroup = 3;
+    // numNodes узлов делятся на numGroups групп почти поровну (по умолчанию 3 x 3):
+    // первые numNodes % numGroups групп получают на один узел больше
+    const uint32_t numGroups = std::max<uint32_t>(1, std::min(config.numGroups, config.numNodes));
+    std::vector<uint32_t> groupSizes(numGroups, config.numNodes / numGroups);
+    for (uint32_t i = 0; i < config.numNodes % numGroups; ++i) {
+        ++groupSizes[i];
+    }
     
     std::vector<NodeContainer> groups;
     NodeContainer allNodes;
@@ -26,7 +39,7 @@ SimulationMetrics GroupSimulator::Run(const SimulationConfig& config, double lam
     // Создаем группы
     for (uint32_t i = 0; i < numGroups; ++i) {
         NodeContainer group;
-        group.Create(nodesPerGroup);
+        group.Create(groupSizes[i]);
         groups.push_back(group);
         allNodes.Add(group);
         
@@ -52,48 +65,123 @@ SimulationMetrics GroupSimulator::Run(const SimulationConfig& config, double lam
     
     Ipv4AddressHelper ipv4;
     
+    // Номер первого узла каждой группы в нумерации NODE_X
+    std::vector<uint32_t> groupOffsets(numGroups, 0);
+    for (uint32_t i = 1; i < numGroups; ++i) {
+        groupOffsets[i] = groupOffsets[i - 1] + groupSizes[i - 1];
+    }
+    
+    auto applyNodeBuffer = [&config](Ptr<Queue<Packet>> queue, uint32_t nodeId) {
+        queue->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, config.NodeBufferSize(nodeId)));
+    };
+    
     // Создаем локальные сети для каждой группы
     for (uint32_t i = 0; i < numGroups; ++i) {
         NetDeviceContainer groupDevice = csma.Install(groups[i]);
         groupDevices.push_back(groupDevice);
         
+        // Поузловые ёмкости очередей (NODE_X_BUFFER) и скорости передачи (NODE_X_SERVICE_RATE)
+        for (uint32_t k = 0; k < groupDevice.GetN(); ++k) {
+            Ptr<CsmaNetDevice> device = DynamicCast<CsmaNetDevice>(groupDevice.Get(k));
+            applyNodeBuffer(device->GetQueue(), groupOffsets[i] + k);
+            device->SetDataRate(DataRate(config.NodeDataRateMbps(groupOffsets[i] + k) * 1000000));
+        }
+        
         std::string base = "10.1." + std::to_string(i+1) + ".0";
         ipv4.SetBase(base.c_str(), "255.255.255.0");
         groupInterfaces.push_back(ipv4.Assign(groupDevice));
     }
     
-    // Создаем соединения между главными узлами (Point-to-Point)
+    // Создаем соединения между главными узлами (Point-to-Point) по BACKBONE_TOPOLOGY
+    const std::vector<BackboneLink> backboneLinks =
+        BackboneTopology::Links(config.backboneTopology, numGroups, config.backboneTreeFanout);
+    const uint32_t numBackboneLinks = static_cast<uint32_t>(backboneLinks.size());
+    // Задержка магистрали по умолчанию - половина задержки группы
+    const double backboneDelayMs = (config.backboneDelayMs >= 0.0) ? config.backboneDelayMs : config.linkDelayMs / 2;
+    
     NetDeviceContainer p2pDevices;
     PointToPointHelper p2p;
-    p2p.SetDeviceAttribute("DataRate", DataRateValue(DataRate(config.dataRateMbps * 2000000)));  // Удвоенная скорость для магистрали
-    p2p.SetChannelAttribute("Delay", TimeValue(MilliSeconds(config.linkDelayMs / 2)));  // Меньшая задержка для магистрали
+    p2p.SetDeviceAttribute("DataRate", DataRateValue(DataRate(config.dataRateMbps * config.backboneRateFactor * 1000000)));
+    p2p.SetChannelAttribute("Delay", TimeValue(MilliSeconds(backboneDelayMs)));
     
-    // Соединяем главные узлы в кольцо
-    for (uint32_t i = 0; i < numGroups; ++i) {
-        uint32_t nextGroup = (i + 1) % numGroups;
-        NetDeviceContainer link = p2p.Install(masterNodes.Get(i), masterNodes.Get(nextGroup));
+    // Скорость направления: BACKBONE_LINK_X_RATE_MBPS или скорость узла, умноженная на BACKBONE_RATE_FACTOR
+    auto backboneRateMbps = [&config, &groupOffsets](uint32_t link, uint32_t group) {
+        if (link < config.backboneLinkRates.size() && config.backboneLinkRates[link] > 0.0) {
+            return config.backboneLinkRates[link];
+        }
+        return config.NodeDataRateMbps(groupOffsets[group]) * config.backboneRateFactor;
+    };
+    
+    BackboneUtilization backboneUtilization(config.warmupTime);
+    for (uint32_t i = 0; i < numBackboneLinks; ++i) {
+        const uint32_t from = backboneLinks[i].a;
+        const uint32_t to = backboneLinks[i].b;
+        NetDeviceContainer link = p2p.Install(masterNodes.Get(from), masterNodes.Get(to));
+        Ptr<PointToPointNetDevice> local = DynamicCast<PointToPointNetDevice>(link.Get(0));
+        Ptr<PointToPointNetDevice> remote = DynamicCast<PointToPointNetDevice>(link.Get(1));
+        applyNodeBuffer(local->GetQueue(), groupOffsets[from]);
+        applyNodeBuffer(remote->GetQueue(), groupOffsets[to]);
+        local->SetDataRate(DataRate(backboneRateMbps(i, from) * 1000000));
+        remote->SetDataRate(DataRate(backboneRateMbps(i, to) * 1000000));
+        backboneUtilization.Add(i, from, to, local, backboneRateMbps(i, from));
+        backboneUtilization.Add(i, to, from, remote, backboneRateMbps(i, to));
         p2pDevices.Add(link);
     }
     
-    // Назначаем IP-адреса для магистральной сети
-    ipv4.SetBase("10.0.0.0", "255.255.255.0");
-    Ipv4InterfaceContainer p2pInterfaces = ipv4.Assign(p2pDevices);
+    // Назначаем IP-адреса для магистральной сети: подсеть /30 на связь
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    Ipv4InterfaceContainer p2pInterfaces;
+    for (uint32_t i = 0; i < numBackboneLinks; ++i) {
+        NetDeviceContainer link;
+        link.Add(p2pDevices.Get(2 * i));
+        link.Add(p2pDevices.Get(2 * i + 1));
+        p2pInterfaces.Add(ipv4.Assign(link));
+        ipv4.NewNetwork();
+    }
+    
+    // Дисциплины очереди устройств (GROUP_QUEUE_DISC) - после назначения адресов
+    AqmQueueDiscs queueDiscs(config);
+    for (uint32_t i = 0; i < numGroups; ++i) {
+        for (uint32_t k = 0; k < groupDevices[i].GetN(); ++k) {
+            queueDiscs.Install(groupDevices[i].Get(k), groupOffsets[i] + k);
+        }
+    }
+    for (uint32_t i = 0; i < numBackboneLinks; ++i) {
+        queueDiscs.Install(p2pDevices.Get(2 * i), groupOffsets[backboneLinks[i].a]);
+        queueDiscs.Install(p2pDevices.Get(2 * i + 1), groupOffsets[backboneLinks[i].b]);
+    }
+    queueDiscs.ScheduleReset(config.warmupTime);
     
     // Настраиваем маршрутизацию
-    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    auto routingStart = std::chrono::steady_clock::now();
+    if (config.groupRouting == "static") {
+        uint32_t routes = (config.backboneTopology == "ring")
+            ? HierarchicalRouting::Install(groups, groupInterfaces, p2pInterfaces)
+            : HierarchicalRouting::InstallShortestPaths(groups, groupInterfaces, backboneLinks, p2pInterfaces);
+        std::cout << "Static hierarchical routing: " << routes << " routes";
+    } else {
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+        std::cout << "Global routing";
+    }
+    std::cout << ", setup " << std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - routingStart).count() << " ms" << std::endl;
     
     // Создаем приложения для обмена данными
     Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    TrafficInstaller traffic(config, lambda);
     uint32_t globalNodeId = 0;
     
     for (uint32_t groupIdx = 0; groupIdx < numGroups; ++groupIdx) {
         NodeContainer& group = groups[groupIdx];
+        const uint32_t nodesPerGroup = groupSizes[groupIdx];
         
         for (uint32_t nodeIdx = 0; nodeIdx < nodesPerGroup; ++nodeIdx) {
             if (globalNodeId >= config.numNodes) break;
             
             double nodeLambda = lambda * config.nodeLoads[globalNodeId];
-            if (nodeLambda > 0) {
+            // Главный узел без других групп или обычный узел без соседей по группе не отправляет
+            bool hasPeer = (nodeIdx == 0) ? numGroups > 1 : nodesPerGroup > 2;
+            if (nodeLambda > 0 && hasPeer) {
                 uint32_t targetGroupIdx = groupIdx;
                 
                 // Для главных узлов (индекс 0) - общение с другими группами
@@ -115,24 +203,9 @@ SimulationMetrics GroupSimulator::Run(const SimulationConfig& config, double lam
                 serverApp.Start(Seconds(0.0));
                 serverApp.Stop(Seconds(config.simulationDuration));
                 
-                UdpClientHelper client;
-                
-                if (targetGroupIdx == groupIdx) {
-                    // Внутригрупповое общение
-                    client = UdpClientHelper(groupInterfaces[groupIdx].GetAddress(receiverIdx), port);
-                } else {
-                    // Межгрупповое общение (через главные узлы)
-                    client = UdpClientHelper(groupInterfaces[targetGroupIdx].GetAddress(receiverIdx), port);
-                }
-                
-                // Убираем ограничение MaxPackets, чтобы нагрузка росла с Lambda
-                // Количество пакетов = lambda * simulationDuration
-                uint32_t totalPackets = static_cast<uint32_t>(nodeLambda * config.simulationDuration * 1.5);
-                client.SetAttribute("MaxPackets", UintegerValue(totalPackets));
-                client.SetAttribute("Interval", TimeValue(Seconds(1.0 / nodeLambda)));
-                client.SetAttribute("PacketSize", UintegerValue(config.packetSize));
-                
-                ApplicationContainer clientApp = client.Install(group.Get(nodeIdx));
+                // Межгрупповое общение идёт через главные узлы по маршрутам магистрали
+                ApplicationContainer clientApp = traffic.Install(group.Get(nodeIdx), globalNodeId,
+                    groupInterfaces[targetGroupIdx].GetAddress(receiverIdx), port);
                 double startTime = rv->GetValue(config.startTimeMin, config.startTimeMax);
                 clientApp.Start(Seconds(startTime));
                 clientApp.Stop(Seconds(config.simulationDuration - 0.1));
@@ -142,15 +215,38 @@ SimulationMetrics GroupSimulator::Run(const SimulationConfig& config, double lam
     }
     
     FlowMonitorHelper flowMonitor;
+    flowMonitor.SetMonitorAttribute("StartTime", TimeValue(Seconds(config.warmupTime)));
     Ptr<FlowMonitor> monitor = flowMonitor.InstallAll();
     
+    std::unique_ptr<PacketTracer> tracer;
+    if (config.packetTrace) {
+        tracer = std::make_unique<PacketTracer>(PacketTracer::FileName("Group", lambda), config.packetTraceSampling);
+        tracer->Install(allNodes);
+    }
+    
     Simulator::Stop(Seconds(config.simulationDuration));
     Simulator::Run();
     
-    SimulationMetrics metrics = MetricsCalculator::Calculate(monitor, config.simulationDuration, config.nodeLoads);
+    // Интервал измерений - после разогрева
+    double measuredTime = config.simulationDuration - config.warmupTime;
+    SimulationMetrics metrics = MetricsCalculator::Calculate(monitor, measuredTime, config.nodeLoads);
+    metrics.aqmDroppedPackets = static_cast<uint32_t>(queueDiscs.DroppedPackets());
+    metrics.backboneMaxUtilization = backboneUtilization.MaxUtilization(measuredTime);
+    metrics.backboneMeanUtilization = backboneUtilization.MeanUtilization(measuredTime);
+    if (numBackboneLinks > 0) {
+        backboneUtilization.Write(BackboneUtilization::FileName(lambda, config.sweepPointId), measuredTime);
+        std::cout << "Backbone (" << config.backboneTopology << ", " << numBackboneLinks << " links): utilization max "
+                  << metrics.backboneMaxUtilization << ", mean " << metrics.backboneMeanUtilization << std::endl;
+    }
     
     Simulator::Destroy();
     
+    // Трасса закрывается после Destroy: события очередей могут приходить до конца симуляции
+    if (tracer) {
+        tracer->Close();
+        std::cout << "Packet trace: " << tracer->RecordsWritten() << " records" << std::endl;
+    }
+    
    
     return metrics;
 }
@@ -0,0 +1,149 @@
+#include "experiment_design.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+const unsigned kSobolBits = 32;
+
+/**
+ * Параметры примитивных многочленов и начальные направляющие числа
+ * для измерений 2..8 (Joe, Kuo, new-joe-kuo-6.21201).
+ * Первое измерение - последовательность ван дер Корпута.
+ */
+struct SobolPolynomial {
+    unsigned degree;
+    unsigned coefficients;
+    unsigned initial[5];
+};
+
+const SobolPolynomial kSobolPolynomials[ExperimentDesign::kMaxSobolDims - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+};
+
+// Направляющие числа V[1..32] одного измерения, сдвинутые к старшему биту
+std::vector<uint32_t> SobolDirections(size_t dim) {
+    std::vector<uint32_t> v(kSobolBits + 1, 0);
+    if (dim == 0) {
+        for (unsigned i = 1; i <= kSobolBits; ++i) v[i] = 1u << (kSobolBits - i);
+        return v;
+    }
+
+    const SobolPolynomial& p = kSobolPolynomials[dim - 1];
+    const unsigned s = p.degree;
+    for (unsigned i = 1; i <= std::min(s, kSobolBits); ++i) {
+        v[i] = p.initial[i - 1] << (kSobolBits - i);
+    }
+    for (unsigned i = s + 1; i <= kSobolBits; ++i) {
+        v[i] = v[i - s] ^ (v[i - s] >> s);
+        for (unsigned k = 1; k < s; ++k) {
+            v[i] ^= ((p.coefficients >> (s - 1 - k)) & 1u) * v[i - k];
+        }
+    }
+    return v;
+}
+
+} // namespace
+
+DesignType ExperimentDesign::ParseType(const std::string& name) {
+    if (name == "factorial") return DesignType::Factorial;
+    if (name == "lhs") return DesignType::LatinHypercube;
+    if (name == "sobol") return DesignType::Sobol;
+    throw std::runtime_error("Unknown sweep design: " + name + " (expected factorial, lhs or sobol)");
+}
+
+std::string ExperimentDesign::TypeName(DesignType type) {
+    switch (type) {
+        case DesignType::Factorial: return "factorial";
+        case DesignType::LatinHypercube: return "lhs";
+        case DesignType::Sobol: return "sobol";
+    }
+    return "unknown";
+}
+
+std::vector<std::vector<double>> ExperimentDesign::Generate(DesignType type,
+                                                            size_t dims,
+                                                            size_t samples,
+                                                            uint32_t levels,
+                                                            uint32_t seed) {
+    switch (type) {
+        case DesignType::Factorial: return FullFactorial(dims, levels);
+        case DesignType::LatinHypercube: return LatinHypercube(dims, samples, seed);
+        case DesignType::Sobol: return Sobol(dims, samples);
+    }
+    return {};
+}
+
+std::vector<std::vector<double>> ExperimentDesign::FullFactorial(size_t dims, uint32_t levels) {
+    if (levels == 0) {
+        throw std::runtime_error("Factorial design requires at least one level");
+    }
+
+    size_t total = 1;
+    for (size_t d = 0; d < dims; ++d) {
+        if (total > 1000000 / levels) {
+            throw std::runtime_error("Factorial design is too large: reduce SWEEP_LEVELS or the number of factors");
+        }
+        total *= levels;
+    }
+
+    std::vector<std::vector<double>> points(total, std::vector<double>(dims));
+    for (size_t index = 0; index < total; ++index) {
+        size_t rest = index;
+        for (size_t d = 0; d < dims; ++d) {
+            uint32_t level = static_cast<uint32_t>(rest % levels);
+            rest /= levels;
+            points[index][d] = (levels == 1) ? 0.5 : static_cast<double>(level) / (levels - 1);
+        }
+    }
+    return points;
+}
+
+std::vector<std::vector<double>> ExperimentDesign::LatinHypercube(size_t dims, size_t samples, uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<std::vector<double>> points(samples, std::vector<double>(dims));
+    std::vector<size_t> strata(samples);
+    for (size_t d = 0; d < dims; ++d) {
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), generator);
+        for (size_t i = 0; i < samples; ++i) {
+            points[i][d] = (strata[i] + uniform(generator)) / static_cast<double>(samples);
+        }
+    }
+    return points;
+}
+
+std::vector<std::vector<double>> ExperimentDesign::Sobol(size_t dims, size_t samples) {
+    if (dims > kMaxSobolDims) {
+        throw std::runtime_error("Sobol design supports at most " + std::to_string(kMaxSobolDims) + " factors");
+    }
+
+    std::vector<std::vector<uint32_t>> directions(dims);
+    for (size_t d = 0; d < dims; ++d) directions[d] = SobolDirections(d);
+
+    // Код Грея: точка i+1 получается из точки i одним XOR с V[c],
+    // где c - номер младшего нулевого бита i (считая с 1)
+    std::vector<std::vector<double>> points(samples, std::vector<double>(dims));
+    std::vector<uint32_t> x(dims, 0);
+    const double scale = 1.0 / 4294967296.0;
+    for (size_t i = 0; i < samples; ++i) {
+        for (size_t d = 0; d < dims; ++d) points[i][d] = x[d] * scale;
+
+        unsigned c = 1;
+        for (size_t value = i; value & 1u; value >>= 1) ++c;
+        if (c > kSobolBits) break;
+        for (size_t d = 0; d < dims; ++d) x[d] ^= directions[d][c];
+    }
+    return points;
+}
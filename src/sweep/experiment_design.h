@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Планы экспериментов в единичном кубе [0, 1]^dims.
+ * Каждая точка - вектор из dims координат; отображение на диапазоны
+ * параметров выполняет SweepRunner.
+ */
+enum class DesignType {
+    Factorial,      // Полный факторный план: levels^dims узлов сетки
+    LatinHypercube, // Латинский гиперкуб: по одной точке в каждом из samples слоёв по каждой оси
+    Sobol           // Последовательность Соболя (квази-Монте-Карло)
+};
+
+class ExperimentDesign {
+public:
+    // Число измерений, для которых заданы направляющие числа Соболя
+    static constexpr size_t kMaxSobolDims = 8;
+
+    // "factorial" | "lhs" | "sobol"; иначе std::runtime_error
+    static DesignType ParseType(const std::string& name);
+    static std::string TypeName(DesignType type);
+
+    static std::vector<std::vector<double>> Generate(DesignType type,
+                                                     size_t dims,
+                                                     size_t samples,
+                                                     uint32_t levels,
+                                                     uint32_t seed);
+
+    // levels = 1 - центр интервала
+    static std::vector<std::vector<double>> FullFactorial(size_t dims, uint32_t levels);
+
+    // Точка внутри слоя выбирается случайно, слои по осям переставлены независимо
+    static std::vector<std::vector<double>> LatinHypercube(size_t dims, size_t samples, uint32_t seed);
+
+    // Первые samples точек (начиная с нулевой), направляющие числа Joe-Kuo
+    static std::vector<std::vector<double>> Sobol(size_t dims, size_t samples);
+};
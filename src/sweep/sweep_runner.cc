@@ -0,0 +1,461 @@
+#include "sweep_runner.h"
+#include "experiment_design.h"
+#include "../simulation/adhoc_simulator.h"
+#include "../simulation/group_simulator.h"
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdint>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <poll.h>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace ns3;
+
+namespace {
+
+// Скалярные поля SimulationMetrics для передачи между процессами
+struct WireMetrics {
+    double throughput;
+    double delay;
+    double delayP95;
+    double packetLoss;
+    double load;
+    double jitter;
+    double avgHopCount;
+    double txBytes;
+    double rxBytes;
+    double simulationTime;
+    double routingOverheadBytes;
+    double backboneMaxUtilization;
+    double backboneMeanUtilization;
+    uint32_t txPackets;
+    uint32_t rxPackets;
+    uint32_t lostPackets;
+    uint32_t droppedPackets;
+    uint32_t routingOverheadPackets;
+    uint32_t aqmDroppedPackets;
+};
+
+struct WireResult {
+    uint64_t index;
+    uint32_t completed;
+    WireMetrics adHoc;
+    WireMetrics group;
+};
+
+struct Worker {
+    pid_t pid;
+    int taskFd;
+    int resultFd;
+    bool busy;
+    size_t current;
+};
+
+WireMetrics Pack(const SimulationMetrics& m) {
+    WireMetrics w;
+    w.throughput = m.throughput;
+    w.delay = m.delay;
+    w.delayP95 = m.delayP95;
+    w.packetLoss = m.packetLoss;
+    w.load = m.load;
+    w.jitter = m.jitter;
+    w.avgHopCount = m.avgHopCount;
+    w.txBytes = m.txBytes;
+    w.rxBytes = m.rxBytes;
+    w.simulationTime = m.simulationTime;
+    w.txPackets = m.txPackets;
+    w.rxPackets = m.rxPackets;
+    w.lostPackets = m.lostPackets;
+    w.droppedPackets = m.droppedPackets;
+    w.routingOverheadBytes = m.routingOverheadBytes;
+    w.routingOverheadPackets = m.routingOverheadPackets;
+    w.aqmDroppedPackets = m.aqmDroppedPackets;
+    w.backboneMaxUtilization = m.backboneMaxUtilization;
+    w.backboneMeanUtilization = m.backboneMeanUtilization;
+    return w;
+}
+
+SimulationMetrics Unpack(const WireMetrics& w) {
+    SimulationMetrics m;
+    m.throughput = w.throughput;
+    m.delay = w.delay;
+    m.delayP95 = w.delayP95;
+    m.packetLoss = w.packetLoss;
+    m.load = w.load;
+    m.jitter = w.jitter;
+    m.avgHopCount = w.avgHopCount;
+    m.txBytes = w.txBytes;
+    m.rxBytes = w.rxBytes;
+    m.simulationTime = w.simulationTime;
+    m.txPackets = w.txPackets;
+    m.rxPackets = w.rxPackets;
+    m.lostPackets = w.lostPackets;
+    m.droppedPackets = w.droppedPackets;
+    m.routingOverheadBytes = w.routingOverheadBytes;
+    m.routingOverheadPackets = w.routingOverheadPackets;
+    m.aqmDroppedPackets = w.aqmDroppedPackets;
+    m.backboneMaxUtilization = w.backboneMaxUtilization;
+    m.backboneMeanUtilization = w.backboneMeanUtilization;
+    return m;
+}
+
+bool WriteAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// false - конец потока или ошибка до получения size байт
+bool ReadAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t received = read(fd, bytes, size);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool IsIntegerFactor(const std::string& name) {
+    return name == "BUFFER_SIZE" || name == "PACKET_SIZE" || name == "NUM_GROUPS";
+}
+
+SweepResult RunPoint(const SimulationConfig& base, const SweepPoint& point) {
+    SimulationConfig config = SweepRunner::Apply(base, point);
+    config.sweepPointId = static_cast<int64_t>(point.id);
+    RngSeedManager::SetRun(static_cast<uint64_t>(point.id) + 1);
+
+    SweepResult result;
+    result.point = point;
+    result.adHoc = AdHocSimulator::Run(config, point.lambda);
+    result.group = GroupSimulator::Run(config, point.lambda);
+    result.completed = true;
+    return result;
+}
+
+// Тело дочернего процесса: выполняет точки, номера которых приходят по taskFd
+[[noreturn]] void WorkerMain(int taskFd, int resultFd,
+                             const SimulationConfig& config,
+                             const std::vector<SweepPoint>& points) {
+    // Вывод симуляторов дочерних процессов перемешивался бы - подавляем stdout
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+    }
+
+    uint64_t index = 0;
+    while (ReadAll(taskFd, &index, sizeof(index))) {
+        WireResult wire{};
+        wire.index = index;
+        try {
+            SweepResult result = RunPoint(config, points[index]);
+            wire.completed = 1;
+            wire.adHoc = Pack(result.adHoc);
+            wire.group = Pack(result.group);
+        } catch (const std::exception& e) {
+            std::cerr << "Sweep point " << index << " failed: " << e.what() << std::endl;
+        }
+        if (!WriteAll(resultFd, &wire, sizeof(wire))) break;
+    }
+    _exit(0);
+}
+
+void PrintProgress(size_t done, size_t total, const SweepResult& result, const std::string& tag) {
+    std::cout << "Sweep point " << done << "/" << total << " [" << tag << "] "
+              << (result.completed
+                  ? "AdHoc " + std::to_string(result.adHoc.throughput) +
+                    " Mbps, Group " + std::to_string(result.group.throughput) + " Mbps"
+                  : std::string("FAILED"))
+              << std::endl;
+}
+
+} // namespace
+
+std::vector<SweepPoint> SweepRunner::BuildPoints(const SimulationConfig& config) {
+    const std::vector<SweepFactor>& factors = config.sweepFactors;
+    if (factors.empty()) {
+        throw std::runtime_error("SWEEP_DESIGN is set but no SWEEP_<PARAMETER>=min:max factors are given");
+    }
+
+    DesignType type = ExperimentDesign::ParseType(config.sweepDesign);
+    std::vector<std::vector<double>> unit = ExperimentDesign::Generate(
+        type, factors.size(), config.sweepSamples, config.sweepLevels, config.sweepSeed);
+
+    size_t lambdaFactor = factors.size();
+    for (size_t f = 0; f < factors.size(); ++f) {
+        if (factors[f].name == "LAMBDA") lambdaFactor = f;
+    }
+
+    std::vector<double> lambdas;
+    if (lambdaFactor == factors.size()) {
+        int numPoints = static_cast<int>((config.lambdaEnd - config.lambdaStart) / config.lambdaStep) + 1;
+        for (int i = 0; i < numPoints; ++i) lambdas.push_back(config.lambdaStart + i * config.lambdaStep);
+    }
+
+    std::vector<SweepPoint> points;
+    for (const std::vector<double>& u : unit) {
+        SweepPoint point;
+        point.values.resize(factors.size());
+        for (size_t f = 0; f < factors.size(); ++f) {
+            double value = factors[f].minValue + u[f] * (factors[f].maxValue - factors[f].minValue);
+            point.values[f] = IsIntegerFactor(factors[f].name) ? std::round(value) : value;
+        }
+
+        if (lambdaFactor < factors.size()) {
+            point.lambda = point.values[lambdaFactor];
+            point.id = points.size();
+            points.push_back(point);
+        } else {
+            for (double lambda : lambdas) {
+                point.lambda = lambda;
+                point.id = points.size();
+                points.push_back(point);
+            }
+        }
+    }
+    return points;
+}
+
+SimulationConfig SweepRunner::Apply(const SimulationConfig& base, const SweepPoint& point) {
+    SimulationConfig config = base;
+    for (size_t f = 0; f < base.sweepFactors.size() && f < point.values.size(); ++f) {
+        const std::string& name = base.sweepFactors[f].name;
+        double value = point.values[f];
+        if (name == "BUFFER_SIZE") {
+            // Значение плана заменяет и общий, и поузловые размеры буфера
+            config.bufferSize = static_cast<uint32_t>(std::max(1.0, value));
+            std::fill(config.nodeBuffers.begin(), config.nodeBuffers.end(), config.bufferSize);
+        } else if (name == "PACKET_SIZE") {
+            config.packetSize = static_cast<uint32_t>(std::max(12.0, value));
+        } else if (name == "DATA_RATE_MBPS") {
+            config.dataRateMbps = value;
+        } else if (name == "LINK_DELAY_MS") {
+            config.linkDelayMs = value;
+        } else if (name == "WIFI_MAX_RANGE") {
+            config.wifiMaxRange = value;
+        } else if (name == "NUM_GROUPS") {
+            config.numGroups = static_cast<uint32_t>(std::max(1.0, value));
+        } else if (name == "TRAFFIC_HURST") {
+            // Значение плана заменяет и общий, и поузловые показатели Хёрста
+            config.trafficHurst = std::min(std::max(value, 0.5), 0.99);
+            std::fill(config.nodeHursts.begin(), config.nodeHursts.end(), 0.0);
+        }
+    }
+    return config;
+}
+
+std::string SweepRunner::Tag(const SimulationConfig& base, const SweepPoint& point) {
+    std::ostringstream tag;
+    for (size_t f = 0; f < base.sweepFactors.size() && f < point.values.size(); ++f) {
+        if (base.sweepFactors[f].name == "LAMBDA") continue;
+        tag << base.sweepFactors[f].name << "=" << point.values[f] << ";";
+    }
+    tag << "LAMBDA=" << point.lambda;
+    return tag.str();
+}
+
+std::vector<SweepResult> SweepRunner::Run(const SimulationConfig& config,
+                                          const std::vector<SweepPoint>& points,
+                                          size_t workers) {
+    std::vector<SweepResult> results(points.size());
+    for (size_t i = 0; i < points.size(); ++i) results[i].point = points[i];
+    if (points.empty()) return results;
+
+    if (workers == 0) {
+        workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    workers = std::min(workers, points.size());
+
+    // Буфер stdout сбрасывается до fork, иначе он продублируется в дочерних процессах
+    std::cout.flush();
+    std::fflush(nullptr);
+
+    std::vector<Worker> pool;
+    auto spawn = [&]() -> bool {
+        int taskPipe[2];
+        int resultPipe[2];
+        if (pipe(taskPipe) != 0) return false;
+        if (pipe(resultPipe) != 0) {
+            close(taskPipe[0]);
+            close(taskPipe[1]);
+            return false;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(taskPipe[0]);
+            close(taskPipe[1]);
+            close(resultPipe[0]);
+            close(resultPipe[1]);
+            return false;
+        }
+        if (pid == 0) {
+            // Концы каналов других процессов закрываются, чтобы они получили EOF
+            for (const Worker& other : pool) {
+                if (other.taskFd >= 0) close(other.taskFd);
+                if (other.resultFd >= 0) close(other.resultFd);
+            }
+            close(taskPipe[1]);
+            close(resultPipe[0]);
+            WorkerMain(taskPipe[0], resultPipe[1], config, points);
+        }
+
+        close(taskPipe[0]);
+        close(resultPipe[1]);
+        pool.push_back(Worker{pid, taskPipe[1], resultPipe[0], false, 0});
+        return true;
+    };
+
+    for (size_t w = 0; w < workers; ++w) {
+        if (!spawn()) break;
+    }
+
+    size_t done = 0;
+    if (pool.empty()) {
+        std::cout << "fork() unavailable, running sweep sequentially" << std::endl;
+        for (size_t i = 0; i < points.size(); ++i) {
+            // Как в рабочем процессе: ошибка точки не прерывает план
+            try {
+                results[i] = RunPoint(config, points[i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Sweep point " << i << " failed: " << e.what() << std::endl;
+            }
+            PrintProgress(++done, points.size(), results[i], Tag(config, points[i]));
+        }
+        return results;
+    }
+
+    std::cout << "Running " << points.size() << " sweep points in " << pool.size()
+              << " worker processes..." << std::endl;
+
+    // Запись в канал завершившегося процесса не должна убивать родителя
+    auto previousHandler = std::signal(SIGPIPE, SIG_IGN);
+
+    size_t next = 0;
+    auto dispatch = [&](Worker& worker) {
+        if (next < points.size()) {
+            uint64_t index = next;
+            worker.current = next++;
+            worker.busy = WriteAll(worker.taskFd, &index, sizeof(index));
+            if (!worker.busy) --next; // Процесс завершился - точку получит другой
+        }
+        if (!worker.busy && worker.taskFd >= 0) {
+            close(worker.taskFd); // Работы больше нет - процесс выйдет по EOF
+            worker.taskFd = -1;
+        }
+    };
+
+    for (Worker& worker : pool) dispatch(worker);
+
+    while (true) {
+        std::vector<pollfd> fds;
+        std::vector<size_t> owners;
+        for (size_t w = 0; w < pool.size(); ++w) {
+            if (pool[w].busy) {
+                fds.push_back(pollfd{pool[w].resultFd, POLLIN, 0});
+                owners.push_back(w);
+            }
+        }
+        if (fds.empty()) break;
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (size_t k = 0; k < fds.size(); ++k) {
+            if (fds[k].revents == 0) continue;
+            Worker& worker = pool[owners[k]];
+
+            WireResult wire;
+            if (ReadAll(worker.resultFd, &wire, sizeof(wire)) && wire.index == worker.current) {
+                SweepResult& result = results[wire.index];
+                result.completed = wire.completed != 0;
+                if (result.completed) {
+                    result.adHoc = Unpack(wire.adHoc);
+                    result.group = Unpack(wire.group);
+                }
+                worker.busy = false;
+                PrintProgress(++done, points.size(), result, Tag(config, result.point));
+                dispatch(worker);
+            } else {
+                // Процесс аварийно завершился на точке worker.current - заменяем его новым
+                worker.busy = false;
+                PrintProgress(++done, points.size(), results[worker.current], Tag(config, points[worker.current]));
+                if (worker.taskFd >= 0) close(worker.taskFd);
+                close(worker.resultFd);
+                worker.taskFd = -1;
+                worker.resultFd = -1;
+                int status = 0;
+                waitpid(worker.pid, &status, 0);
+                worker.pid = -1;
+
+                if (next < points.size() && spawn()) {
+                    dispatch(pool.back());
+                }
+            }
+        }
+    }
+
+    for (Worker& worker : pool) {
+        if (worker.taskFd >= 0) close(worker.taskFd);
+        if (worker.resultFd >= 0) close(worker.resultFd);
+        if (worker.pid > 0) {
+            int status = 0;
+            waitpid(worker.pid, &status, 0);
+        }
+    }
+    std::signal(SIGPIPE, previousHandler);
+
+    // Точки, не выполненные из-за аварийного завершения всех процессов
+    for (size_t i = next; i < points.size(); ++i) {
+        PrintProgress(++done, points.size(), results[i], Tag(config, points[i]));
+    }
+    return results;
+}
+
+void SweepRunner::WriteResults(const SimulationConfig& config,
+                               const std::vector<SweepResult>& results,
+                               const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot write sweep results: " + filename);
+    }
+
+    file << "PointId,Design,Tag";
+    for (const SweepFactor& factor : config.sweepFactors) {
+        if (factor.name != "LAMBDA") file << "," << factor.name;
+    }
+    file << ",Lambda,Completed,"
+         << "AdHoc_Throughput_Mbps,AdHoc_Delay_s,AdHoc_PacketLoss,AdHoc_Jitter_s,"
+         << "Group_Throughput_Mbps,Group_Delay_s,Group_PacketLoss,Group_Jitter_s\n";
+
+    for (const SweepResult& r : results) {
+        file << r.point.id << "," << config.sweepDesign << "," << Tag(config, r.point);
+        for (size_t f = 0; f < config.sweepFactors.size(); ++f) {
+            if (config.sweepFactors[f].name != "LAMBDA") file << "," << r.point.values[f];
+        }
+        file << "," << r.point.lambda << "," << (r.completed ? 1 : 0) << ","
+             << r.adHoc.throughput << "," << r.adHoc.delay << "," << r.adHoc.packetLoss << "," << r.adHoc.jitter << ","
+             << r.group.throughput << "," << r.group.delay << "," << r.group.packetLoss << "," << r.group.jitter << "\n";
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../env/environment_config.h"
+#include "../metrics/simulation_metrics.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Точка многомерного плана: значения параметров (в порядке config.sweepFactors)
+ * и интенсивность λ.
+ */
+struct SweepPoint {
+    size_t id = 0;
+    std::vector<double> values;
+    double lambda = 0.0;
+};
+
+struct SweepResult {
+    SweepPoint point;
+    SimulationMetrics adHoc;
+    SimulationMetrics group;
+    bool completed = false;
+};
+
+/**
+ * Запуск плана экспериментов (SWEEP_DESIGN) по параметрам SimulationConfig.
+ *
+ * Симулятор ns-3 - глобальный синглтон, поэтому точки выполняются не в потоках,
+ * а в дочерних процессах (fork): родитель раздаёт номера точек по каналам (pipe)
+ * по мере освобождения процессов и собирает результаты. Для воспроизводимости
+ * каждая точка выполняется с RngRun = id + 1 независимо от процесса.
+ */
+class SweepRunner {
+public:
+    // Если LAMBDA не входит в план, каждая точка плана повторяется для диапазона LAMBDA_*
+    static std::vector<SweepPoint> BuildPoints(const SimulationConfig& config);
+
+    // Конфигурация с подставленными значениями параметров точки
+    static SimulationConfig Apply(const SimulationConfig& base, const SweepPoint& point);
+
+    // Метка вектора параметров: "BUFFER_SIZE=5;PACKET_SIZE=512;LAMBDA=1.5"
+    static std::string Tag(const SimulationConfig& base, const SweepPoint& point);
+
+    // workers = 0 - по числу ядер; без fork точки выполняются последовательно.
+    // Точка с исключением помечается невыполненной (completed = false), план продолжается
+    static std::vector<SweepResult> Run(const SimulationConfig& config,
+                                        const std::vector<SweepPoint>& points,
+                                        size_t workers);
+
+    static void WriteResults(const SimulationConfig& config,
+                             const std::vector<SweepResult>& results,
+                             const std::string& filename);
+};
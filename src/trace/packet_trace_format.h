@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Формат бинарной трассы пакетов: заголовок PacketTraceHeader, за ним
+ * записи PacketTraceRecord фиксированного размера в порядке времени событий.
+ * Порядок байтов - как у машины, записавшей трассу (версия формата в заголовке).
+ * Файл читается без ns-3 (tools/trace_analyzer.cc).
+ */
+
+enum class PacketTraceEvent : uint8_t {
+    Enqueue = 0,  // Пакет принят очередью
+    Dequeue = 1,  // Пакет покинул очередь
+    Drop = 2,     // Пакет потерян (причина - PacketDropReason)
+    Tx = 3,       // Начало передачи кадра в канал (каждая попытка)
+    Rx = 4        // Пакет принят MAC узла-получателя
+};
+
+enum class PacketDropReason : uint8_t {
+    None = 0,
+    QueueOverflow = 1,   // Очередь заполнена при поступлении
+    QueueDisc = 2,       // Отброшен дисциплиной очереди (AQM) или после извлечения
+    MacRetryLimit = 3,   // Исчерпаны повторные попытки MAC / отсрочки CSMA
+    Other = 4
+};
+
+enum class PacketTraceLayer : uint8_t {
+    Device = 0,  // Очередь устройства (очередь MAC Wi-Fi, DropTail CSMA / P2P)
+    QueueDisc = 1 // Корневая дисциплина очереди уровня управления трафиком
+};
+
+struct PacketTraceHeader {
+    char magic[8];         // "NSPKTTR1"
+    uint32_t version;
+    uint32_t recordSize;   // sizeof(PacketTraceRecord)
+    double samplingRate;   // Доля трассируемых пакетов (выбор по UID)
+    uint64_t reserved[2];
+};
+
+struct PacketTraceRecord {
+    int64_t timeNs;
+    uint64_t packetUid;    // Packet::GetUid() - общий для всех копий пакета
+    uint32_t node;         // Node::GetId()
+    uint32_t size;         // Байт на уровне события
+    uint16_t device;       // NetDevice::GetIfIndex() на узле
+    uint8_t event;         // PacketTraceEvent
+    uint8_t reason;        // PacketDropReason (для Drop)
+    uint8_t layer;         // PacketTraceLayer (для событий очереди)
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(PacketTraceHeader) == 40, "Packet trace header layout changed");
+static_assert(sizeof(PacketTraceRecord) == 32, "Packet trace record layout changed");
+
+const char kPacketTraceMagic[8] = {'N', 'S', 'P', 'K', 'T', 'T', 'R', '1'};
+const uint32_t kPacketTraceVersion = 1;
+
+inline const char* PacketDropReasonName(uint8_t reason) {
+    switch (static_cast<PacketDropReason>(reason)) {
+        case PacketDropReason::None: return "none";
+        case PacketDropReason::QueueOverflow: return "queue_overflow";
+        case PacketDropReason::QueueDisc: return "queue_disc";
+        case PacketDropReason::MacRetryLimit: return "mac_retry_limit";
+        default: return "other";
+    }
+}
+
+inline const char* PacketTraceLayerName(uint8_t layer) {
+    return (static_cast<PacketTraceLayer>(layer) == PacketTraceLayer::QueueDisc) ? "queue_disc" : "device";
+}
@@ -0,0 +1,166 @@
+#include "packet_tracer.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/traffic-control-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+namespace {
+
+// splitmix64: равномерный хэш последовательных UID
+uint64_t HashUid(uint64_t uid) {
+    uint64_t z = uid + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t UidOf(Ptr<const Packet> packet) { return packet->GetUid(); }
+uint64_t UidOf(Ptr<const WifiMpdu> mpdu) { return mpdu->GetPacket()->GetUid(); }
+uint64_t UidOf(Ptr<const QueueDiscItem> item) { return item->GetPacket()->GetUid(); }
+
+uint32_t SizeOf(Ptr<const Packet> packet) { return packet->GetSize(); }
+uint32_t SizeOf(Ptr<const WifiMpdu> mpdu) { return mpdu->GetPacket()->GetSize(); }
+uint32_t SizeOf(Ptr<const QueueDiscItem> item) { return item->GetPacket()->GetSize(); }
+
+// Точка подключения: узел, устройство и что записывать
+struct Probe {
+    PacketTracer* tracer;
+    uint32_t node;
+    uint16_t device;
+};
+
+template <typename Item>
+void OnItem(Probe probe, PacketTraceLayer layer, PacketTraceEvent event, PacketDropReason reason,
+            Ptr<const Item> item) {
+    probe.tracer->Record(probe.node, probe.device, layer, event, reason, UidOf(item), SizeOf(item));
+}
+
+void OnQueueDiscDrop(Probe probe, Ptr<const QueueDiscItem> item, const char* /*reason*/) {
+    probe.tracer->Record(probe.node, probe.device, PacketTraceLayer::QueueDisc, PacketTraceEvent::Drop,
+                         PacketDropReason::QueueDisc, UidOf(item), SizeOf(item));
+}
+
+void OnWifiTx(Probe probe, Ptr<const Packet> packet, double /*txPowerW*/) {
+    probe.tracer->Record(probe.node, probe.device, PacketTraceLayer::Device, PacketTraceEvent::Tx,
+                         PacketDropReason::None, UidOf(packet), SizeOf(packet));
+}
+
+// Потери в очереди MAC уже видны по DropBeforeEnqueue, здесь - только после попыток передачи
+void OnWifiMacDrop(Probe probe, WifiMacDropReason reason, Ptr<const WifiMpdu> mpdu) {
+    if (reason == WIFI_MAC_DROP_FAILED_ENQUEUE) return;
+    PacketDropReason cause = (reason == WIFI_MAC_DROP_REACHED_RETRY_LIMIT)
+        ? PacketDropReason::MacRetryLimit : PacketDropReason::Other;
+    probe.tracer->Record(probe.node, probe.device, PacketTraceLayer::Device, PacketTraceEvent::Drop,
+                         cause, UidOf(mpdu), SizeOf(mpdu));
+}
+
+// Enqueue / Dequeue / потери очереди Queue<Item> или QueueDisc
+template <typename Item, typename QueueType>
+void ConnectQueue(Ptr<QueueType> queue, Probe probe, PacketTraceLayer layer) {
+    queue->TraceConnectWithoutContext("Enqueue", MakeBoundCallback(&OnItem<Item>, probe, layer,
+        PacketTraceEvent::Enqueue, PacketDropReason::None));
+    queue->TraceConnectWithoutContext("Dequeue", MakeBoundCallback(&OnItem<Item>, probe, layer,
+        PacketTraceEvent::Dequeue, PacketDropReason::None));
+}
+
+template <typename Item, typename QueueType>
+void ConnectDeviceQueue(Ptr<QueueType> queue, Probe probe) {
+    ConnectQueue<Item>(queue, probe, PacketTraceLayer::Device);
+    queue->TraceConnectWithoutContext("DropBeforeEnqueue", MakeBoundCallback(&OnItem<Item>, probe,
+        PacketTraceLayer::Device, PacketTraceEvent::Drop, PacketDropReason::QueueOverflow));
+    queue->TraceConnectWithoutContext("DropAfterDequeue", MakeBoundCallback(&OnItem<Item>, probe,
+        PacketTraceLayer::Device, PacketTraceEvent::Drop, PacketDropReason::Other));
+}
+
+// Передача и приём устройств CSMA / P2P (Packet::TracedCallback)
+void ConnectWiredDevice(Ptr<NetDevice> device, Probe probe) {
+    device->TraceConnectWithoutContext("PhyTxBegin", MakeBoundCallback(&OnItem<Packet>, probe,
+        PacketTraceLayer::Device, PacketTraceEvent::Tx, PacketDropReason::None));
+    device->TraceConnectWithoutContext("MacRx", MakeBoundCallback(&OnItem<Packet>, probe,
+        PacketTraceLayer::Device, PacketTraceEvent::Rx, PacketDropReason::None));
+}
+
+} // namespace
+
+PacketTracer::PacketTracer(const std::string& filename, double samplingRate)
+    : m_writer(filename, samplingRate),
+      m_threshold(0),
+      m_all(samplingRate >= 1.0) {
+    if (!m_all && samplingRate > 0.0) {
+        m_threshold = static_cast<uint64_t>(std::ldexp(samplingRate, 64));
+    }
+}
+
+void PacketTracer::Record(uint32_t node, uint16_t device, PacketTraceLayer layer, PacketTraceEvent event,
+                          PacketDropReason reason, uint64_t packetUid, uint32_t size) {
+    if (!m_all && HashUid(packetUid) >= m_threshold) return;
+    PacketTraceRecord record{};
+    record.timeNs = Simulator::Now().GetNanoSeconds();
+    record.packetUid = packetUid;
+    record.node = node;
+    record.size = size;
+    record.device = device;
+    record.event = static_cast<uint8_t>(event);
+    record.reason = static_cast<uint8_t>(reason);
+    record.layer = static_cast<uint8_t>(layer);
+    m_writer.Append(record);
+}
+
+void PacketTracer::Install(const NodeContainer& nodes) {
+    for (uint32_t n = 0; n < nodes.GetN(); ++n) {
+        Ptr<Node> node = nodes.Get(n);
+        Ptr<TrafficControlLayer> trafficControl = node->GetObject<TrafficControlLayer>();
+
+        for (uint32_t d = 0; d < node->GetNDevices(); ++d) {
+            Ptr<NetDevice> device = node->GetDevice(d);
+            if (DynamicCast<LoopbackNetDevice>(device)) continue;
+            Probe probe{this, node->GetId(), static_cast<uint16_t>(device->GetIfIndex())};
+
+            if (trafficControl) {
+                if (Ptr<QueueDisc> root = trafficControl->GetRootQueueDiscOnDevice(device)) {
+                    ConnectQueue<QueueDiscItem>(root, probe, PacketTraceLayer::QueueDisc);
+                    root->TraceConnectWithoutContext("DropBeforeEnqueue", MakeBoundCallback(&OnQueueDiscDrop, probe));
+                    root->TraceConnectWithoutContext("DropAfterDequeue", MakeBoundCallback(&OnQueueDiscDrop, probe));
+                }
+            }
+
+            if (Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(device)) {
+                Ptr<WifiMac> mac = wifi->GetMac();
+                if (mac->GetQosSupported()) {
+                    for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO}) {
+                        ConnectDeviceQueue<WifiMpdu>(mac->GetQosTxop(ac)->GetWifiMacQueue(), probe);
+                    }
+                } else {
+                    ConnectDeviceQueue<WifiMpdu>(mac->GetTxop()->GetWifiMacQueue(), probe);
+                }
+                mac->TraceConnectWithoutContext("MacRx", MakeBoundCallback(&OnItem<Packet>, probe,
+                    PacketTraceLayer::Device, PacketTraceEvent::Rx, PacketDropReason::None));
+                mac->TraceConnectWithoutContext("DroppedMpdu", MakeBoundCallback(&OnWifiMacDrop, probe));
+                wifi->GetPhy()->TraceConnectWithoutContext("PhyTxBegin", MakeBoundCallback(&OnWifiTx, probe));
+            } else if (Ptr<CsmaNetDevice> csma = DynamicCast<CsmaNetDevice>(device)) {
+                ConnectDeviceQueue<Packet>(csma->GetQueue(), probe);
+                ConnectWiredDevice(csma, probe);
+                // Исчерпаны попытки отсрочки при занятом канале
+                csma->TraceConnectWithoutContext("PhyTxDrop", MakeBoundCallback(&OnItem<Packet>, probe,
+                    PacketTraceLayer::Device, PacketTraceEvent::Drop, PacketDropReason::MacRetryLimit));
+            } else if (Ptr<PointToPointNetDevice> p2p = DynamicCast<PointToPointNetDevice>(device)) {
+                ConnectDeviceQueue<Packet>(p2p->GetQueue(), probe);
+                ConnectWiredDevice(p2p, probe);
+            }
+        }
+    }
+}
+
+std::string PacketTracer::FileName(const std::string& networkType, double lambda) {
+    std::ostringstream name;
+    name << "scratch/public/packet_trace_" << networkType << "_" << lambda << ".bin";
+    return name.str();
+}
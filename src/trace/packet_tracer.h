@@ -0,0 +1,43 @@
+#pragma once
+
+#include "packet_trace_format.h"
+#include "trace_file_writer.h"
+
+#include <cstdint>
+#include <string>
+
+namespace ns3 {
+class NodeContainer;
+}
+
+/**
+ * Компактная бинарная трасса пакетов (PACKET_TRACE) вместо pcap / ASCII:
+ * постановка в очередь и извлечение (очередь устройства и корневая
+ * дисциплина очереди), потеря с причиной, начало передачи и приём MAC.
+ *
+ * Выборка samplingRate делается по хэшу UID пакета, поэтому для выбранного
+ * пакета сохраняются все события на всех узлах - по ним восстанавливаются
+ * задержки по участкам пути (tools/trace_analyzer).
+ */
+class PacketTracer {
+public:
+    PacketTracer(const std::string& filename, double samplingRate);
+
+    // Подключение к источникам трассировки всех устройств узлов
+    // (вызывать после назначения адресов: дисциплины очереди уже созданы)
+    void Install(const ns3::NodeContainer& nodes);
+
+    void Record(uint32_t node, uint16_t device, PacketTraceLayer layer, PacketTraceEvent event,
+                PacketDropReason reason, uint64_t packetUid, uint32_t size);
+
+    void Close() { m_writer.Close(); }
+    uint64_t RecordsWritten() const { return m_writer.RecordsWritten(); }
+
+    // scratch/public/packet_trace_<networkType>_<lambda>.bin
+    static std::string FileName(const std::string& networkType, double lambda);
+
+private:
+    TraceFileWriter m_writer;
+    uint64_t m_threshold;  // Пакет трассируется, если хэш UID < m_threshold
+    bool m_all;
+};
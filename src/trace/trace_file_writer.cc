@@ -0,0 +1,67 @@
+#include "trace_file_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+TraceFileWriter::TraceFileWriter(const std::string& filename, double samplingRate, size_t bufferRecords)
+    : m_file(std::fopen(filename.c_str(), "wb")),
+      m_capacity(std::max<size_t>(bufferRecords, 1)),
+      m_stopping(false),
+      m_written(0) {
+    if (!m_file) {
+        throw std::runtime_error("Cannot open packet trace file: " + filename);
+    }
+    PacketTraceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kPacketTraceMagic, sizeof(header.magic));
+    header.version = kPacketTraceVersion;
+    header.recordSize = sizeof(PacketTraceRecord);
+    header.samplingRate = samplingRate;
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    m_active.reserve(m_capacity);
+    m_pending.reserve(m_capacity);
+    m_thread = std::thread(&TraceFileWriter::WriterLoop, this);
+}
+
+TraceFileWriter::~TraceFileWriter() {
+    Close();
+}
+
+void TraceFileWriter::Flush() {
+    if (m_active.empty()) return;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_drained.wait(lock, [this]() { return m_pending.empty(); });
+    m_pending.swap(m_active);
+    m_ready.notify_one();
+}
+
+void TraceFileWriter::WriterLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_ready.wait(lock, [this]() { return !m_pending.empty() || m_stopping; });
+        if (m_pending.empty()) break; // Остановка и всё записано
+
+        // Поток симуляции не трогает m_pending, пока он не пуст
+        lock.unlock();
+        size_t count = std::fwrite(m_pending.data(), sizeof(PacketTraceRecord), m_pending.size(), m_file);
+        lock.lock();
+        m_written += count;
+        m_pending.clear();
+        m_drained.notify_one();
+    }
+}
+
+void TraceFileWriter::Close() {
+    if (!m_file) return;
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_ready.notify_one();
+    m_thread.join();
+    std::fclose(m_file);
+    m_file = nullptr;
+}
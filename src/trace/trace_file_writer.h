@@ -0,0 +1,53 @@
+#pragma once
+
+#include "packet_trace_format.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Запись трассы с двойной буферизацией: поток симуляции заполняет активный
+ * буфер, заполненный буфер передаётся фоновому потоку, который пишет его
+ * одним fwrite, пока симуляция продолжает заполнять второй. Поток симуляции
+ * ждёт только если диск не успел записать предыдущий буфер.
+ */
+class TraceFileWriter {
+public:
+    // std::runtime_error, если файл не открывается
+    TraceFileWriter(const std::string& filename, double samplingRate, size_t bufferRecords = 1 << 16);
+    ~TraceFileWriter();
+
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+
+    void Append(const PacketTraceRecord& record) {
+        m_active.push_back(record);
+        if (m_active.size() >= m_capacity) Flush();
+    }
+
+    // Дописывает буферы и закрывает файл (повторный вызов ничего не делает)
+    void Close();
+
+    uint64_t RecordsWritten() const { return m_written; }
+
+private:
+    void Flush();
+    void WriterLoop();
+
+    std::FILE* m_file;
+    size_t m_capacity;
+    std::vector<PacketTraceRecord> m_active;   // Заполняется потоком симуляции
+    std::vector<PacketTraceRecord> m_pending;  // Записывается фоновым потоком
+    std::mutex m_mutex;
+    std::condition_variable m_ready;           // m_pending заполнен или остановка
+    std::condition_variable m_drained;         // m_pending записан
+    bool m_stopping;
+    uint64_t m_written;
+    std::thread m_thread;
+};
@@ -0,0 +1,78 @@
+#include "arrival_trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+std::shared_ptr<const ArrivalTrace> ArrivalTrace::Open(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open arrival trace " + filename + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ArrivalTraceHeader)) {
+        close(fd);
+        throw std::runtime_error(filename + ": not an arrival trace (too short)");
+    }
+    const size_t fileSize = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("mmap of arrival trace " + filename + " failed: " + std::strerror(errno));
+    }
+    // Каждый источник читает свой участок последовательно
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    std::shared_ptr<ArrivalTrace> trace(new ArrivalTrace());
+    trace->m_mapping = mapping;
+    trace->m_size = fileSize;
+    trace->m_header = static_cast<const ArrivalTraceHeader*>(mapping);
+
+    const ArrivalTraceHeader& header = *trace->m_header;
+    if (std::memcmp(header.magic, kArrivalTraceMagic, sizeof(header.magic)) != 0 ||
+        header.version != kArrivalTraceVersion || header.recordSize != sizeof(ArrivalRecord)) {
+        throw std::runtime_error(filename + ": unsupported arrival trace format");
+    }
+    const uint64_t indexBytes = static_cast<uint64_t>(header.numNodes) * sizeof(ArrivalTraceIndexEntry);
+    const uint64_t recordsOffset = sizeof(ArrivalTraceHeader) + indexBytes;
+    if (header.numNodes == 0 || recordsOffset > fileSize ||
+        header.totalRecords > (fileSize - recordsOffset) / sizeof(ArrivalRecord)) {
+        throw std::runtime_error(filename + ": truncated arrival trace");
+    }
+    const char* base = static_cast<const char*>(mapping);
+    trace->m_index = reinterpret_cast<const ArrivalTraceIndexEntry*>(base + sizeof(ArrivalTraceHeader));
+    trace->m_records = reinterpret_cast<const ArrivalRecord*>(base + recordsOffset);
+
+    // Проверяются только границы участков: сами записи читаются лениво
+    for (uint32_t node = 0; node < header.numNodes; ++node) {
+        const ArrivalTraceIndexEntry& entry = trace->m_index[node];
+        if (entry.firstRecord > header.totalRecords || entry.count > header.totalRecords - entry.firstRecord) {
+            throw std::runtime_error(filename + ": node " + std::to_string(node) + " records out of range");
+        }
+    }
+    return trace;
+}
+
+ArrivalTrace::~ArrivalTrace() {
+    if (m_mapping) munmap(m_mapping, m_size);
+}
+
+int64_t ArrivalTrace::PeriodNs(uint32_t node) const {
+    const uint64_t count = Count(node);
+    if (count == 0) return 0;
+    if (count == 1) return 1000000000;
+    const int64_t span = Record(node, count - 1).timeNs - Record(node, 0).timeNs;
+    const int64_t period = span + span / static_cast<int64_t>(count - 1);
+    return (period > 0) ? period : 1;
+}
+
+double ArrivalTrace::MeanRate(uint32_t node) const {
+    const int64_t period = PeriodNs(node);
+    if (period <= 0) return 0.0;
+    return static_cast<double>(Count(node)) / (static_cast<double>(period) * 1e-9);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "arrival_trace_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Трасса поступлений, отображённая в память (mmap) только для чтения.
+ * Страницы подгружаются по мере чтения записей, поэтому трассы в несколько
+ * гигабайт не загружаются в RAM целиком; один экземпляр разделяют источники
+ * всех узлов.
+ */
+class ArrivalTrace {
+public:
+    // std::runtime_error, если файл не открывается или не является трассой
+    static std::shared_ptr<const ArrivalTrace> Open(const std::string& filename);
+
+    ~ArrivalTrace();
+
+    ArrivalTrace(const ArrivalTrace&) = delete;
+    ArrivalTrace& operator=(const ArrivalTrace&) = delete;
+
+    uint32_t NumNodes() const { return m_header->numNodes; }
+    uint64_t Count(uint32_t node) const { return m_index[node].count; }
+
+    const ArrivalRecord& Record(uint32_t node, uint64_t k) const {
+        return m_records[m_index[node].firstRecord + k];
+    }
+
+    // Период повторения записей узла, нс: длительность записи плюс средний
+    // интервал, чтобы стык повторов не нарушал интенсивность (1 с при одной записи)
+    int64_t PeriodNs(uint32_t node) const;
+
+    // Средняя интенсивность поступлений узла, пакетов/с (0 - нет записей)
+    double MeanRate(uint32_t node) const;
+
+private:
+    ArrivalTrace() = default;
+
+    void* m_mapping = nullptr;
+    size_t m_size = 0;
+    const ArrivalTraceHeader* m_header = nullptr;
+    const ArrivalTraceIndexEntry* m_index = nullptr;
+    const ArrivalRecord* m_records = nullptr;
+};
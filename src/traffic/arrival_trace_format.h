@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Формат бинарной трассы поступлений (TRAFFIC_MODEL=trace): заголовок
+ * ArrivalTraceHeader, таблица ArrivalTraceIndexEntry по узлам трассы, затем
+ * записи ArrivalRecord. Записи каждого узла идут подряд в порядке времени,
+ * поэтому источник узла читает только свой участок файла.
+ * Файл собирается из CSV утилитой tools/arrival_trace_builder.cc.
+ */
+
+struct ArrivalTraceHeader {
+    char magic[8];          // "NSARRTR1"
+    uint32_t version;
+    uint32_t numNodes;      // Записей в таблице узлов
+    uint32_t recordSize;    // sizeof(ArrivalRecord)
+    uint32_t reserved;
+    uint64_t totalRecords;
+};
+
+struct ArrivalTraceIndexEntry {
+    uint64_t firstRecord;   // Номер первой записи узла среди всех записей
+    uint64_t count;
+};
+
+struct ArrivalRecord {
+    int64_t timeNs;         // Время поступления от начала записи трассы
+    uint32_t size;          // Байт полезной нагрузки UDP (0 - PACKET_SIZE)
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ArrivalTraceHeader) == 32, "Arrival trace header layout changed");
+static_assert(sizeof(ArrivalTraceIndexEntry) == 16, "Arrival trace index layout changed");
+static_assert(sizeof(ArrivalRecord) == 16, "Arrival trace record layout changed");
+
+const char kArrivalTraceMagic[8] = {'N', 'S', 'A', 'R', 'R', 'T', 'R', '1'};
+const uint32_t kArrivalTraceVersion = 1;
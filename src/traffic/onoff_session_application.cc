@@ -0,0 +1,113 @@
+#include "onoff_session_application.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/packet.h"
+#include "ns3/seq-ts-header.h"
+#include "ns3/simulator.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ns3;
+
+NS_OBJECT_ENSURE_REGISTERED(OnOffSessionApplication);
+
+TypeId OnOffSessionApplication::GetTypeId() {
+    static TypeId tid = TypeId("OnOffSessionApplication")
+        .SetParent<Application>()
+        .SetGroupName("Applications")
+        .AddConstructor<OnOffSessionApplication>();
+    return tid;
+}
+
+OnOffSessionApplication::OnOffSessionApplication()
+    : m_port(0),
+      m_packetSize(0),
+      m_peakRate(0.0),
+      m_onFraction(1.0),
+      m_burstPackets(0),
+      m_credit(0.0),
+      m_sent(0),
+      m_bursts(0) {}
+
+void OnOffSessionApplication::Setup(Ipv4Address receiver,
+                                    uint16_t port,
+                                    uint32_t packetSize,
+                                    double peakRate,
+                                    Ptr<RandomVariableStream> onTime,
+                                    Ptr<RandomVariableStream> offTime,
+                                    double onFraction) {
+    m_receiver = receiver;
+    m_port = port;
+    m_packetSize = packetSize;
+    m_peakRate = peakRate;
+    m_onTime = onTime;
+    m_offTime = offTime;
+    m_onFraction = onFraction;
+}
+
+void OnOffSessionApplication::DoDispose() {
+    m_socket = nullptr;
+    m_onTime = nullptr;
+    m_offTime = nullptr;
+    Application::DoDispose();
+}
+
+void OnOffSessionApplication::StartApplication() {
+    if (m_peakRate <= 0.0 || !m_onTime || !m_offTime) return;
+    if (!m_socket) {
+        m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        m_socket->Bind();
+        m_socket->Connect(InetSocketAddress(m_receiver, m_port));
+    }
+    m_burstPackets = 0;
+    m_credit = 0.0;
+
+    // Случайная фаза, чтобы источники не начинали всплески одновременно
+    Ptr<UniformRandomVariable> phase = CreateObject<UniformRandomVariable>();
+    if (phase->GetValue() < m_onFraction) {
+        StartBurst();
+    } else {
+        m_sendEvent = Simulator::Schedule(Seconds(m_offTime->GetValue()),
+                                          &OnOffSessionApplication::StartBurst, this);
+    }
+}
+
+void OnOffSessionApplication::StopApplication() {
+    Simulator::Cancel(m_sendEvent);
+}
+
+void OnOffSessionApplication::StartBurst() {
+    const double duration = m_onTime->GetValue();
+    m_burstEnd = Simulator::Now() + Seconds(duration);
+    m_credit += duration * m_peakRate;
+    m_burstPackets = static_cast<uint64_t>(std::floor(m_credit));
+    m_credit -= static_cast<double>(m_burstPackets);
+    ++m_bursts;
+
+    if (m_burstPackets > 0) {
+        Send();
+    } else {
+        m_sendEvent = Simulator::Schedule(Seconds(duration + m_offTime->GetValue()),
+                                          &OnOffSessionApplication::StartBurst, this);
+    }
+}
+
+void OnOffSessionApplication::Send() {
+    SeqTsHeader seqTs;
+    seqTs.SetSeq(static_cast<uint32_t>(m_sent));
+    const uint32_t payload = std::max(m_packetSize, seqTs.GetSerializedSize()) - seqTs.GetSerializedSize();
+    Ptr<Packet> packet = Create<Packet>(payload);
+    packet->AddHeader(seqTs);
+    m_socket->Send(packet);
+    ++m_sent;
+
+    if (--m_burstPackets > 0) {
+        m_sendEvent = Simulator::Schedule(Seconds(1.0 / m_peakRate), &OnOffSessionApplication::Send, this);
+    } else {
+        // Пауза отсчитывается от конца всплеска (последний пакет может быть раньше)
+        const Time idle = std::max(m_burstEnd - Simulator::Now(), Time()) + Seconds(m_offTime->GetValue());
+        m_sendEvent = Simulator::Schedule(idle, &OnOffSessionApplication::StartBurst, this);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/socket.h"
+
+/**
+ * Источник UDP с чередованием всплесков и пауз: в течение всплеска пакеты
+ * идут с пиковой интенсивностью peakRate, длительности всплесков и пауз -
+ * независимые случайные величины onTime / offTime (Парето или логнормальные
+ * с тяжёлым хвостом). Средняя интенсивность
+ * peakRate * E[on] / (E[on] + E[off]); дробная часть пакетов всплеска
+ * переносится на следующий, чтобы она не смещалась округлением.
+ *
+ * Запуск - во всплеске с вероятностью onFraction, иначе с паузы. Пакет
+ * несёт SeqTsHeader, как у UdpClient, поэтому получатель - обычный UdpServer.
+ */
+class OnOffSessionApplication : public ns3::Application {
+public:
+    static ns3::TypeId GetTypeId();
+
+    OnOffSessionApplication();
+
+    void Setup(ns3::Ipv4Address receiver,
+               uint16_t port,
+               uint32_t packetSize,
+               double peakRate,
+               ns3::Ptr<ns3::RandomVariableStream> onTime,
+               ns3::Ptr<ns3::RandomVariableStream> offTime,
+               double onFraction);
+
+    uint64_t PacketsSent() const { return m_sent; }
+    uint64_t Bursts() const { return m_bursts; }
+
+protected:
+    void DoDispose() override;
+
+private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    void StartBurst();
+    void Send();
+
+    ns3::Ipv4Address m_receiver;
+    uint16_t m_port;
+    uint32_t m_packetSize;
+    double m_peakRate;             // Пакетов в секунду во время всплеска
+    ns3::Ptr<ns3::RandomVariableStream> m_onTime;
+    ns3::Ptr<ns3::RandomVariableStream> m_offTime;
+    double m_onFraction;
+
+    ns3::Ptr<ns3::Socket> m_socket;
+    ns3::EventId m_sendEvent;
+    ns3::Time m_burstEnd;
+    uint64_t m_burstPackets;       // Осталось отправить в текущем всплеске
+    double m_credit;               // Дробная часть пакетов предыдущих всплесков
+    uint64_t m_sent;
+    uint64_t m_bursts;
+};
@@ -0,0 +1,96 @@
+#include "trace_replay_application.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/packet.h"
+#include "ns3/seq-ts-header.h"
+#include "ns3/simulator.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace ns3;
+
+NS_OBJECT_ENSURE_REGISTERED(TraceReplayApplication);
+
+TypeId TraceReplayApplication::GetTypeId() {
+    static TypeId tid = TypeId("TraceReplayApplication")
+        .SetParent<Application>()
+        .SetGroupName("Applications")
+        .AddConstructor<TraceReplayApplication>();
+    return tid;
+}
+
+TraceReplayApplication::TraceReplayApplication()
+    : m_traceNode(0),
+      m_port(0),
+      m_timeScale(1.0),
+      m_defaultSize(0),
+      m_next(0),
+      m_cycle(0),
+      m_sent(0) {}
+
+void TraceReplayApplication::Setup(std::shared_ptr<const ArrivalTrace> trace,
+                                   uint32_t traceNode,
+                                   Ipv4Address receiver,
+                                   uint16_t port,
+                                   double timeScale,
+                                   uint32_t defaultSize) {
+    m_trace = std::move(trace);
+    m_traceNode = traceNode;
+    m_receiver = receiver;
+    m_port = port;
+    m_timeScale = timeScale;
+    m_defaultSize = defaultSize;
+}
+
+void TraceReplayApplication::DoDispose() {
+    m_socket = nullptr;
+    m_trace.reset();
+    Application::DoDispose();
+}
+
+void TraceReplayApplication::StartApplication() {
+    if (!m_trace || m_trace->Count(m_traceNode) == 0) return;
+    if (!m_socket) {
+        m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        m_socket->Bind();
+        m_socket->Connect(InetSocketAddress(m_receiver, m_port));
+    }
+    m_origin = Simulator::Now();
+    m_next = 0;
+    m_cycle = 0;
+    ScheduleNext();
+}
+
+void TraceReplayApplication::StopApplication() {
+    Simulator::Cancel(m_sendEvent);
+}
+
+void TraceReplayApplication::ScheduleNext() {
+    const int64_t first = m_trace->Record(m_traceNode, 0).timeNs;
+    const int64_t offset = m_trace->Record(m_traceNode, m_next).timeNs - first +
+                           static_cast<int64_t>(m_cycle) * m_trace->PeriodNs(m_traceNode);
+    const Time target = m_origin + NanoSeconds(static_cast<int64_t>(static_cast<double>(offset) * m_timeScale));
+    // Неупорядоченные записи отправляются сразу, а не в прошлом
+    m_sendEvent = Simulator::Schedule(std::max(target - Simulator::Now(), Time()),
+                                      &TraceReplayApplication::Send, this);
+}
+
+void TraceReplayApplication::Send() {
+    const ArrivalRecord& record = m_trace->Record(m_traceNode, m_next);
+    SeqTsHeader seqTs;
+    seqTs.SetSeq(static_cast<uint32_t>(m_sent));
+    const uint32_t size = (record.size > 0) ? record.size : m_defaultSize;
+    const uint32_t payload = std::max(size, seqTs.GetSerializedSize()) - seqTs.GetSerializedSize();
+    Ptr<Packet> packet = Create<Packet>(payload);
+    packet->AddHeader(seqTs);
+    m_socket->Send(packet);
+    ++m_sent;
+
+    if (++m_next == m_trace->Count(m_traceNode)) {
+        m_next = 0;
+        ++m_cycle;
+    }
+    ScheduleNext();
+}
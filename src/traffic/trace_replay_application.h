@@ -0,0 +1,61 @@
+#pragma once
+
+#include "arrival_trace.h"
+
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ptr.h"
+#include "ns3/socket.h"
+
+#include <memory>
+
+/**
+ * Источник UDP, воспроизводящий моменты поступлений и размеры пакетов
+ * одного узла трассы ArrivalTrace. Запланировано всегда только следующее
+ * событие отправки, записи читаются из отображённого файла по одной.
+ *
+ * Время записи отсчитывается от первой записи узла и умножается на
+ * timeScale (> 1 - реже, < 1 - чаще); после последней записи трасса
+ * повторяется с периодом ArrivalTrace::PeriodNs. Пакет несёт SeqTsHeader,
+ * как у UdpClient, поэтому получатель - обычный UdpServer.
+ */
+class TraceReplayApplication : public ns3::Application {
+public:
+    static ns3::TypeId GetTypeId();
+
+    TraceReplayApplication();
+
+    void Setup(std::shared_ptr<const ArrivalTrace> trace,
+               uint32_t traceNode,
+               ns3::Ipv4Address receiver,
+               uint16_t port,
+               double timeScale,
+               uint32_t defaultSize);
+
+    uint64_t PacketsSent() const { return m_sent; }
+
+protected:
+    void DoDispose() override;
+
+private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    void ScheduleNext();
+    void Send();
+
+    std::shared_ptr<const ArrivalTrace> m_trace;
+    uint32_t m_traceNode;
+    ns3::Ipv4Address m_receiver;
+    uint16_t m_port;
+    double m_timeScale;
+    uint32_t m_defaultSize;
+
+    ns3::Ptr<ns3::Socket> m_socket;
+    ns3::EventId m_sendEvent;
+    ns3::Time m_origin;         // Время запуска - момент первой записи узла
+    uint64_t m_next;            // Номер следующей записи в текущем повторе
+    uint64_t m_cycle;           // Номер повтора трассы
+    uint64_t m_sent;
+};
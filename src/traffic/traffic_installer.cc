@@ -0,0 +1,83 @@
+#include "traffic_installer.h"
+#include "onoff_session_application.h"
+#include "trace_replay_application.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+namespace {
+
+// Длительность всплеска или паузы со средним mean и тяжестью хвоста по показателю Хёрста
+Ptr<RandomVariableStream> SessionDuration(const std::string& distribution, double mean, double hurst) {
+    const double shape = 3.0 - 2.0 * hurst;  // α в (1, 2]
+    if (distribution == "lognormal") {
+        const double sigma2 = std::log(2.0) / (shape - 1.0);
+        Ptr<LogNormalRandomVariable> duration = CreateObject<LogNormalRandomVariable>();
+        duration->SetAttribute("Mu", DoubleValue(std::log(mean) - sigma2 / 2));
+        duration->SetAttribute("Sigma", DoubleValue(std::sqrt(sigma2)));
+        return duration;
+    }
+    // Среднее Парето - scale * α / (α - 1)
+    Ptr<ParetoRandomVariable> duration = CreateObject<ParetoRandomVariable>();
+    duration->SetAttribute("Scale", DoubleValue(mean * (shape - 1.0) / shape));
+    duration->SetAttribute("Shape", DoubleValue(shape));
+    return duration;
+}
+
+} // namespace
+
+TrafficInstaller::TrafficInstaller(const SimulationConfig& config, double lambda)
+    : m_config(config),
+      m_lambda(lambda) {
+    if (config.trafficModel == "trace") {
+        m_trace = ArrivalTrace::Open(config.trafficTraceFile);
+    }
+}
+
+ApplicationContainer TrafficInstaller::Install(Ptr<Node> sender,
+                                               uint32_t nodeId,
+                                               Ipv4Address receiver,
+                                               uint16_t port) const {
+    double nodeLambda = m_lambda * m_config.nodeLoads[nodeId];
+
+    if (m_trace) {
+        const uint32_t traceNode = nodeId % m_trace->NumNodes();
+        const double traceRate = m_trace->MeanRate(traceNode);
+        if (traceRate <= 0.0) return ApplicationContainer();
+        double timeScale = m_config.trafficTraceTimeScale;
+        if (timeScale <= 0.0) {
+            if (nodeLambda <= 0.0) return ApplicationContainer();
+            timeScale = traceRate / nodeLambda;
+        }
+        Ptr<TraceReplayApplication> app = CreateObject<TraceReplayApplication>();
+        app->Setup(m_trace, traceNode, receiver, port, timeScale, m_config.packetSize);
+        sender->AddApplication(app);
+        return ApplicationContainer(app);
+    }
+
+    if (m_config.trafficModel == "onoff") {
+        if (nodeLambda <= 0.0) return ApplicationContainer();
+        const double hurst = m_config.NodeHurst(nodeId);
+        const double onFraction = m_config.trafficOnMeanS / (m_config.trafficOnMeanS + m_config.trafficOffMeanS);
+        Ptr<OnOffSessionApplication> app = CreateObject<OnOffSessionApplication>();
+        app->Setup(receiver, port, m_config.packetSize, nodeLambda / onFraction,
+                   SessionDuration(m_config.trafficOnOffDistribution, m_config.trafficOnMeanS, hurst),
+                   SessionDuration(m_config.trafficOnOffDistribution, m_config.trafficOffMeanS, hurst),
+                   onFraction);
+        sender->AddApplication(app);
+        return ApplicationContainer(app);
+    }
+
+    UdpClientHelper client(receiver, port);
+    // Убираем ограничение MaxPackets, чтобы нагрузка росла с Lambda
+    // Количество пакетов = lambda * simulationDuration
+    uint32_t totalPackets = static_cast<uint32_t>(nodeLambda * m_config.simulationDuration * 1.5);
+    client.SetAttribute("MaxPackets", UintegerValue(totalPackets));
+    client.SetAttribute("Interval", TimeValue(Seconds(1.0 / nodeLambda)));
+    client.SetAttribute("PacketSize", UintegerValue(m_config.packetSize));
+    return client.Install(sender);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "arrival_trace.h"
+#include "../env/environment_config.h"
+
+#include "ns3/network-module.h"
+
+#include <memory>
+
+/**
+ * Источники трафика узлов для обоих симуляторов (TRAFFIC_MODEL):
+ * - cbr   - UdpClient с постоянным интервалом 1 / (lambda * nodeLoad)
+ * - trace - TraceReplayApplication по трассе TRAFFIC_TRACE_FILE; узел i
+ *   воспроизводит узел i % N трассы. При TRAFFIC_TRACE_TIME_SCALE = 0 время
+ *   трассы масштабируется поузлово так, чтобы средняя интенсивность была
+ *   lambda * nodeLoad (форма всплесков сохраняется), иначе - на заданный
+ *   множитель для всех узлов независимо от lambda.
+ * - onoff - OnOffSessionApplication: всплески и паузы со средними
+ *   TRAFFIC_ON_MEAN_S / TRAFFIC_OFF_MEAN_S и распределением Парето формы
+ *   α = 3 - 2H (суперпозиция таких источников самоподобна с показателем
+ *   Хёрста H) или логнормальным с σ² = ln 2 / (α - 1) (при H = 0.5
+ *   коэффициент вариации 1, как у экспоненциального). Пиковая интенсивность
+ *   выбирается так, чтобы средняя осталась lambda * nodeLoad.
+ */
+class TrafficInstaller {
+public:
+    // Трасса открывается один раз на прогон (std::runtime_error при ошибке)
+    TrafficInstaller(const SimulationConfig& config, double lambda);
+
+    // Источник узла nodeId к receiver:port; время старта и остановки задаёт симулятор
+    ns3::ApplicationContainer Install(ns3::Ptr<ns3::Node> sender,
+                                      uint32_t nodeId,
+                                      ns3::Ipv4Address receiver,
+                                      uint16_t port) const;
+
+private:
+    const SimulationConfig& m_config;
+    double m_lambda;
+    std::shared_ptr<const ArrivalTrace> m_trace;
+};
@@ -3,18 +3,6 @@
 #include <fstream>
 #include <iostream>
 
-// Определение структуры AnalysisResults из main.cc
-struct AnalysisResults {
-    std::vector<double> lambdas;
-    std::vector<double> actualThroughputs;
-    std::vector<double> actualDelays;
-    std::vector<double> meanValueAnalysis;
-    std::vector<double> globalBalanceMethod;
-    std::vector<double> gordonNewellMethod;
-    std::vector<double> buzenMethod;
-    std::vector<double> meanValueDelay;
-};
-
 void CsvWriter::WriteResults(const std::vector<SimulationMetrics>& adHocResults,
                              const std::vector<SimulationMetrics>& groupResults,
                              const SimulationConfig& config,
@@ -28,7 +16,11 @@ void CsvWriter::WriteResults(const std::vector<SimulationMetrics>& adHocResults,
          << "Node0_Load,Node1_Load,Node2_Load,Node3_Load,Node4_Load,"
          << "Node5_Load,Node6_Load,Node7_Load,Node8_Load,"
          << "SimulationDuration,BufferSize,PacketSize,DataRate_Mbps,LinkDelay_ms,"
-         << "MaxPackets,NumNodes,NumGroups,ServiceRate,BuzenMultiplier\n";
+         << "MaxPackets,NumNodes,NumGroups,ServiceRate,BuzenMultiplier,"
+         << "RoutingOverheadPackets,RoutingOverheadBytes,"
+         << "WifiStandard,WifiChannelWidth_MHz,WifiRateManager,WifiAmpduSize,WifiAmsduSize,"
+         << "QueueDisc,AqmDroppedPackets,DelayP95_s,"
+         << "BackboneTopology,BackboneMaxUtilization,BackboneMeanUtilization\n";
     
     double lambda = config.lambdaStart;
     
@@ -51,7 +43,13 @@ void CsvWriter::WriteResults(const std::vector<SimulationMetrics>& adHocResults,
         file << "," << config.simulationDuration << "," << config.bufferSize << ","
              << config.packetSize << "," << config.dataRateMbps << "," << config.linkDelayMs << ","
              << config.maxPackets << "," << config.numNodes << "," << config.numGroups << ","
-             << config.serviceRate << "," << config.buzenCustomersMultiplier << "\n";
+             << config.serviceRate << "," << config.buzenCustomersMultiplier << ","
+             << m.routingOverheadPackets << "," << m.routingOverheadBytes << ","
+             << config.wifiStandard << "," << config.wifiChannelWidth << "," << config.wifiRateManager << ","
+             << config.wifiAmpduSize << "," << config.wifiAmsduSize << ","
+             << config.groupQueueDisc << "," << m.aqmDroppedPackets << ","
+             << m.delayP95 << "," << config.backboneTopology << ","
+             << m.backboneMaxUtilization << "," << m.backboneMeanUtilization << "\n";
         
         lambda += config.lambdaStep;
     }
@@ -76,7 +74,13 @@ void CsvWriter::WriteResults(const std::vector<SimulationMetrics>& adHocResults,
         file << "," << config.simulationDuration << "," << config.bufferSize << ","
              << config.packetSize << "," << config.dataRateMbps << "," << config.linkDelayMs << ","
              << config.maxPackets << "," << config.numNodes << "," << config.numGroups << ","
-             << config.serviceRate << "," << config.buzenCustomersMultiplier << "\n";
+             << config.serviceRate << "," << config.buzenCustomersMultiplier << ","
+             << m.routingOverheadPackets << "," << m.routingOverheadBytes << ","
+             << config.wifiStandard << "," << config.wifiChannelWidth << "," << config.wifiRateManager << ","
+             << config.wifiAmpduSize << "," << config.wifiAmsduSize << ","
+             << config.groupQueueDisc << "," << m.aqmDroppedPackets << ","
+             << m.delayP95 << "," << config.backboneTopology << ","
+             << m.backboneMaxUtilization << "," << m.backboneMeanUtilization << "\n";
         
         lambda += config.lambdaStep;
     }
@@ -259,7 +263,10 @@ void CsvWriter::WriteAnalysisWithMethods(const AnalysisResults& adHocAnalysis,
     
     // Заголовок CSV файла
     file << "NetworkType,Lambda,ActualThroughput,ActualDelay,"
-         << "MeanValueAnalysis,GlobalBalanceMethod,GordonNewellMethod,BuzenMethod,MeanValueDelay\n";
+         << "MeanValueAnalysis,GlobalBalanceMethod,GordonNewellMethod,BuzenMethod,MeanValueDelay,"
+         << "JacksonThroughput_Mbps,JacksonDelay_s,ProtocolModelThroughput,DecompositionThroughput_Mbps,"
+         << "DecompositionDelay_s,PooledChannelThroughput_Mbps,PooledChannelDelay_s,"
+         << "NodeMG1KThroughput_Mbps,NodeMG1KDelay_s\n";
     
     // Записываем результаты для Ad-Hoc сети
     for (size_t i = 0; i < adHocAnalysis.lambdas.size(); ++i) {
@@ -270,7 +277,16 @@ void CsvWriter::WriteAnalysisWithMethods(const AnalysisResults& adHocAnalysis,
              << adHocAnalysis.globalBalanceMethod[i] << ","
              << adHocAnalysis.gordonNewellMethod[i] << ","
              << adHocAnalysis.buzenMethod[i] << ","
-             << adHocAnalysis.meanValueDelay[i] << "\n";
+             << adHocAnalysis.meanValueDelay[i] << ","
+             << adHocAnalysis.jacksonThroughput[i] << ","
+             << adHocAnalysis.jacksonDelay[i] << ","
+             << adHocAnalysis.protocolModelThroughput[i] << ","
+             << adHocAnalysis.decompositionThroughput[i] << ","
+             << adHocAnalysis.decompositionDelay[i] << ","
+             << adHocAnalysis.pooledChannelThroughput[i] << ","
+             << adHocAnalysis.pooledChannelDelay[i] << ","
+             << adHocAnalysis.nodeMG1KThroughput[i] << ","
+             << adHocAnalysis.nodeMG1KDelay[i] << "\n";
     }
     
     // Записываем результаты для Group сети
@@ -282,7 +298,16 @@ void CsvWriter::WriteAnalysisWithMethods(const AnalysisResults& adHocAnalysis,
              << groupAnalysis.globalBalanceMethod[i] << ","
              << groupAnalysis.gordonNewellMethod[i] << ","
              << groupAnalysis.buzenMethod[i] << ","
-             << groupAnalysis.meanValueDelay[i] << "\n";
+             << groupAnalysis.meanValueDelay[i] << ","
+             << groupAnalysis.jacksonThroughput[i] << ","
+             << groupAnalysis.jacksonDelay[i] << ","
+             << groupAnalysis.protocolModelThroughput[i] << ","
+             << groupAnalysis.decompositionThroughput[i] << ","
+             << groupAnalysis.decompositionDelay[i] << ","
+             << groupAnalysis.pooledChannelThroughput[i] << ","
+             << groupAnalysis.pooledChannelDelay[i] << ","
+             << groupAnalysis.nodeMG1KThroughput[i] << ","
+             << groupAnalysis.nodeMG1KDelay[i] << "\n";
     }
     
     file.close();
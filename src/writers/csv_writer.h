@@ -6,7 +6,25 @@
 #include <string>
 
 // Структура для хранения результатов анализа различными методами
-struct AnalysisResults;
+struct AnalysisResults {
+    std::vector<double> lambdas;
+    std::vector<double> actualThroughputs;
+    std::vector<double> actualDelays;
+    std::vector<double> meanValueAnalysis;
+    std::vector<double> globalBalanceMethod;
+    std::vector<double> gordonNewellMethod;
+    std::vector<double> buzenMethod;
+    std::vector<double> meanValueDelay;
+    std::vector<double> jacksonThroughput;  // Сеть Джексона по топологии симулятора, Мбит/с
+    std::vector<double> jacksonDelay;       // с
+    std::vector<double> protocolModelThroughput;  // Мбит/с: AdHoc - DCF Бианки, Group - иерархическая модель
+    std::vector<double> decompositionThroughput;  // Декомпозиция сети с блокировкой (BAS), Мбит/с
+    std::vector<double> decompositionDelay;       // с
+    std::vector<double> pooledChannelThroughput;  // M/M/c/K общего канала, Мбит/с
+    std::vector<double> pooledChannelDelay;       // с
+    std::vector<double> nodeMG1KThroughput;       // Независимые узлы M/G/1/K (SERVICE_SCV), Мбит/с
+    std::vector<double> nodeMG1KDelay;            // с
+};
 
 class CsvWriter {
 public:
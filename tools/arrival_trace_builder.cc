@@ -0,0 +1,186 @@
+/**
+ * Сборка бинарной трассы поступлений (TRAFFIC_MODEL=trace) из CSV:
+ *   arrival_trace_builder <arrivals.csv> <arrivals.bin>
+ *
+ * Строка CSV - "узел,время_с,размер_байт" (узлы нумеруются с 0, размер 0 -
+ * PACKET_SIZE симуляции); строка заголовка и строки с '#' пропускаются.
+ * Записи каждого узла должны идти в неубывающем порядке времени, узлы
+ * могут чередоваться. Файл читается дважды (подсчёт записей узлов, затем
+ * запись по смещениям), поэтому в памяти - только буферы узлов, а не трасса.
+ */
+
+#include "../src/traffic/arrival_trace_format.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CsvArrival {
+    uint32_t node;
+    int64_t timeNs;
+    uint32_t size;
+};
+
+// false - строка не является записью (заголовок, комментарий, пустая)
+bool ParseLine(const std::string& line, CsvArrival& arrival) {
+    if (line.empty() || line[0] == '#') return false;
+    const char* cursor = line.c_str();
+    char* end = nullptr;
+    unsigned long node = std::strtoul(cursor, &end, 10);
+    if (end == cursor || *end != ',') return false;
+    cursor = end + 1;
+    double seconds = std::strtod(cursor, &end);
+    if (end == cursor || *end != ',') return false;
+    cursor = end + 1;
+    unsigned long size = std::strtoul(cursor, &end, 10);
+    if (end == cursor) return false;
+    arrival.node = static_cast<uint32_t>(node);
+    arrival.timeNs = std::llround(seconds * 1e9);
+    arrival.size = static_cast<uint32_t>(size);
+    return true;
+}
+
+// Записи узла, ещё не записанные на диск
+struct NodeBuffer {
+    uint64_t written = 0;
+    std::vector<ArrivalRecord> pending;
+};
+
+const size_t kBufferRecords = 4096;
+
+bool WriteAt(int fd, const void* data, size_t bytes, uint64_t offset) {
+    const char* cursor = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t done = pwrite(fd, cursor, bytes, static_cast<off_t>(offset));
+        if (done < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        cursor += done;
+        bytes -= static_cast<size_t>(done);
+        offset += static_cast<uint64_t>(done);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <arrivals.csv> <arrivals.bin>" << std::endl;
+        return 1;
+    }
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    // Проход 1: число записей и проверка порядка времени по узлам
+    std::vector<uint64_t> counts;
+    std::vector<int64_t> lastTime;
+    {
+        std::ifstream csv(input);
+        if (!csv) {
+            std::cerr << "Cannot open " << input << std::endl;
+            return 1;
+        }
+        std::string line;
+        uint64_t lineNumber = 0;
+        CsvArrival arrival;
+        while (std::getline(csv, line)) {
+            ++lineNumber;
+            if (!ParseLine(line, arrival)) continue;
+            if (arrival.node >= counts.size()) {
+                counts.resize(arrival.node + 1, 0);
+                lastTime.resize(arrival.node + 1, INT64_MIN);
+            }
+            if (arrival.timeNs < lastTime[arrival.node]) {
+                std::cerr << input << ":" << lineNumber << ": node " << arrival.node
+                          << " arrivals are not in time order" << std::endl;
+                return 1;
+            }
+            lastTime[arrival.node] = arrival.timeNs;
+            ++counts[arrival.node];
+        }
+    }
+    if (counts.empty()) {
+        std::cerr << input << ": no arrivals" << std::endl;
+        return 1;
+    }
+
+    const uint32_t numNodes = static_cast<uint32_t>(counts.size());
+    std::vector<ArrivalTraceIndexEntry> index(numNodes);
+    uint64_t total = 0;
+    for (uint32_t node = 0; node < numNodes; ++node) {
+        index[node].firstRecord = total;
+        index[node].count = counts[node];
+        total += counts[node];
+    }
+
+    ArrivalTraceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kArrivalTraceMagic, sizeof(header.magic));
+    header.version = kArrivalTraceVersion;
+    header.numNodes = numNodes;
+    header.recordSize = sizeof(ArrivalRecord);
+    header.totalRecords = total;
+
+    int fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Cannot create " << output << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    const uint64_t recordsOffset = sizeof(header) + numNodes * sizeof(ArrivalTraceIndexEntry);
+    bool ok = WriteAt(fd, &header, sizeof(header), 0) &&
+              WriteAt(fd, index.data(), numNodes * sizeof(ArrivalTraceIndexEntry), sizeof(header));
+
+    // Проход 2: запись каждого узла в свой участок файла
+    std::vector<NodeBuffer> buffers(numNodes);
+    auto flush = [&](uint32_t node) {
+        NodeBuffer& buffer = buffers[node];
+        if (buffer.pending.empty()) return true;
+        uint64_t offset = recordsOffset + (index[node].firstRecord + buffer.written) * sizeof(ArrivalRecord);
+        bool written = WriteAt(fd, buffer.pending.data(), buffer.pending.size() * sizeof(ArrivalRecord), offset);
+        buffer.written += buffer.pending.size();
+        buffer.pending.clear();
+        return written;
+    };
+
+    std::ifstream csv(input);
+    std::string line;
+    CsvArrival arrival;
+    while (ok && std::getline(csv, line)) {
+        if (!ParseLine(line, arrival)) continue;
+        ArrivalRecord record{};
+        record.timeNs = arrival.timeNs;
+        record.size = arrival.size;
+        NodeBuffer& buffer = buffers[arrival.node];
+        buffer.pending.push_back(record);
+        if (buffer.pending.size() >= kBufferRecords) ok = flush(arrival.node);
+    }
+    for (uint32_t node = 0; ok && node < numNodes; ++node) {
+        ok = flush(node);
+    }
+    if (close(fd) != 0) ok = false;
+    if (!ok) {
+        std::cerr << "Write to " << output << " failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    std::cout << output << ": " << total << " arrivals, " << numNodes << " nodes" << std::endl;
+    for (uint32_t node = 0; node < numNodes; ++node) {
+        if (counts[node] == 0) continue;
+        std::cout << "  node " << node << ": " << counts[node] << " arrivals" << std::endl;
+    }
+    return 0;
+}
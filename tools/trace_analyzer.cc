@@ -0,0 +1,271 @@
+/**
+ * Офлайн-анализ бинарной трассы пакетов (PACKET_TRACE=1):
+ *   trace_analyzer <packet_trace.bin> [префикс_вывода]
+ *
+ * Файл отображается в память (mmap) и читается последовательно, поэтому
+ * размер трассы не ограничен объёмом RAM: в памяти хранятся только пакеты,
+ * ещё не принятые на следующем узле. Участок пути (hop) - от первой постановки
+ * пакета в очередь узла до приёма MAC на другом узле; для него считаются
+ * полная задержка, ожидание до первой передачи и число попыток передачи.
+ *
+ * Вывод: сводка в stdout, <префикс>_hops.csv и <префикс>_drops.csv
+ * (по умолчанию префикс - имя трассы без .bin).
+ */
+
+#include "../src/trace/packet_trace_format.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Логарифмическая гистограмма задержек: 100 интервалов на декаду, 1e-7..1e3 с
+class DelayHistogram {
+public:
+    DelayHistogram() : m_bins(kDecades * kBinsPerDecade + 2, 0) {}
+
+    void Add(double seconds) {
+        ++m_count;
+        m_bins[Bin(seconds)] += 1;
+    }
+
+    // Верхняя граница интервала, в который попадает квантиль q
+    double Quantile(double q) const {
+        if (m_count == 0) return 0.0;
+        const uint64_t target = static_cast<uint64_t>(std::ceil(q * m_count));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < m_bins.size(); ++b) {
+            seen += m_bins[b];
+            if (seen >= target) return UpperBound(b);
+        }
+        return UpperBound(m_bins.size() - 1);
+    }
+
+private:
+    static constexpr int kDecades = 10;
+    static constexpr int kBinsPerDecade = 100;
+    static constexpr double kMinLog = -7.0;
+
+    size_t Bin(double seconds) const {
+        if (seconds <= 0.0) return 0;
+        double position = (std::log10(seconds) - kMinLog) * kBinsPerDecade;
+        if (position < 0.0) return 0;
+        return std::min(m_bins.size() - 1, static_cast<size_t>(position) + 1);
+    }
+
+    static double UpperBound(size_t bin) {
+        return std::pow(10.0, kMinLog + static_cast<double>(bin) / kBinsPerDecade);
+    }
+
+    std::vector<uint64_t> m_bins;
+    uint64_t m_count = 0;
+};
+
+// Пакет на узле: от первой постановки в очередь до приёма следующим узлом
+struct HopState {
+    uint32_t node = 0;
+    uint16_t device = 0;
+    int64_t start = -1;
+    int64_t firstTx = -1;
+    int64_t lastTx = -1;
+    uint32_t attempts = 0;
+};
+
+struct HopStats {
+    uint64_t count = 0;
+    double delaySum = 0.0;     // Постановка в очередь -> приём
+    double waitSum = 0.0;      // Постановка в очередь -> первая передача
+    double lastTxSum = 0.0;    // Последняя передача -> приём
+    uint64_t attempts = 0;
+    DelayHistogram delays;
+};
+
+using HopKey = std::tuple<uint32_t, uint32_t, uint16_t>;           // от, к, устройство
+using DropKey = std::tuple<uint32_t, uint16_t, uint8_t, uint8_t>;  // узел, устройство, уровень, причина
+
+double Seconds(int64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) * 1e-9;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <packet_trace.bin> [output_prefix]" << std::endl;
+        return 1;
+    }
+    const std::string path = argv[1];
+    std::string prefix = (argc > 2) ? argv[2] : path;
+    if (argc <= 2 && prefix.size() > 4 && prefix.compare(prefix.size() - 4, 4, ".bin") == 0) {
+        prefix.resize(prefix.size() - 4);
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(PacketTraceHeader)) {
+        std::cerr << path << ": not a packet trace (too short)" << std::endl;
+        close(fd);
+        return 1;
+    }
+    const size_t fileSize = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "mmap failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    const auto* header = static_cast<const PacketTraceHeader*>(mapping);
+    if (std::memcmp(header->magic, kPacketTraceMagic, sizeof(header->magic)) != 0 ||
+        header->version != kPacketTraceVersion || header->recordSize != sizeof(PacketTraceRecord)) {
+        std::cerr << path << ": unsupported trace format" << std::endl;
+        munmap(mapping, fileSize);
+        return 1;
+    }
+    const auto* records = reinterpret_cast<const PacketTraceRecord*>(static_cast<const char*>(mapping) + sizeof(PacketTraceHeader));
+    // Незавершённая последняя запись (прерванная запись трассы) отбрасывается
+    const size_t count = (fileSize - sizeof(PacketTraceHeader)) / sizeof(PacketTraceRecord);
+
+    std::unordered_map<uint64_t, std::vector<HopState>> inFlight;
+    std::map<HopKey, HopStats> hops;
+    std::map<DropKey, uint64_t> drops;
+    uint64_t eventCounts[5] = {0, 0, 0, 0, 0};
+    int64_t firstTime = (count > 0) ? records[0].timeNs : 0;
+    int64_t lastTime = firstTime;
+
+    for (size_t r = 0; r < count; ++r) {
+        const PacketTraceRecord& record = records[r];
+        if (record.event < 5) ++eventCounts[record.event];
+        lastTime = std::max(lastTime, record.timeNs);
+
+        auto findAt = [&](std::vector<HopState>& states, uint32_t node) {
+            return std::find_if(states.begin(), states.end(), [node](const HopState& s) { return s.node == node; });
+        };
+
+        switch (static_cast<PacketTraceEvent>(record.event)) {
+            case PacketTraceEvent::Enqueue: {
+                std::vector<HopState>& states = inFlight[record.packetUid];
+                if (findAt(states, record.node) == states.end()) {
+                    HopState state;
+                    state.node = record.node;
+                    state.device = record.device;
+                    state.start = record.timeNs;
+                    states.push_back(state);
+                }
+                break;
+            }
+            case PacketTraceEvent::Tx: {
+                auto it = inFlight.find(record.packetUid);
+                if (it == inFlight.end()) break; // Служебные кадры (ACK, ARP без очереди)
+                auto state = findAt(it->second, record.node);
+                if (state == it->second.end()) break;
+                if (state->firstTx < 0) state->firstTx = record.timeNs;
+                state->lastTx = record.timeNs;
+                state->device = record.device;
+                ++state->attempts;
+                break;
+            }
+            case PacketTraceEvent::Rx: {
+                auto it = inFlight.find(record.packetUid);
+                if (it == inFlight.end()) break;
+                std::vector<HopState>& states = it->second;
+                // Отправитель - узел, передававший пакет последним
+                auto sender = states.end();
+                for (auto s = states.begin(); s != states.end(); ++s) {
+                    if (s->node != record.node && s->attempts > 0 &&
+                        (sender == states.end() || s->lastTx > sender->lastTx)) {
+                        sender = s;
+                    }
+                }
+                if (sender == states.end()) break;
+                HopStats& stats = hops[HopKey(sender->node, record.node, sender->device)];
+                const double delay = Seconds(record.timeNs - sender->start);
+                ++stats.count;
+                stats.delaySum += delay;
+                stats.waitSum += Seconds(sender->firstTx - sender->start);
+                stats.lastTxSum += Seconds(record.timeNs - sender->lastTx);
+                stats.attempts += sender->attempts;
+                stats.delays.Add(delay);
+                states.erase(sender);
+                if (states.empty()) inFlight.erase(it);
+                break;
+            }
+            case PacketTraceEvent::Drop: {
+                ++drops[DropKey(record.node, record.device, record.layer, record.reason)];
+                auto it = inFlight.find(record.packetUid);
+                if (it == inFlight.end()) break;
+                auto state = findAt(it->second, record.node);
+                if (state != it->second.end()) it->second.erase(state);
+                if (it->second.empty()) inFlight.erase(it);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    uint64_t pending = 0;
+    for (const auto& entry : inFlight) pending += entry.second.size();
+
+    std::cout << "Trace: " << path << " (" << count << " records, sampling " << header->samplingRate
+              << ", " << Seconds(lastTime - firstTime) << " s)" << std::endl;
+    std::cout << "Events: enqueue " << eventCounts[0] << ", dequeue " << eventCounts[1]
+              << ", drop " << eventCounts[2] << ", tx " << eventCounts[3] << ", rx " << eventCounts[4] << std::endl;
+
+    std::ofstream hopFile(prefix + "_hops.csv");
+    hopFile << "FromNode,ToNode,Device,Packets,MeanDelay_s,P50_s,P95_s,P99_s,MeanWait_s,MeanLastTxToRx_s,MeanAttempts\n";
+    std::cout << "\nPer-hop delays:" << std::endl;
+    for (const auto& entry : hops) {
+        const HopStats& s = entry.second;
+        const double n = static_cast<double>(s.count);
+        hopFile << std::get<0>(entry.first) << "," << std::get<1>(entry.first) << "," << std::get<2>(entry.first)
+                << "," << s.count << "," << s.delaySum / n << "," << s.delays.Quantile(0.5) << ","
+                << s.delays.Quantile(0.95) << "," << s.delays.Quantile(0.99) << "," << s.waitSum / n << ","
+                << s.lastTxSum / n << "," << s.attempts / n << "\n";
+        std::cout << "  " << std::get<0>(entry.first) << " -> " << std::get<1>(entry.first)
+                  << " (dev " << std::get<2>(entry.first) << "): " << s.count << " pkts, mean "
+                  << s.delaySum / n << " s, p95 " << s.delays.Quantile(0.95) << " s, wait "
+                  << s.waitSum / n << " s, attempts " << s.attempts / n << std::endl;
+    }
+
+    std::ofstream dropFile(prefix + "_drops.csv");
+    dropFile << "Node,Device,Layer,Reason,Packets\n";
+    std::map<std::string, uint64_t> byReason;
+    for (const auto& entry : drops) {
+        const char* layer = PacketTraceLayerName(std::get<2>(entry.first));
+        const char* reason = PacketDropReasonName(std::get<3>(entry.first));
+        dropFile << std::get<0>(entry.first) << "," << std::get<1>(entry.first) << "," << layer << ","
+                 << reason << "," << entry.second << "\n";
+        byReason[reason] += entry.second;
+    }
+    std::cout << "\nDrops by cause:";
+    if (byReason.empty()) std::cout << " none";
+    std::cout << std::endl;
+    for (const auto& entry : byReason) {
+        std::cout << "  " << entry.first << ": " << entry.second << std::endl;
+    }
+    std::cout << "Packets still queued or in transit at the end: " << pending << std::endl;
+    std::cout << "Written " << prefix << "_hops.csv, " << prefix << "_drops.csv" << std::endl;
+
+    munmap(mapping, fileSize);
+    return 0;
+}